@@ -0,0 +1,36 @@
+/**
+ * \file Benchmarks.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines what the benchmarks share
+ */
+
+#include "Benchmarks.h"
+
+/**
+ * \param report Where to write the report
+ * \param name The name of the input measured
+ * \param benchmark The benchmark
+ * \param method What was measured
+ * \param precision The type of the coordinates, "float" or "double"
+ * \param numThreads The number of threads used
+ * \param numPoints The number of points handled
+ * \param numBytes The number of bytes of points (or file) handled
+ * \param seconds How long it took, at the fastest
+ */
+void Benchmarks::report(FILE *report, const string &name, const char *benchmark, const string &method,
+	const char *precision, unsigned int numThreads, size_t numPoints, size_t numBytes, double seconds) {
+
+	fprintf(report, "%s\t%lu\t%s\t%s\t%s\t%u\t%.6f\t%.0f\t%.3f\n", name.c_str(),
+		(unsigned long) numPoints, benchmark, method.c_str(), precision, numThreads, seconds,
+		(seconds > 0) ? numPoints / seconds : 0, (seconds > 0) ? numBytes / seconds / 1e9 : 0);
+	fflush(report);
+}
+
+/**
+ * \param start The time
+ * \return The seconds since then
+ */
+double Benchmarks::secondsSince(boost::posix_time::ptime start) {
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
@@ -0,0 +1,122 @@
+/**
+ * \file ClassifyBenchmark.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the benchmark of the point classifier
+ */
+
+#include "Benchmarks.h"
+#include "PointClassifier.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/random_number_generator.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+	/** The number of points classified at a time, as the solver classifies them */
+	const size_t CLASSIFY_BLOCK_SIZE = 1024;
+
+	/**
+	 * Times the point classifier in one precision
+	 *
+	 * \param name The name of the input
+	 * \param points The input's points
+	 * \param seed The seed of the order the indexed kernels are given the points in
+	 * \param repeats The number of times to classify the points with each kernel
+	 * \param report Where to write the report
+	 */
+	template <typename T>
+	void classifyIn(const string &name, const HullPointBuffer &points, unsigned int seed, unsigned int repeats,
+		FILE *report) {
+
+		size_t numPoints = points.size();
+		vector<T> x(numPoints), y(numPoints), z(numPoints);
+		vector<HullPointIndex> indices(numPoints);
+		double centroid[3] = { 0, 0, 0 };
+
+		for (size_t i = 0; i < numPoints; i++) {
+			HullPointIndex p = (HullPointIndex) i;
+			x[i] = (T) points.getX(p);
+			y[i] = (T) points.getY(p);
+			z[i] = (T) points.getZ(p);
+			indices[i] = p;
+			centroid[0] += x[i] / numPoints;
+			centroid[1] += y[i] / numPoints;
+			centroid[2] += z[i] / numPoints;
+		}
+
+		// The points of a face's conflict list are scattered through the
+		// buffer, so the indexed kernels are given them in no order.
+		boost::mt19937 engine(seed);
+		boost::random_number_generator<boost::mt19937> random(engine);
+		std::random_shuffle(indices.begin(), indices.end(), random);
+
+		// A plane through the middle of the points flags about half of them,
+		// as a face's plane does early on.
+		T plane[4] = { (T) 0.48, (T) 0.6, (T) 0.64, 0 };
+		plane[3] = (T) (plane[0] * centroid[0] + plane[1] * centroid[1] + plane[2] * centroid[2]);
+
+		vector<T> distances(CLASSIFY_BLOCK_SIZE);
+		vector<unsigned char> mask(CLASSIFY_BLOCK_SIZE);
+		const char *precision = (sizeof(T) == sizeof(float)) ? "float" : "double";
+		PointClassifier::InstructionSet original = PointClassifier::getInstructionSet();
+
+		for (int s = PointClassifier::SCALAR; s <= PointClassifier::getSupportedInstructionSet(); s++) {
+			PointClassifier::InstructionSet instructionSet
+				= PointClassifier::setInstructionSet((PointClassifier::InstructionSet) s);
+
+			for (int indexed = 0; indexed < 2; indexed++) {
+				double seconds = 0;
+
+				for (unsigned int k = 0; k < repeats; k++) {
+					boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+					for (size_t begin = 0; begin < numPoints; begin += CLASSIFY_BLOCK_SIZE) {
+						size_t count = std::min(CLASSIFY_BLOCK_SIZE, numPoints - begin);
+
+						if (indexed) {
+							PointClassifier::classifyIndexed(plane, (T) 0, &x[0], &y[0], &z[0], 1, &indices[begin], count,
+								&distances[0], &mask[0]);
+						} else {
+							PointClassifier::classify(plane, (T) 0, &x[begin], &y[begin], &z[begin], count,
+								&distances[0], &mask[0]);
+						}
+					}
+
+					double passSeconds = Benchmarks::secondsSince(start);
+					seconds = (k == 0 || passSeconds < seconds) ? passSeconds : seconds;
+				}
+
+				Benchmarks::report(report, name, "classify",
+					string(PointClassifier::getName(instructionSet)) + (indexed ? "-indexed" : ""), precision, 1,
+					numPoints, numPoints * 3 * sizeof(T), seconds);
+			}
+		}
+
+		PointClassifier::setInstructionSet(original);
+	}
+
+}
+
+/**
+ * The points are classified both consecutively and at shuffled indices, a
+ * block at a time as the solver classifies them.
+ *
+ * \param name The name of the input
+ * \param points The input's points
+ * \param singlePrecision Whether to classify the points in float rather
+ *   than double
+ * \param seed The seed of the order the indexed kernels are given the points in
+ * \param repeats The number of times to classify the points with each kernel
+ * \param report Where to write the report
+ */
+void Benchmarks::classify(const string &name, const HullPointBuffer &points, bool singlePrecision,
+	unsigned int seed, unsigned int repeats, FILE *report) {
+
+	if (singlePrecision) {
+		classifyIn<float>(name, points, seed, repeats, report);
+	} else {
+		classifyIn<double>(name, points, seed, repeats, report);
+	}
+}
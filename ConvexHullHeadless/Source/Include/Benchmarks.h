@@ -0,0 +1,49 @@
+/**
+ * \file Benchmarks.h
+ * \author Douglas W. Paul
+ *
+ * Declares the Benchmarks class
+ */
+
+#pragma once
+
+#include "HullPointBuffer.h"
+#include "MappedPointFile.h"
+#include "TextPointFile.h"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace peek;
+
+/**
+ * Container class for the benchmarks that the headless solver runs rather
+ * than solving
+ *
+ * Each benchmark reports a line per method it measures, with the fastest
+ * of the given number of repeats.
+ */
+class Benchmarks {
+public:
+
+	/** Times the point classifier over the points with each instruction set the processor supports */
+	static void classify(const string &name, const HullPointBuffer &points, bool singlePrecision,
+		unsigned int seed, unsigned int repeats, FILE *report);
+
+	/** Times loading a binary point file each way the solvers can read one */
+	static bool load(const string &name, const string &path, MappedPointFile::Format format, unsigned int repeats,
+		FILE *report);
+
+	/** Times parsing a text point file with each number of threads, and with iostreams */
+	static bool parse(const string &name, const string &path, TextPointFile::Format format,
+		const vector<unsigned int> &threadCounts, unsigned int repeats, FILE *report);
+
+	/** Reports on a benchmark */
+	static void report(FILE *report, const string &name, const char *benchmark, const string &method,
+		const char *precision, unsigned int numThreads, size_t numPoints, size_t numBytes, double seconds);
+
+	/** Gets the seconds since the given time */
+	static double secondsSince(boost::posix_time::ptime start);
+
+};
@@ -0,0 +1,133 @@
+/**
+ * \file LoadBenchmark.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the benchmark of loading binary point files
+ */
+
+#include "Benchmarks.h"
+#include "RawPointFileSource.h"
+#include <vector>
+
+namespace {
+
+	/** The number of points read at a time when reading files a block at a time */
+	const size_t LOAD_BLOCK_SIZE = 65536;
+
+	/**
+	 * Reads every point from a source and adds up their coordinates
+	 *
+	 * \param source The source
+	 * \param numPoints Receives the number of points read
+	 * \return The sum of every coordinate of every point, in order
+	 */
+	double sumPoints(HullPointSource &source, size_t &numPoints) {
+		vector<double> x(LOAD_BLOCK_SIZE), y(LOAD_BLOCK_SIZE), z(LOAD_BLOCK_SIZE);
+		double sum = 0;
+		size_t count;
+
+		numPoints = 0;
+
+		do {
+			count = source.read(&x[0], &y[0], &z[0], LOAD_BLOCK_SIZE);
+
+			for (size_t i = 0; i < count; i++) {
+				sum += x[i] + y[i] + z[i];
+			}
+
+			numPoints += count;
+		} while (count == LOAD_BLOCK_SIZE);
+
+		return sum;
+	}
+
+}
+
+/**
+ * The file is loaded three ways: mapping it and handing its points over as
+ * a buffer, as the solver takes them; mapping it and reading it a block at
+ * a time, as the streaming solver takes them; and, for raw files, reading
+ * it a block at a time with stdio through RawPointFileSource.  Every
+ * coordinate is added up each way, so that the pages of the mapping are
+ * all touched, and so that the three ways can be checked against each
+ * other.
+ *
+ * \param name The name of the input
+ * \param path The file
+ * \param format The layout to map the file as
+ * \param repeats The number of times to load the file each way
+ * \param report Where to write the report
+ * \return Whether or not the file could be loaded, and was loaded the same
+ *   every way
+ */
+bool Benchmarks::load(const string &name, const string &path, MappedPointFile::Format format, unsigned int repeats,
+	FILE *report) {
+
+	const char *methods[3] = { "map", "map-read", "stdio" };
+	int numMethods = (format == MappedPointFile::PLY) ? 2 : 3;
+	double sums[3] = { 0, 0, 0 };
+
+	for (int m = 0; m < numMethods; m++) {
+		const char *precision = "double";
+		size_t numPoints = 0;
+		size_t numBytes = 0;
+		double seconds = 0;
+
+		for (unsigned int k = 0; k < repeats; k++) {
+			boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+			if (m < 2) {
+				MappedPointFile file(path.c_str(), format);
+
+				if (!file.isOpen()) {
+					fprintf(stderr, "%s: %s\n", path.c_str(), file.getError().c_str());
+					return false;
+				}
+
+				if (m == 0) {
+					HullPointBuffer points;
+					file.getPoints(points);
+					sums[m] = 0;
+
+					for (size_t i = 0; i < points.size(); i++) {
+						HullPointIndex p = (HullPointIndex) i;
+						sums[m] += points.getX(p) + points.getY(p) + points.getZ(p);
+					}
+
+					numPoints = points.size();
+				} else {
+					sums[m] = sumPoints(file, numPoints);
+				}
+
+				precision = file.isFloat() ? "float" : "double";
+				numBytes = file.getFileSize();
+			} else {
+				RawPointFileSource file(path.c_str(),
+					(format == MappedPointFile::RAW_FLOAT) ? RawPointFileSource::FLOAT : RawPointFileSource::DOUBLE);
+
+				if (!file.isOpen()) {
+					fprintf(stderr, "%s: can't open the file\n", path.c_str());
+					return false;
+				}
+
+				sums[m] = sumPoints(file, numPoints);
+				precision = (format == MappedPointFile::RAW_FLOAT) ? "float" : "double";
+				numBytes = numPoints * 3 * ((format == MappedPointFile::RAW_FLOAT) ? sizeof(float) : sizeof(double));
+			}
+
+			double passSeconds = Benchmarks::secondsSince(start);
+			seconds = (k == 0 || passSeconds < seconds) ? passSeconds : seconds;
+		}
+
+		Benchmarks::report(report, name, "load", methods[m], precision, 1, numPoints, numBytes, seconds);
+	}
+
+	for (int m = 1; m < numMethods; m++) {
+		if (sums[m] != sums[0]) {
+			fprintf(stderr, "%s: the %s and %s loads disagree\n", path.c_str(), methods[0], methods[m]);
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,116 @@
+/**
+ * \file ParseBenchmark.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the benchmark of parsing text point files
+ */
+
+#include "Benchmarks.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+	/**
+	 * Reads an XYZ or OBJ file a line at a time with iostreams, as it would
+	 * be read with nothing but the standard library.  XYZ lines that don't
+	 * start with three numbers, and OBJ lines other than "v" lines, are
+	 * skipped.
+	 *
+	 * \param path The file
+	 * \param obj Whether the file is OBJ rather than XYZ
+	 * \param points Receives the points
+	 */
+	void readWithIostreams(const string &path, bool obj, HullPointBuffer &points) {
+		std::ifstream file(path.c_str());
+		string line;
+
+		while (std::getline(file, line)) {
+			std::istringstream words(line);
+			string keyword;
+			double x, y, z;
+
+			if (obj && (!(words >> keyword) || keyword != "v")) {
+				continue;
+			}
+
+			if (words >> x >> y >> z) {
+				points.add(x, y, z);
+			}
+		}
+	}
+
+}
+
+/**
+ * The file is parsed with TextPointFile with each number of threads, and
+ * for XYZ and OBJ files, with iostreams for comparison.
+ *
+ * \param name The name of the input
+ * \param path The file
+ * \param format The format to parse the file as
+ * \param threadCounts The numbers of threads to parse with, where 0 is one
+ *   per processor
+ * \param repeats The number of times to parse the file each way
+ * \param report Where to write the report
+ * \return Whether or not the file could be parsed, and was parsed to the
+ *   same number of points both ways
+ */
+bool Benchmarks::parse(const string &name, const string &path, TextPointFile::Format format,
+	const vector<unsigned int> &threadCounts, unsigned int repeats, FILE *report) {
+
+	TextPointFile::Format parsedFormat = format;
+	size_t numPoints = 0;
+	size_t numBytes = 0;
+
+	for (size_t j = 0; j < threadCounts.size(); j++) {
+		unsigned int numThreads = 0;
+		double seconds = 0;
+
+		for (unsigned int k = 0; k < repeats; k++) {
+			boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+			TextPointFile file(path.c_str(), format, threadCounts[j]);
+
+			if (!file.load()) {
+				fprintf(stderr, "%s: %s\n", path.c_str(), file.getError().c_str());
+				return false;
+			}
+
+			double passSeconds = Benchmarks::secondsSince(start);
+			seconds = (k == 0 || passSeconds < seconds) ? passSeconds : seconds;
+			parsedFormat = file.getFormat();
+			numPoints = file.size();
+			numBytes = file.getFileSize();
+			numThreads = file.getNumThreads();
+		}
+
+		Benchmarks::report(report, name, "parse", "parallel", "double", numThreads, numPoints, numBytes, seconds);
+	}
+
+	if (parsedFormat == TextPointFile::PLY) {
+		return true;
+	}
+
+	size_t numRead = 0;
+	double seconds = 0;
+
+	for (unsigned int k = 0; k < repeats; k++) {
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+		HullPointBuffer points;
+		readWithIostreams(path, parsedFormat == TextPointFile::OBJ, points);
+
+		double passSeconds = Benchmarks::secondsSince(start);
+		seconds = (k == 0 || passSeconds < seconds) ? passSeconds : seconds;
+		numRead = points.size();
+	}
+
+	Benchmarks::report(report, name, "parse", "iostream", "double", 1, numRead, numBytes, seconds);
+
+	if (numRead != numPoints) {
+		fprintf(stderr, "%s: iostreams read %lu points, and TextPointFile %lu\n", path.c_str(),
+			(unsigned long) numRead, (unsigned long) numPoints);
+		return false;
+	}
+
+	return true;
+}
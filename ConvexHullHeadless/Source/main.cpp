@@ -0,0 +1,701 @@
+/**
+ * \file main.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the entry point for the headless solver, which finds the hulls of
+ * point cloud files or generated points from the command line, without a
+ * window or OpenGL
+ */
+
+#include "Benchmarks.h"
+#include "ConvexHullSolver.h"
+#include "HullExporter.h"
+#include "HullSolver.h"
+#include "MappedPointFile.h"
+#include "PlanarHullSolver.h"
+#include "StreamingHullSolver.h"
+#include "TextPointFile.h"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace peek;
+
+namespace {
+
+	/** How to run the program */
+	const char *USAGE =
+		"usage: %s [options] (file | -g distribution:count)...\n"
+		"\n"
+		"Finds the convex hull of each point cloud file (binary or ASCII PLY,\n"
+		"XYZ, OBJ or raw) and each set of generated points, and reports how\n"
+		"long each stage took, one line per input.\n"
+		"\n"
+		"  -i format              how to read the files: auto (the default, for\n"
+		"                         PLY, XYZ or OBJ by their contents and names),\n"
+		"                         text, ply, raw-float or raw-double\n"
+		"  -g distribution:count  generate points: sphere, ball, cube, gaussian\n"
+		"                         or disk\n"
+		"  -a algorithm           incremental (the default), randomized, divide,\n"
+		"                         chan or streaming\n"
+		"  -t threads             threads to load and solve with (0, the default,\n"
+		"                         for one per processor), or a list such as\n"
+		"                         1,2,4,8 to solve each input with each in turn\n"
+		"                         (loading with the first)\n"
+		"  -p precision           double (the default) or float (incremental and\n"
+		"                         randomized only)\n"
+		"  -s seed                seed of the generated points and the randomized\n"
+		"                         order (1 by default)\n"
+		"  -m megabytes           memory budget of the streaming algorithm (256 by\n"
+		"                         default)\n"
+		"  -k repeats             solve each input this many times, and report the\n"
+		"                         fastest (1 by default)\n"
+		"  -o directory           write each hull there, as <input>-hull.<format>\n"
+		"  -f format              ply (the default), stl or obj\n"
+		"  -r file                write the report there rather than to standard\n"
+		"                         output\n"
+		"  -b benchmark           measure rather than solve: classify (the point\n"
+		"                         classifier with each instruction set, in the\n"
+		"                         precision given by -p) or load (binary files,\n"
+		"                         mapped and read with stdio; the fastest of -k\n"
+		"                         runs is from a warm cache if -k is 2 or more)\n"
+		"                         or parse (text files, in parallel with each\n"
+		"                         number of threads, and with iostreams)\n";
+
+	/** The settings given on the command line */
+	struct Options {
+		/** The algorithm, unless streaming */
+		HullSolver::Algorithm algorithm;
+
+		/** Whether or not to solve with StreamingHullSolver */
+		bool streaming;
+
+		/** The numbers of threads to solve each input with, in turn (0 for one per processor) */
+		vector<unsigned int> threadCounts;
+
+		/** How to read the files: "auto", "text", "ply", "raw-float" or "raw-double" */
+		string inputFormat;
+
+		/** Whether or not to solve in float */
+		bool singlePrecision;
+
+		/** The seed of the generated points and the randomized order */
+		unsigned int seed;
+
+		/** The memory budget of the streaming algorithm, in bytes */
+		size_t memoryBudget;
+
+		/** The number of times to solve each input */
+		unsigned int repeats;
+
+		/** Where to write the hulls, or empty to not write them */
+		string outputDirectory;
+
+		/** The extension of the hulls' files */
+		string outputFormat;
+
+		/** Where to write the report, or empty for standard output */
+		string reportPath;
+
+		/** The benchmark to run rather than solving, or empty to solve */
+		string benchmark;
+
+		/** The files and distributions, in order */
+		vector<string> inputs;
+
+		/** Which of the inputs are distributions */
+		vector<bool> generated;
+	};
+
+	/** An input whose hull is to be found, and whatever holds its points */
+	struct Input {
+		/** The name the input is reported and written under */
+		string name;
+
+		/** The file, or the distribution the points were generated from */
+		string path;
+
+		/** The input, if it is a binary file */
+		auto_ptr<MappedPointFile> mappedFile;
+
+		/** The input, if it is a text file */
+		auto_ptr<TextPointFile> textFile;
+
+		/** The points, unless they are streamed from the file */
+		HullPointBuffer points;
+
+		/** The points in float, if solving in float */
+		FloatHullPointBuffer floatPoints;
+	};
+
+	/** Reads points out of a buffer, so that generated points can be streamed */
+	class BufferPointSource : public HullPointSource {
+	public:
+
+		/** Constructor */
+		BufferPointSource(const HullPointBuffer &points) : points(points), next(0) {}
+
+		/** Reads up to the given number of points, following on from the last read */
+		virtual size_t read(double *x, double *y, double *z, size_t maxPoints) {
+			size_t count = std::min(maxPoints, this->points.size() - this->next);
+
+			for (size_t i = 0; i < count; i++) {
+				HullPointIndex p = (HullPointIndex) (this->next + i);
+				x[i] = this->points.getX(p);
+				y[i] = this->points.getY(p);
+				z[i] = this->points.getZ(p);
+			}
+
+			this->next += count;
+			return count;
+		}
+
+	private:
+
+		/** The points */
+		const HullPointBuffer &points;
+
+		/** The next point to read */
+		size_t next;
+	};
+
+	/** Reads a whole number from an argument, failing if there is anything else in it */
+	bool parseNumber(const char *text, unsigned long &value) {
+		char *end;
+		value = strtoul(text, &end, 10);
+		return *text != '\0' && *text != '-' && *end == '\0';
+	}
+
+	/** Reads a comma-separated list of whole numbers from an argument */
+	bool parseNumbers(const string &text, vector<unsigned int> &values) {
+		values.clear();
+
+		for (size_t start = 0; start <= text.size(); ) {
+			size_t comma = std::min(text.find(',', start), text.size());
+			unsigned long value;
+
+			if (!parseNumber(text.substr(start, comma - start).c_str(), value)) {
+				return false;
+			}
+
+			values.push_back((unsigned int) value);
+			start = comma + 1;
+		}
+
+		return true;
+	}
+
+	/** Gets the name of an algorithm as the command line gives it */
+	const char *getAlgorithmName(const Options &options) {
+		if (options.streaming) {
+			return "streaming";
+		}
+
+		switch (options.algorithm) {
+			case HullSolver::RANDOMIZED_INCREMENTAL:
+				return "randomized";
+			case HullSolver::DIVIDE_AND_CONQUER:
+				return "divide";
+			case HullSolver::OUTPUT_SENSITIVE:
+				return "chan";
+			default:
+				return "incremental";
+		}
+	}
+
+	/**
+	 * Reads the command line
+	 *
+	 * \param argc The number of arguments
+	 * \param argv The arguments
+	 * \param options Receives the settings
+	 * \return An explanation of what is wrong with the arguments, or NULL if
+	 *   nothing is
+	 */
+	const char *parseOptions(int argc, char **argv, Options &options) {
+		options.algorithm = HullSolver::INCREMENTAL;
+		options.streaming = false;
+		options.threadCounts.assign(1, 0);
+		options.inputFormat = "auto";
+		options.singlePrecision = false;
+		options.seed = HullSolver::DEFAULT_SEED;
+		options.memoryBudget = StreamingHullSolver::DEFAULT_MEMORY_BUDGET;
+		options.repeats = 1;
+		options.outputFormat = "ply";
+
+		for (int i = 1; i < argc; i++) {
+			string flag = argv[i];
+			unsigned long number;
+
+			if (flag.size() != 2 || flag[0] != '-') {
+				options.inputs.push_back(flag);
+				options.generated.push_back(false);
+				continue;
+			}
+
+			if (i + 1 == argc) {
+				return "an option is missing its value";
+			}
+
+			string value = argv[++i];
+
+			if (flag == "-g") {
+				options.inputs.push_back(value);
+				options.generated.push_back(true);
+			} else if (flag == "-a") {
+				options.streaming = (value == "streaming");
+
+				if (value == "incremental" || value == "streaming") {
+					options.algorithm = HullSolver::INCREMENTAL;
+				} else if (value == "randomized") {
+					options.algorithm = HullSolver::RANDOMIZED_INCREMENTAL;
+				} else if (value == "divide") {
+					options.algorithm = HullSolver::DIVIDE_AND_CONQUER;
+				} else if (value == "chan") {
+					options.algorithm = HullSolver::OUTPUT_SENSITIVE;
+				} else {
+					return "unknown algorithm";
+				}
+			} else if (flag == "-i" && (value == "auto" || value == "text" || value == "ply" || value == "raw-float"
+				|| value == "raw-double")) {
+
+				options.inputFormat = value;
+			} else if (flag == "-t" && parseNumbers(value, options.threadCounts)) {
+			} else if (flag == "-p" && (value == "double" || value == "float")) {
+				options.singlePrecision = (value == "float");
+			} else if (flag == "-s" && parseNumber(value.c_str(), number)) {
+				options.seed = (unsigned int) number;
+			} else if (flag == "-m" && parseNumber(value.c_str(), number) && number > 0) {
+				options.memoryBudget = (size_t) number << 20;
+			} else if (flag == "-k" && parseNumber(value.c_str(), number) && number > 0) {
+				options.repeats = (unsigned int) number;
+			} else if (flag == "-o") {
+				options.outputDirectory = value;
+			} else if (flag == "-f" && (value == "ply" || value == "stl" || value == "obj")) {
+				options.outputFormat = value;
+			} else if (flag == "-r") {
+				options.reportPath = value;
+			} else if (flag == "-b" && (value == "classify" || value == "load" || value == "parse")) {
+				options.benchmark = value;
+			} else {
+				return "unknown option, or bad value";
+			}
+		}
+
+		if (options.inputs.empty()) {
+			return "no input was given";
+		}
+
+		if (options.singlePrecision && (options.streaming || options.algorithm == HullSolver::DIVIDE_AND_CONQUER
+			|| options.algorithm == HullSolver::OUTPUT_SENSITIVE)) {
+
+			return "only the incremental algorithms can solve in float";
+		}
+
+		if (!options.benchmark.empty() && options.streaming) {
+			return "the benchmarks don't stream";
+		}
+
+		return NULL;
+	}
+
+	/**
+	 * Generates points from a distribution
+	 *
+	 * \param spec The distribution and the number of points, as
+	 *   "distribution:count"
+	 * \param seed The seed of the random numbers
+	 * \param input Receives the points and the name "distribution-count"
+	 * \return Whether or not the distribution was understood
+	 */
+	bool generate(const string &spec, unsigned int seed, Input &input) {
+		size_t colon = spec.find(':');
+		string distribution = spec.substr(0, colon);
+		unsigned long count;
+
+		if (colon == string::npos || !parseNumber(spec.c_str() + colon + 1, count)) {
+			return false;
+		}
+
+		boost::mt19937 engine(seed);
+		boost::variate_generator<boost::mt19937 &, boost::uniform_real<> > uniform(engine, boost::uniform_real<>(-1, 1));
+		boost::variate_generator<boost::mt19937 &, boost::normal_distribution<> > normal(engine,
+			boost::normal_distribution<>());
+
+		input.name = distribution + "-" + spec.substr(colon + 1);
+		input.points.reserve(count);
+
+		for (unsigned long i = 0; i < count; i++) {
+			double p[3];
+
+			if (distribution == "sphere" || distribution == "gaussian") {
+				p[0] = normal();
+				p[1] = normal();
+				p[2] = normal();
+
+				if (distribution == "sphere") {
+					double length = sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+					length = (length > 0) ? length : 1;
+					p[0] /= length;
+					p[1] /= length;
+					p[2] /= length;
+				}
+			} else if (distribution == "ball" || distribution == "disk") {
+				do {
+					p[0] = uniform();
+					p[1] = uniform();
+					p[2] = (distribution == "ball") ? uniform() : 0;
+				} while (p[0] * p[0] + p[1] * p[1] + p[2] * p[2] > 1);
+			} else if (distribution == "cube") {
+				p[0] = uniform();
+				p[1] = uniform();
+				p[2] = uniform();
+			} else {
+				return false;
+			}
+
+			input.points.add(p[0], p[1], p[2]);
+		}
+
+		return true;
+	}
+
+	/** Gets the extension of a file's name, with its dot, or nothing if it has none */
+	string getExtension(const string &path) {
+		size_t nameStart = path.find_last_of("/\\");
+		nameStart = (nameStart == string::npos) ? 0 : nameStart + 1;
+		size_t dot = path.rfind('.');
+		return (dot == string::npos || dot < nameStart) ? string() : path.substr(dot);
+	}
+
+	/** Gets the name an input file is reported and written under, which is its name without its extension */
+	string getInputName(const string &path) {
+		size_t nameStart = path.find_last_of("/\\");
+		nameStart = (nameStart == string::npos) ? 0 : nameStart + 1;
+		return path.substr(nameStart, path.size() - nameStart - getExtension(path).size());
+	}
+
+	/** Gets the layout to map a binary file as, which is PLY unless raw points were asked for */
+	MappedPointFile::Format getMappedFormat(const Options &options) {
+		return (options.inputFormat == "raw-float") ? MappedPointFile::RAW_FLOAT
+			: (options.inputFormat == "raw-double") ? MappedPointFile::RAW_DOUBLE : MappedPointFile::PLY;
+	}
+
+	/**
+	 * Opens a point cloud file.  Raw and binary PLY files are mapped, and
+	 * anything else is parsed as text.  Raw files have nothing to tell them
+	 * by but their names, and nothing at all to tell float from double, so
+	 * they have to be asked for.
+	 *
+	 * \param path The file
+	 * \param options The settings
+	 * \param input Receives the file, its name, and its points unless they
+	 *   are to be streamed
+	 * \param error Receives why the file couldn't be loaded, if it couldn't
+	 * \return Whether or not the file could be loaded
+	 */
+	bool load(const string &path, const Options &options, Input &input, string &error) {
+		input.name = getInputName(path);
+		bool raw = (options.inputFormat == "raw-float" || options.inputFormat == "raw-double");
+
+		if (options.inputFormat == "auto" && getExtension(path) == ".raw") {
+			error = "raw files need -i raw-float or -i raw-double";
+			return false;
+		}
+
+		if (!raw) {
+			input.textFile.reset(new TextPointFile(path.c_str(),
+				(options.inputFormat == "ply") ? TextPointFile::PLY : TextPointFile::AUTO, options.threadCounts[0]));
+		}
+
+		if (raw || (options.inputFormat != "text" && input.textFile->getFormat() == TextPointFile::PLY
+			&& !input.textFile->isOpen())) {
+
+			input.textFile.reset();
+			input.mappedFile.reset(new MappedPointFile(path.c_str(), getMappedFormat(options)));
+
+			if (!input.mappedFile->isOpen()) {
+				error = input.mappedFile->getError();
+				return false;
+			}
+
+			if (!options.streaming) {
+				input.mappedFile->getPoints(input.points);
+			}
+
+			return true;
+		}
+
+		if (!options.streaming && input.textFile->load()) {
+			input.textFile->getPoints(input.points);
+		}
+
+		if (!input.textFile->isOpen()) {
+			error = input.textFile->getError();
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Writes a hull and counts its vertices
+	 *
+	 * \param hull The hull's faces
+	 * \param points The points the faces refer to
+	 * \param path The file to write, or empty to only count
+	 * \param numVertices Receives the number of vertices
+	 * \param error Receives why the file couldn't be written, if it couldn't
+	 * \return Whether or not the file was written
+	 */
+	template <typename T>
+	bool writeHull(const HullFaceList &hull, const BasicHullPointBuffer<T> &points, const string &path,
+		size_t &numVertices, string &error) {
+
+		BasicHullExporter<T> exporter;
+		exporter.setHull(hull, points);
+		numVertices = exporter.getVertices().size();
+
+		if (!path.empty() && !exporter.write(path.c_str())) {
+			error = exporter.getError();
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Rounds an input's points to float, if they are to be solved in float.
+	 * Points that lie in a plane go to PlanarHullSolver in double, whatever
+	 * the precision, as HullSolver::create() would send them, so they are
+	 * left as they are.
+	 *
+	 * \param input The input
+	 * \param options The settings
+	 */
+	void roundToFloat(Input &input, const Options &options) {
+		double normal[3];
+
+		if (!options.singlePrecision || options.streaming
+			|| PlanarHullSolver::fitPlane(input.points, normal) <= PlanarHullSolver::DEFAULT_TOLERANCE) {
+
+			return;
+		}
+
+		input.floatPoints.reserve(input.points.size());
+
+		for (size_t i = 0; i < input.points.size(); i++) {
+			HullPointIndex p = (HullPointIndex) i;
+			input.floatPoints.add((float) input.points.getX(p), (float) input.points.getY(p),
+				(float) input.points.getZ(p));
+		}
+	}
+
+	/**
+	 * Finds the hull of an input, writes it and reports on it
+	 *
+	 * \param input The input
+	 * \param options The settings
+	 * \param numThreads The number of threads to solve with (0 for one per
+	 *   processor)
+	 * \param loadSeconds How long the input took to load or generate
+	 * \param report Where to write the report
+	 * \return Whether or not everything succeeded
+	 */
+	bool solve(Input &input, const Options &options, unsigned int numThreads, double loadSeconds, FILE *report) {
+		auto_ptr<HullSolver> solver;
+		auto_ptr<HullPointSource> bufferSource;
+		const FloatHullPointBuffer *floatPoints = (input.floatPoints.size() > 0) ? &input.floatPoints : NULL;
+		double solveSeconds = 0;
+		size_t numPoints = input.points.size();
+		string error;
+
+		for (unsigned int k = 0; k < options.repeats; k++) {
+			HullPointSource *source = NULL;
+
+			solver.reset();
+
+			if (options.streaming) {
+				if (input.mappedFile.get() != NULL) {
+					input.mappedFile->rewind();
+					source = input.mappedFile.get();
+				} else if (input.textFile.get() != NULL) {
+					input.textFile->rewind();
+					source = input.textFile.get();
+				} else {
+					bufferSource.reset(new BufferPointSource(input.points));
+					source = bufferSource.get();
+				}
+			}
+
+			boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+			if (source != NULL) {
+				solver.reset(new StreamingHullSolver(*source, options.memoryBudget, numThreads));
+			} else if (floatPoints != NULL) {
+				FloatConvexHullSolver *floatSolver = new FloatConvexHullSolver(*floatPoints,
+					HullFaceScheduler::FURTHEST_FIRST, 0, numThreads);
+
+				if (options.algorithm == HullSolver::RANDOMIZED_INCREMENTAL) {
+					floatSolver->setRandomOrder(options.seed);
+				}
+
+				solver.reset(floatSolver);
+			} else {
+				solver.reset(HullSolver::create(options.algorithm, input.points, numThreads, options.seed));
+			}
+
+			solver->iterateToCompletion();
+
+			double seconds = Benchmarks::secondsSince(start);
+			solveSeconds = (k == 0 || seconds < solveSeconds) ? seconds : solveSeconds;
+		}
+
+		if (input.textFile.get() != NULL && !input.textFile->isOpen()) {
+			fprintf(stderr, "%s: %s\n", input.path.c_str(), input.textFile->getError().c_str());
+			return false;
+		}
+
+		HullFaceList hull = solver->getHull();
+		string path = options.outputDirectory.empty() ? string()
+			: options.outputDirectory + "/" + input.name + "-hull." + options.outputFormat;
+		size_t numVertices = 0;
+		bool written;
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+		if (options.streaming) {
+			StreamingHullSolver &streamingSolver = static_cast<StreamingHullSolver &>(*solver);
+			numPoints = (size_t) streamingSolver.getNumPointsRead();
+			written = writeHull(hull, streamingSolver.getPoints(), path, numVertices, error);
+		} else if (floatPoints != NULL) {
+			written = writeHull(hull, *floatPoints, path, numVertices, error);
+		} else {
+			written = writeHull(hull, input.points, path, numVertices, error);
+		}
+
+		double writeSeconds = path.empty() ? 0 : Benchmarks::secondsSince(start);
+
+		if (!written) {
+			fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+		}
+
+		fprintf(report, "%s\t%lu\t%s\t%s\t%u\t%.6f\t%.6f\t%.6f\t%u\t%lu\t%lu\n", input.name.c_str(),
+			(unsigned long) numPoints, getAlgorithmName(options), (floatPoints != NULL) ? "float" : "double",
+			solver->getNumThreads(), loadSeconds, solveSeconds, writeSeconds, solver->getDimension(),
+			(unsigned long) numVertices, (unsigned long) hull.size());
+		fflush(report);
+
+		return written;
+	}
+
+}
+
+/**
+ * Entry point for the headless solver
+ *
+ * The report is tab-separated, with a heading line and then a line per
+ * input and number of threads, or in benchmark mode a line per input and
+ * method measured.  An input that can't be loaded or written is reported
+ * on standard error, and the rest are still solved.
+ *
+ * \return 0 if every input was solved (and written), 1 if any wasn't, and
+ *   2 if the command line was wrong
+ */
+int main(int argc, char **argv) {
+	Options options;
+	const char *problem = parseOptions(argc, argv, options);
+	bool succeeded = true;
+
+	if (problem != NULL) {
+		fprintf(stderr, "%s: %s\n\n", argv[0], problem);
+		fprintf(stderr, USAGE, argv[0]);
+		return 2;
+	}
+
+	FILE *report = options.reportPath.empty() ? stdout : fopen(options.reportPath.c_str(), "w");
+
+	if (report == NULL) {
+		fprintf(stderr, "%s: can't open the file for writing\n", options.reportPath.c_str());
+		return 1;
+	}
+
+	if (options.benchmark.empty()) {
+		fprintf(report, "input\tpoints\talgorithm\tprecision\tthreads\tload_s\tsolve_s\twrite_s\tdimension\tvertices\tfaces\n");
+	} else {
+		fprintf(report, "input\tpoints\tbenchmark\tmethod\tprecision\tthreads\tseconds\tpoints_per_s\tgb_per_s\n");
+	}
+
+	for (size_t i = 0; i < options.inputs.size(); i++) {
+		Input input;
+		string error;
+		boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+
+		input.path = options.inputs[i];
+
+		if (options.benchmark == "load" || options.benchmark == "parse") {
+			if (options.generated[i]) {
+				fprintf(stderr, "%s: the %s benchmark reads only files\n", options.inputs[i].c_str(),
+					options.benchmark.c_str());
+				succeeded = false;
+			} else if (options.benchmark == "load" && options.inputFormat == "text") {
+				fprintf(stderr, "%s: the load benchmark reads only binary files\n", options.inputs[i].c_str());
+				succeeded = false;
+			} else if (options.benchmark == "parse" && options.inputFormat != "auto" && options.inputFormat != "text"
+				&& options.inputFormat != "ply") {
+
+				fprintf(stderr, "%s: the parse benchmark reads only text files\n", options.inputs[i].c_str());
+				succeeded = false;
+			} else {
+				input.name = getInputName(input.path);
+				succeeded = ((options.benchmark == "load")
+					? Benchmarks::load(input.name, input.path, getMappedFormat(options), options.repeats, report)
+					: Benchmarks::parse(input.name, input.path, (options.inputFormat == "ply") ? TextPointFile::PLY
+						: TextPointFile::AUTO, options.threadCounts, options.repeats, report)) && succeeded;
+			}
+
+			continue;
+		}
+
+		if (options.generated[i]) {
+			if (!generate(options.inputs[i], options.seed, input)) {
+				fprintf(stderr, "%s: unknown distribution, or bad count\n", options.inputs[i].c_str());
+				succeeded = false;
+				continue;
+			}
+		} else if (!load(options.inputs[i], options, input, error)) {
+			fprintf(stderr, "%s: %s\n", options.inputs[i].c_str(), error.c_str());
+			succeeded = false;
+			continue;
+		}
+
+		if (options.benchmark == "classify") {
+			Benchmarks::classify(input.name, input.points, options.singlePrecision, options.seed, options.repeats,
+				report);
+
+			continue;
+		}
+
+		roundToFloat(input, options);
+		double loadSeconds = Benchmarks::secondsSince(start);
+
+		for (size_t j = 0; j < options.threadCounts.size(); j++) {
+			succeeded = solve(input, options, options.threadCounts[j], loadSeconds, report) && succeeded;
+		}
+	}
+
+	if (report != stdout) {
+		fclose(report);
+	}
+
+	return succeeded ? 0 : 1;
+}
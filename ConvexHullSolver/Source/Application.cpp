@@ -10,12 +10,15 @@
 #include <Color.hpp>
 #include "UiHandler.h"
 #include "RandomPointGenerator.h"
-#include "ConvexHullSolver.h"
+#include "HullSolver.h"
+#include <cstdio>
 #include <ctime>
 
 using namespace peek;
 
 Application::Application() {
+	this->algorithm = HullSolver::INCREMENTAL;
+
 	Camera::handle camera = Camera::handle(new PerspectiveCamera());
 	this->cameraRigging.reset(new FixedTargetCameraRigging(camera, 45.0, 45.0, 10.0));
 }
@@ -37,17 +40,102 @@ void Application::run() {
 	this->engine.run();
 }
 
-void Application::reset() {
-	this->inputPoints.clear();
+/**
+ * Binary PLY files stay mapped for as long as the application runs, and
+ * their points are handed to the solver in place where they can be.  Any
+ * other file is parsed as text (see TextPointFile) on every processor.
+ *
+ * \param path The file to load
+ * \return Whether or not the file could be loaded
+ */
+bool Application::load(const char *path) {
+	this->inputFile.reset();
+	this->textFile.reset(new TextPointFile(path, TextPointFile::AUTO, 0));
+	this->loadError.clear();
+
+	// A PLY file that isn't ASCII is turned down by the text parser, and
+	// mapped instead.
+	if (this->textFile->getFormat() == TextPointFile::PLY && !this->textFile->isOpen()) {
+		this->textFile.reset();
+		this->inputFile.reset(new MappedPointFile(path));
+
+		if (!this->inputFile->isOpen()) {
+			this->loadError = this->inputFile->getError();
+			this->inputFile.reset();
+			return false;
+		}
+
+		return true;
+	}
 
-	for (unsigned int i = 0; i < numPoints; i++) {
-		this->inputPoints.add(RandomPointGenerator::get3dPointInRadius(boundingRadius));
+	if (!this->textFile->load()) {
+		this->loadError = this->textFile->getError();
+		this->textFile.reset();
+		return false;
 	}
 
-	this->solver.reset(new ConvexHullSolver(this->inputPoints));
+	return true;
+}
+
+void Application::reset() {
+	if (this->inputFile.get() != NULL) {
+		this->inputFile->getPoints(this->points);
+	} else if (this->textFile.get() != NULL) {
+		this->textFile->getPoints(this->points);
+	} else {
+		this->inputPoints.clear();
+
+		for (unsigned int i = 0; i < numPoints; i++) {
+			this->inputPoints.add(RandomPointGenerator::get3dPointInRadius(boundingRadius));
+		}
+
+		this->points = HullPointBuffer(this->inputPoints);
+	}
+
+	// Solve on every processor, so that solving to completion doesn't hold
+	// up drawing for long.
+	this->solver.reset(HullSolver::create(this->algorithm, this->points, 0));
 	this->hull = this->solver->getHull();
 }
 
+void Application::nextAlgorithm() {
+	switch (this->algorithm) {
+		case HullSolver::INCREMENTAL:
+			this->algorithm = HullSolver::RANDOMIZED_INCREMENTAL;
+			break;
+		case HullSolver::RANDOMIZED_INCREMENTAL:
+			this->algorithm = HullSolver::DIVIDE_AND_CONQUER;
+			break;
+
+		case HullSolver::DIVIDE_AND_CONQUER:
+			this->algorithm = HullSolver::OUTPUT_SENSITIVE;
+			break;
+		default:
+			this->algorithm = HullSolver::INCREMENTAL;
+			break;
+	}
+
+	reset();
+}
+
+
+/**
+ * \param path The file to write, whose extension picks the format (see
+ *   HullExporter)
+ * \return Whether or not the file was written
+ */
+bool Application::exportHull(const char *path) {
+	HullExporter exporter;
+	exporter.setHull(this->hull, this->points);
+
+	if (!exporter.write(path)) {
+		fprintf(stderr, "%s: %s\n", path, exporter.getError().c_str());
+		return false;
+	}
+
+	return true;
+}
+
 void Application::iterate() {
 	this->solver->iterate();
 	this->hull = this->solver->getHull();
@@ -77,8 +165,8 @@ void Application::drawInputPoints() const {
 	pkGlColor(Color::orange);
 	glBegin(GL_POINTS);
 
-	for (Point3dSet::const_iterator i = this->inputPoints.begin(); i != this->inputPoints.end(); i++) {
-		pkGlVertex(*i);
+	for (size_t i = 0; i < this->points.size(); i++) {
+		pkGlVertex(this->points.getPoint((HullPointIndex) i));
 	}
 
 	glEnd();
@@ -90,7 +178,7 @@ void Application::drawHull() const {
 	Color hullColor = this->solver->isComplete() ? Color::sky : Color::pink;
 	pkGlColor(hullColor);
 
-	for (HullFaceSet::const_iterator i = this->hull.begin(); i != this->hull.end(); i++) {
+	for (HullFaceList::const_iterator i = this->hull.begin(); i != this->hull.end(); i++) {
 		drawHullFace(*i);
 	}
 }
@@ -100,9 +188,9 @@ void Application::drawHull() const {
  */
 void Application::drawHullFace(HullFace face) const {
 	glBegin(GL_LINE_LOOP);
-	pkGlVertex(face.getP0());
-	pkGlVertex(face.getP1());
-	pkGlVertex(face.getP2());
+	pkGlVertex(this->points.getPoint(face.getP0()));
+	pkGlVertex(this->points.getPoint(face.getP1()));
+	pkGlVertex(this->points.getPoint(face.getP2()));
 	glEnd();
 }
 
@@ -0,0 +1,118 @@
+/**
+ * \file BufferedFileWriter.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the BufferedFileWriter class
+ */
+
+#include "BufferedFileWriter.h"
+
+const size_t BufferedFileWriter::DEFAULT_BUFFER_SIZE;
+
+/**
+ * An existing file is replaced.
+ *
+ * \param path The file to write
+ * \param bufferSize The size of the buffer, in bytes
+ */
+BufferedFileWriter::BufferedFileWriter(const char *path, size_t bufferSize)
+	: buffer((bufferSize > 0) ? bufferSize : 1) {
+
+	this->used = 0;
+	this->file = fopen(path, "wb");
+
+	if (this->file == NULL) {
+		this->error = "can't open the file for writing";
+	} else {
+		// The file's own buffering would only add a copy.
+		setvbuf(this->file, NULL, _IONBF, 0);
+	}
+}
+
+BufferedFileWriter::~BufferedFileWriter() {
+	close();
+}
+
+/**
+ * \param value The value to write
+ */
+void BufferedFileWriter::writeUint16(boost::uint16_t value) {
+	unsigned char bytes[2] = { (unsigned char) value, (unsigned char) (value >> 8) };
+	write(bytes, sizeof(bytes));
+}
+
+/**
+ * \param value The value to write
+ */
+void BufferedFileWriter::writeUint32(boost::uint32_t value) {
+	unsigned char bytes[4] = {
+		(unsigned char) value, (unsigned char) (value >> 8),
+		(unsigned char) (value >> 16), (unsigned char) (value >> 24)
+	};
+
+	write(bytes, sizeof(bytes));
+}
+
+/**
+ * \param value The value to write
+ */
+void BufferedFileWriter::writeFloat(float value) {
+	boost::uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	writeUint32(bits);
+}
+
+/**
+ * \param value The value to write
+ */
+void BufferedFileWriter::writeDouble(double value) {
+	boost::uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	writeUint32((boost::uint32_t) bits);
+	writeUint32((boost::uint32_t) (bits >> 32));
+}
+
+/**
+ * \return Whether or not the file was opened, and every write succeeded
+ */
+bool BufferedFileWriter::close() {
+	if (this->file != NULL) {
+		flush();
+
+		if (fclose(this->file) != 0 && this->error.empty()) {
+			this->error = "can't finish writing the file";
+		}
+
+		this->file = NULL;
+	}
+
+	return isOpen();
+}
+
+void BufferedFileWriter::flush() {
+	if (this->file != NULL && this->used > 0 && this->error.empty()
+		&& fwrite(&this->buffer[0], 1, this->used, this->file) != this->used) {
+
+		this->error = "can't write the file";
+	}
+
+	this->used = 0;
+}
+
+/**
+ * Bytes that would fill the buffer on their own are written straight out,
+ * rather than copied into it a piece at a time.
+ *
+ * \param data The bytes
+ * \param size The number of bytes
+ */
+void BufferedFileWriter::writeThrough(const void *data, size_t size) {
+	flush();
+
+	if (size < this->buffer.size()) {
+		memcpy(&this->buffer[0], data, size);
+		this->used = size;
+	} else if (this->file != NULL && this->error.empty() && fwrite(data, 1, size, this->file) != size) {
+		this->error = "can't write the file";
+	}
+}
@@ -0,0 +1,700 @@
+/**
+ * \file ChanSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the ChanSolver class
+ */
+
+#include "ChanSolver.h"
+#include "ConvexHullSolver.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace peek;
+
+const unsigned int ChanSolver::INITIAL_GROUP_SIZE;
+
+namespace {
+
+	/** The largest guess that can be squared without overflowing */
+	const unsigned int MAX_SQUARED_GROUP_SIZE = 65535;
+
+	/** Marks a point that is not a vertex of its group's hull */
+	const unsigned int NOT_A_VERTEX = ~0u;
+
+	/**
+	 * How far a group's sphere must be behind a plane, relative to the sizes
+	 * of the vectors involved, to be sure of it in floating-point arithmetic
+	 */
+	const double BEHIND_TOLERANCE = 1e-12;
+
+	/** The number of bits of each coordinate in a Z-order code */
+	const int Z_ORDER_BITS = 7;
+
+	/** Spreads the low Z_ORDER_BITS bits of a value out to every third bit */
+	boost::uint32_t spreadBits(boost::uint32_t v) {
+		v &= (1 << Z_ORDER_BITS) - 1;
+		v = (v | (v << 16)) & 0x030000ff;
+		v = (v | (v << 8)) & 0x0300f00f;
+		v = (v | (v << 4)) & 0x030c30c3;
+		v = (v | (v << 2)) & 0x09249249;
+		return v;
+	}
+
+	/** Gets whether p comes before q by x, then y, then z */
+	bool isLower(const HullPointBuffer &points, HullPointIndex p, HullPointIndex q) {
+		if (points.getX(p) != points.getX(q)) {
+			return points.getX(p) < points.getX(q);
+		}
+
+		if (points.getY(p) != points.getY(q)) {
+			return points.getY(p) < points.getY(q);
+		}
+
+		return points.getZ(p) < points.getZ(q);
+	}
+
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+ChanSolver::ChanSolver(const Point3dSet &inputPoints, unsigned int numThreads) : points(inputPoints) {
+	this->groupSize = 0;
+	this->lastGroup = 0;
+	this->complete = false;
+	this->fallback = false;
+	this->dimension = 0;
+	setNumThreads(numThreads);
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find.  If the buffer
+ *   refers to arrays owned by the caller, the arrays must outlive the solver.
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+ChanSolver::ChanSolver(const HullPointBuffer &inputPoints, unsigned int numThreads) : points(inputPoints) {
+	this->groupSize = 0;
+	this->lastGroup = 0;
+	this->complete = false;
+	this->fallback = false;
+	this->dimension = 0;
+	setNumThreads(numThreads);
+}
+
+/**
+ * The guess starts at INITIAL_GROUP_SIZE and is squared each round.  Once it
+ * reaches the number of points, the round simply solves them all with
+ * ConvexHullSolver.
+ */
+void ChanSolver::iterate() {
+	if (isComplete()) {
+		return;
+	}
+
+	size_t n = this->points.size();
+
+	if (this->groupSize == 0) {
+		this->groupSize = INITIAL_GROUP_SIZE;
+	} else if (this->groupSize <= MAX_SQUARED_GROUP_SIZE) {
+		this->groupSize *= this->groupSize;
+	} else {
+		this->groupSize = (unsigned int) n;
+	}
+
+	if (this->groupSize >= n) {
+		this->groupSize = (unsigned int) n;
+		solve(this->points, NULL);
+		return;
+	}
+
+	if (this->order.empty()) {
+		sortPoints();
+	}
+
+	this->groups.resize((n + this->groupSize - 1) / this->groupSize);
+	run(this->groups.size(), &ChanSolver::solveGroup);
+
+	WrapResult result = wrap();
+
+	if (result == WRAPPED) {
+		this->dimension = 3;
+		this->complete = true;
+	} else if (result == DEGENERATE) {
+		HullPointIndexList vertices;
+		HullPointBuffer buffer;
+
+		for (GroupList::const_iterator i = this->groups.begin(); i != this->groups.end(); i++) {
+			vertices.insert(vertices.end(), (*i).vertices.begin(), (*i).vertices.end());
+		}
+
+		for (HullPointIndexList::const_iterator i = vertices.begin(); i != vertices.end(); i++) {
+			buffer.add(this->points.getX(*i), this->points.getY(*i), this->points.getZ(*i));
+		}
+
+		this->fallback = true;
+		solve(buffer, &vertices[0]);
+	}
+}
+
+void ChanSolver::iterateToCompletion() {
+	while (!isComplete()) {
+		iterate();
+	}
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+void ChanSolver::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	this->workers.resize(numThreads);
+	this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over all threads
+ */
+HullPredicateStatistics ChanSolver::getStatistics() const {
+	HullPredicateStatistics statistics;
+
+	for (WorkerList::const_iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		statistics += (*i).statistics;
+	}
+
+	return statistics;
+}
+
+/**
+ * Each point's cell in a grid of 2^7 cells a side over the bounding box is
+ * given a 21-bit code by interleaving the bits of its coordinates, and the
+ * points are sorted by code with a three-pass radix sort.  The grid only
+ * needs to be fine enough that each group spans few cells, and the small
+ * passes keep the scatter within cache.
+ */
+void ChanSolver::sortPoints() {
+	size_t n = this->points.size();
+	const double *coordinates[3] = { this->points.getXArray(), this->points.getYArray(), this->points.getZArray() };
+	size_t stride = this->points.getStride();
+	double lower[3], scale[3];
+
+	for (int j = 0; j < 3; j++) {
+		double upper = lower[j] = coordinates[j][0];
+
+		for (size_t i = 1; i < n; i++) {
+			double c = coordinates[j][i * stride];
+			lower[j] = (c < lower[j]) ? c : lower[j];
+			upper = (c > upper) ? c : upper;
+		}
+
+		scale[j] = (upper > lower[j]) ? (1 << Z_ORDER_BITS) / (upper - lower[j]) : 0.0;
+	}
+
+	vector<boost::uint32_t> codes(n), sortedCodes(n);
+	HullPointIndexList sortedOrder(n);
+	this->order.resize(n);
+
+	for (size_t i = 0; i < n; i++) {
+		codes[i] = 0;
+
+		for (int j = 0; j < 3; j++) {
+			boost::uint32_t cell = (boost::uint32_t) ((coordinates[j][i * stride] - lower[j]) * scale[j]);
+			cell = (cell < (1u << Z_ORDER_BITS)) ? cell : (1u << Z_ORDER_BITS) - 1;
+			codes[i] |= spreadBits(cell) << j;
+		}
+
+		this->order[i] = (HullPointIndex) i;
+	}
+
+	for (int pass = 0; pass < 3; pass++) {
+		int shift = pass * Z_ORDER_BITS;
+		vector<size_t> starts((1 << Z_ORDER_BITS) + 1, 0);
+
+		for (size_t i = 0; i < n; i++) {
+			starts[((codes[i] >> shift) & ((1 << Z_ORDER_BITS) - 1)) + 1]++;
+		}
+
+		for (size_t i = 1; i < starts.size(); i++) {
+			starts[i] += starts[i - 1];
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			size_t slot = starts[(codes[i] >> shift) & ((1 << Z_ORDER_BITS) - 1)]++;
+			sortedCodes[slot] = codes[i];
+			sortedOrder[slot] = this->order[i];
+		}
+
+		codes.swap(sortedCodes);
+		this->order.swap(sortedOrder);
+	}
+
+	this->sorted.reserve(n);
+
+	for (size_t i = 0; i < n; i++) {
+		this->sorted.add(this->points.getX(this->order[i]), this->points.getY(this->order[i]),
+			this->points.getZ(this->order[i]));
+	}
+}
+
+/**
+ * The group's coordinates are handed to ConvexHullSolver in place, without
+ * being copied.
+ *
+ * \param group The group to solve
+ * \param thread The thread doing the work
+ */
+void ChanSolver::solveGroup(size_t group, unsigned int thread) {
+	Worker &worker = this->workers[thread];
+	Group &g = this->groups[group];
+	HullPointIndex begin = (HullPointIndex) (group * this->groupSize);
+	HullPointIndex end = (HullPointIndex) std::min(this->points.size(), (group + 1) * this->groupSize);
+
+	HullPointBuffer buffer(this->sorted.getXArray() + begin, this->sorted.getYArray() + begin,
+		this->sorted.getZArray() + begin, end - begin);
+	ConvexHullSolver solver(buffer, HullFaceScheduler::FURTHEST_FIRST, 0, 1);
+	solver.iterateToCompletion();
+
+	worker.statistics += solver.getStatistics();
+	g.vertices.clear();
+	g.offsets.clear();
+	g.neighbors.clear();
+	g.start = 0;
+
+	if (solver.getDimension() < 3) {
+		for (HullPointIndex i = begin; i < end; i++) {
+			g.vertices.push_back(this->order[i]);
+		}
+	} else {
+		findNeighbors(solver.getMesh(), begin, g, worker);
+	}
+
+	// Bound the group with a sphere about the middle of its bounding box.
+	const double *coordinates[3] = { this->points.getXArray(), this->points.getYArray(), this->points.getZArray() };
+	size_t stride = this->points.getStride();
+	double lower[3], upper[3];
+
+	for (int j = 0; j < 3; j++) {
+		lower[j] = upper[j] = coordinates[j][g.vertices[0] * stride];
+	}
+
+	for (HullPointIndexList::const_iterator i = g.vertices.begin(); i != g.vertices.end(); i++) {
+		for (int j = 0; j < 3; j++) {
+			double c = coordinates[j][*i * stride];
+			lower[j] = (c < lower[j]) ? c : lower[j];
+			upper[j] = (c > upper[j]) ? c : upper[j];
+		}
+	}
+
+	g.radius = 0.0;
+
+	for (int j = 0; j < 3; j++) {
+		g.center[j] = 0.5 * (lower[j] + upper[j]);
+		g.radius += (upper[j] - lower[j]) * (upper[j] - lower[j]);
+	}
+
+	g.radius = 0.5 * sqrt(g.radius) * (1.0 + BEHIND_TOLERANCE);
+}
+
+/**
+ * Each edge runs one way in one face and the other way in the other, so
+ * listing the end of every edge under its start lists each neighbor once.
+ *
+ * \param mesh The hull of the group
+ * \param begin The sorted index of the group's first point
+ * \param group The group, which receives the hull's vertices and their neighbors
+ * \param worker The worker solving the group
+ */
+void ChanSolver::findNeighbors(const HullMesh &mesh, HullPointIndex begin, Group &group, Worker &worker) {
+	HullPointIndex end = (HullPointIndex) std::min(this->points.size(), (size_t) begin + this->groupSize);
+
+	vector<unsigned int> &positions = worker.vertexPositions;
+	positions.assign(end - begin, NOT_A_VERTEX);
+
+	for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+		if (mesh.isLive(i)) {
+			for (int j = 0; j < 3; j++) {
+				HullPointIndex p = mesh.getFace(i).getPoint(j);
+
+				if (positions[p] == NOT_A_VERTEX) {
+					positions[p] = (unsigned int) group.vertices.size();
+					group.vertices.push_back(this->order[begin + p]);
+				}
+			}
+		}
+	}
+
+	group.offsets.assign(group.vertices.size() + 1, 0);
+
+	for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+		if (mesh.isLive(i)) {
+			for (int j = 0; j < 3; j++) {
+				group.offsets[positions[mesh.getFace(i).getPoint(j)] + 1]++;
+			}
+		}
+	}
+
+	for (size_t i = 1; i < group.offsets.size(); i++) {
+		group.offsets[i] += group.offsets[i - 1];
+	}
+
+	vector<unsigned int> cursors(group.offsets.begin(), group.offsets.end() - 1);
+	group.neighbors.resize(group.offsets.back());
+
+	for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+		if (mesh.isLive(i)) {
+			const HullFace &face = mesh.getFace(i);
+
+			for (int j = 0; j < 3; j++) {
+				group.neighbors[cursors[positions[face.getPoint(j)]]++] = positions[face.getPoint((j + 1) % 3)];
+			}
+		}
+	}
+}
+
+/**
+ * The lowest point is a vertex of the hull, and the edge from it to the
+ * point that all others are to the left of in the xy-plane is an edge of
+ * the hull.  The first face is wrapped onto that edge, and then a face is
+ * wrapped across each open edge until there are none.
+ *
+ * \return How the wrap ended
+ */
+ChanSolver::WrapResult ChanSolver::wrap() {
+	HullPredicateStatistics *statistics = &this->workers[0].statistics;
+	size_t maxFaces = 2 * (size_t) this->groupSize - 4;
+
+	this->hull.clear();
+	this->faceEdges.clear();
+	this->openEdges.clear();
+	this->lastGroup = 0;
+
+	HullPointIndex p0 = NO_HULL_POINT, p1 = NO_HULL_POINT, p2;
+
+	for (GroupList::const_iterator i = this->groups.begin(); i != this->groups.end(); i++) {
+		for (HullPointIndexList::const_iterator j = (*i).vertices.begin(); j != (*i).vertices.end(); j++) {
+			if (p0 == NO_HULL_POINT || isLower(this->points, *j, p0)) {
+				p0 = *j;
+			}
+		}
+	}
+
+	for (GroupList::const_iterator i = this->groups.begin(); i != this->groups.end(); i++) {
+		for (HullPointIndexList::const_iterator j = (*i).vertices.begin(); j != (*i).vertices.end(); j++) {
+			if (*j == p0) {
+				continue;
+			}
+
+			if (this->points.getX(*j) == this->points.getX(p0) && this->points.getY(*j) == this->points.getY(p0)) {
+				return DEGENERATE;
+			}
+
+			if (p1 == NO_HULL_POINT) {
+				p1 = *j;
+				continue;
+			}
+
+			int o = HullPredicates::orientation2d(this->points, p0, p1, *j, 2, statistics);
+
+			if (o == 0) {
+				return DEGENERATE;
+			}
+
+			if (o < 0) {
+				p1 = *j;
+			}
+		}
+	}
+
+	if (p1 == NO_HULL_POINT || !findCandidate(p0, p1, p2) || !addFace(p0, p1, p2)) {
+		return DEGENERATE;
+	}
+
+	while (!this->openEdges.empty()) {
+		FaceEdge open = this->openEdges.back();
+		this->openEdges.pop_back();
+
+		const HullFace &face = this->hull.getFace(open.face);
+
+		if (face.getNeighbor(open.edge) != NO_HULL_FACE) {
+			continue;
+		}
+
+		HullPointIndex p = face.getPoint(open.edge);
+		HullPointIndex q = face.getPoint((open.edge + 1) % 3);
+		FaceEdgeMap::const_iterator across = this->faceEdges.find(std::make_pair(q, p));
+
+		if (across != this->faceEdges.end()) {
+			this->hull.link(open.face, open.edge, across->second.face, across->second.edge);
+			continue;
+		}
+
+		if (this->hull.getNumFaces() >= maxFaces) {
+			return TOO_LARGE;
+		}
+
+		HullPointIndex c;
+
+		if (!findCandidate(q, p, c) || !addFace(q, p, c)) {
+			return DEGENERATE;
+		}
+	}
+
+	// Every edge has been matched, so the faces close up; with no four
+	// points coplanar, they must also make a sphere.
+	HullPointIndexList vertices;
+
+	for (HullFaceIndex i = 0; i < this->hull.getCapacity(); i++) {
+		if (this->hull.isLive(i)) {
+			for (int j = 0; j < 3; j++) {
+				vertices.push_back(this->hull.getFace(i).getPoint(j));
+			}
+		}
+	}
+
+	std::sort(vertices.begin(), vertices.end());
+	vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+	return (this->hull.getNumFaces() == 2 * vertices.size() - 4) ? WRAPPED : DEGENERATE;
+}
+
+/**
+ * \param p0 The first corner of the face
+ * \param p1 The second corner of the face
+ * \param p2 The third corner of the face
+ * \return false if another face already has one of the face's edges
+ */
+bool ChanSolver::addFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2) {
+	HullFaceIndex face = this->hull.addFace(HullFace(p0, p1, p2));
+
+	for (int i = 0; i < 3; i++) {
+		const HullFace &f = this->hull.getFace(face);
+		FaceEdge edge = { face, i };
+
+		if (!this->faceEdges.insert(std::make_pair(std::make_pair(f.getPoint(i), f.getPoint((i + 1) % 3)), edge)).second) {
+			return false;
+		}
+
+		this->openEdges.push_back(edge);
+	}
+
+	return true;
+}
+
+/**
+ * The candidate is the point that leaves every point behind or on the
+ * plane through p0, p1 and itself.  Each group offers the vertex of its
+ * hull that does so for the group, and the best of those wins.
+ *
+ * \param p0 The first corner of the face
+ * \param p1 The second corner of the face
+ * \param candidate Receives the third corner of the face
+ * \return false if the choice is tied
+ */
+bool ChanSolver::findCandidate(HullPointIndex p0, HullPointIndex p1, HullPointIndex &candidate) {
+	HullPredicateStatistics *statistics = &this->workers[0].statistics;
+	candidate = NO_HULL_POINT;
+
+	// Neighboring faces tend to take their corners from the same group, so
+	// start with the last one to get a good plane to skip the others by.
+	size_t first = this->lastGroup;
+
+	for (size_t k = 0; k < this->groups.size(); k++) {
+		size_t i = (k == 0) ? first : ((k <= first) ? k - 1 : k);
+		HullPointIndex c;
+
+		if (candidate != NO_HULL_POINT && isBehind(this->groups[i], p0, p1, candidate)) {
+			continue;
+		}
+
+		if (!climb(this->groups[i], p0, p1, c)) {
+			return false;
+		}
+
+		if (c == NO_HULL_POINT) {
+			continue;
+		}
+
+		int o = (candidate != NO_HULL_POINT) ? HullPredicates::orientation(this->points, p0, p1, candidate, c, statistics) : 1;
+
+		if (o == 0) {
+			return false;
+		}
+
+		if (o > 0) {
+			candidate = c;
+			this->lastGroup = i;
+		}
+	}
+
+	return candidate != NO_HULL_POINT && !HullPredicates::collinear(this->points, p0, p1, candidate, statistics);
+}
+
+/**
+ * A plane through p0 and p1 that leaves every neighbor of a vertex behind
+ * it leaves the whole of a convex hull behind it, so the search steps from
+ * vertex to vertex, to any neighbor in front of the current plane, until
+ * none is.  A flat group has no neighbors to follow, so all of its points
+ * are tried.
+ *
+ * \param group The group
+ * \param p0 The first corner of the face
+ * \param p1 The second corner of the face
+ * \param candidate Receives the best vertex, or NO_HULL_POINT if the group
+ *   has no vertices besides p0 and p1
+ * \return false if the choice is tied
+ */
+bool ChanSolver::climb(Group &group, HullPointIndex p0, HullPointIndex p1, HullPointIndex &candidate) {
+	HullPredicateStatistics *statistics = &this->workers[0].statistics;
+	candidate = NO_HULL_POINT;
+
+	if (group.offsets.empty()) {
+		for (HullPointIndexList::const_iterator i = group.vertices.begin(); i != group.vertices.end(); i++) {
+			if (*i == p0 || *i == p1) {
+				continue;
+			}
+
+			if (candidate == NO_HULL_POINT) {
+				candidate = *i;
+				continue;
+			}
+
+			int o = HullPredicates::orientation(this->points, p0, p1, candidate, *i, statistics);
+
+			if (o == 0) {
+				return false;
+			}
+
+			if (o > 0) {
+				candidate = *i;
+			}
+		}
+
+		return true;
+	}
+
+	unsigned int v = group.start;
+
+	// Step off p0 and p1, which can't make a face with themselves.
+	if (group.vertices[v] == p0 || group.vertices[v] == p1) {
+		for (unsigned int i = group.offsets[v]; i < group.offsets[v + 1]; i++) {
+			unsigned int w = group.neighbors[i];
+
+			if (group.vertices[w] != p0 && group.vertices[w] != p1) {
+				v = w;
+				break;
+			}
+		}
+	}
+
+	bool tied;
+
+	for (bool moved = true; moved; ) {
+		moved = false;
+		tied = false;
+
+		for (unsigned int i = group.offsets[v]; i < group.offsets[v + 1]; i++) {
+			HullPointIndex w = group.vertices[group.neighbors[i]];
+
+			if (w == p0 || w == p1) {
+				continue;
+			}
+
+			int o = HullPredicates::orientation(this->points, p0, p1, group.vertices[v], w, statistics);
+
+			if (o > 0) {
+				v = group.neighbors[i];
+				moved = true;
+				break;
+			}
+
+			tied = tied || (o == 0);
+		}
+	}
+
+	group.start = v;
+	candidate = group.vertices[v];
+	return !tied;
+}
+
+/**
+ * The plane's normal is found in floating point, so the sphere has to be
+ * behind it by a margin that covers the rounding error.
+ *
+ * \param group The group
+ * \param p0 The first point on the plane
+ * \param p1 The second point on the plane
+ * \param p2 The third point on the plane
+ * \return true if every point of the group is behind the plane
+ */
+bool ChanSolver::isBehind(const Group &group, HullPointIndex p0, HullPointIndex p1, HullPointIndex p2) const {
+	const HullPointBuffer &pts = this->points;
+	double ux = pts.getX(p1) - pts.getX(p0), uy = pts.getY(p1) - pts.getY(p0), uz = pts.getZ(p1) - pts.getZ(p0);
+	double vx = pts.getX(p2) - pts.getX(p0), vy = pts.getY(p2) - pts.getY(p0), vz = pts.getZ(p2) - pts.getZ(p0);
+	double nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+	double cx = group.center[0] - pts.getX(p0), cy = group.center[1] - pts.getY(p0), cz = group.center[2] - pts.getZ(p0);
+
+	double u = sqrt(ux * ux + uy * uy + uz * uz);
+	double v = sqrt(vx * vx + vy * vy + vz * vz);
+	double c = sqrt(cx * cx + cy * cy + cz * cz);
+	double n = sqrt(nx * nx + ny * ny + nz * nz);
+
+	return nx * cx + ny * cy + nz * cz + n * group.radius < -BEHIND_TOLERANCE * u * v * (c + group.radius);
+}
+
+/**
+ * \param buffer The points to solve
+ * \param pointMap The index in the input of each of the buffer's points, or
+ *   NULL if the buffer is the input
+ */
+void ChanSolver::solve(const HullPointBuffer &buffer, const HullPointIndex *pointMap) {
+	ConvexHullSolver solver(buffer, HullFaceScheduler::FURTHEST_FIRST, 0, getNumThreads());
+	solver.iterateToCompletion();
+
+	this->workers[0].statistics += solver.getStatistics();
+	this->dimension = solver.getDimension();
+	this->complete = true;
+	this->hull.clear();
+
+	const HullMesh &mesh = solver.getMesh();
+	HullFaceIndexList faceMap(mesh.getCapacity(), NO_HULL_FACE);
+
+	for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+		if (mesh.isLive(i)) {
+			const HullFace &face = mesh.getFace(i);
+			HullPointIndex p0 = (pointMap != NULL) ? pointMap[face.getP0()] : face.getP0();
+			HullPointIndex p1 = (pointMap != NULL) ? pointMap[face.getP1()] : face.getP1();
+			HullPointIndex p2 = (pointMap != NULL) ? pointMap[face.getP2()] : face.getP2();
+			faceMap[i] = this->hull.addFace(HullFace(p0, p1, p2));
+		}
+	}
+
+	for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+		if (faceMap[i] != NO_HULL_FACE) {
+			for (int j = 0; j < 3; j++) {
+				this->hull.getFace(faceMap[i]).setNeighbor(j, faceMap[mesh.getFace(i).getNeighbor(j)]);
+			}
+		}
+	}
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+void ChanSolver::run(size_t numTasks, void (ChanSolver::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
@@ -2,182 +2,1739 @@
  * \file ConvexHullSolver.cpp
  * \author Douglas W. Paul
  *
- * Defines the behavior of the ConvexHullSolver class
+ * Defines the behavior of the BasicConvexHullSolver class template
  */
 
 #include "ConvexHullSolver.h"
 #include "HullEdge.h"
+#include "PointClassifier.h"
+#include "HullPredicates.h"
+#include "InteriorPointFilter.h"
+#include <boost/bind.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include <map>
 
 using namespace peek;
 
+template <typename T>
+const size_t BasicConvexHullSolver<T>::BLOCK_SIZE;
+
+template <typename T>
+const size_t BasicConvexHullSolver<T>::CANDIDATES_PER_THREAD;
+
 /**
  * \param inputPoints The points whose convex hull to find
+ * \param policy The order in which to consider faces
+ * \param filterDirections The number of directions (6, 14 or 26) in which
+ *   the interior point filter finds extreme points, or 0 to not filter
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+template <typename T>
+BasicConvexHullSolver<T>::BasicConvexHullSolver(const Point3dSet &inputPoints, HullFaceScheduler::Policy policy,
+	unsigned int filterDirections, unsigned int numThreads)
+	: points(inputPoints), scheduler(policy), filterDirections(filterDirections), dynamic(false) {
+	setNumThreads(numThreads);
+	initialize();
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find.  If the buffer
+ *   refers to arrays owned by the caller, the coordinates are not copied,
+ *   and the arrays must outlive the solver.
+ * \param policy The order in which to consider faces
+ * \param filterDirections The number of directions (6, 14 or 26) in which
+ *   the interior point filter finds extreme points, or 0 to not filter
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+template <typename T>
+BasicConvexHullSolver<T>::BasicConvexHullSolver(const PointBuffer &inputPoints, HullFaceScheduler::Policy policy,
+	unsigned int filterDirections, unsigned int numThreads)
+	: points(inputPoints), scheduler(policy), filterDirections(filterDirections), dynamic(false) {
+	setNumThreads(numThreads);
+	initialize();
+}
+
+/**
+ * The hull, the conflict graph and the workers' scratch space keep their
+ * capacity, so that solving many small sets of points one after another
+ * allocates little past the first.  The threads, the scheduling policy,
+ * the filter and dynamic mode stay as they were, and points go back to
+ * being added in the scheduler's order.
+ *
+ * \param inputPoints The points whose convex hull to find.  If the buffer
+ *   refers to arrays owned by the caller, the coordinates are not copied,
+ *   and the arrays must outlive the solver.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::reset(const PointBuffer &inputPoints) {
+	this->points = inputPoints;
+	this->hull.clear();
+	this->scheduler.clear();
+	this->insertionOrder.clear();
+	this->deferredPoints.clear();
+
+	// The rounds start over from zero, so claims from the last solve would
+	// look current.
+	this->faceClaims.clear();
+	this->faceClaimedVisible.clear();
+
+	initialize();
+
+	if (this->dynamic) {
+		setDynamic();
+	}
+}
+
+/**
+ * Must only be called once the hull is complete.  The new points follow
+ * the old ones in getPoints().  Each is located by a short walk over the
+ * hull (see locate), which takes one plane test to either drop it as
+ * inside (filing it under that face, in dynamic mode) or associate it with
+ * a face it can see, after which the hull is no longer complete.  If there
+ * is no center to walk from, the points are instead classified against
+ * every face in blocks, just as orphans are.
+ * Iterating then carves out only the faces that the new points can see,
+ * without touching the rest of the hull or revisiting the old points.
+ *
+ * If the solver's points refer to arrays owned by the caller, they are
+ * copied on the first call, since the buffer must grow.  If the points so
+ * far had no 3-D hull, the solver starts over on all of them (less any that
+ * were removed).
+ *
+ * \param newPoints The points to add
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::insert(const PointBuffer &newPoints) {
+	HullPointIndex first = (HullPointIndex) this->points.size();
+	this->points.append(newPoints);
+
+	if (this->dynamic) {
+		this->removedPoints.resize(this->points.size(), 0);
+		this->pointRegions.resize(this->points.size(), NO_HULL_FACE);
+	}
+
+	if (this->dimension < 3) {
+		if (this->dynamic) {
+			rebuild();
+		} else {
+			reset(this->points);
+		}
+
+		return;
+	}
+
+	this->pointFaces.resize(this->points.size(), NO_HULL_FACE);
+
+	// The faces' error bounds hold only for points no larger than the
+	// magnitude they were computed with, so if the new points are larger,
+	// the planes are worked out again.  The hull is complete, so the faces
+	// have no points to lose.  The magnitude is doubled while at it, so
+	// that a cloud growing a little at a time is seldom refitted.
+	double newMagnitude = newPoints.getMagnitude();
+
+	if (newMagnitude > this->magnitude) {
+		this->magnitude = 2.0 * newMagnitude;
+
+		for (HullFaceIndex f = 0; f < this->hull.getCapacity(); f++) {
+			if (this->hull.isLive(f)) {
+				Face &face = this->hull.getFace(f);
+				Face refitted(face.getP0(), face.getP1(), face.getP2(), this->points, this->magnitude);
+
+				for (int i = 0; i < 3; i++) {
+					refitted.setNeighbor(i, face.getNeighbor(i));
+				}
+
+				face = refitted;
+			}
+		}
+	}
+
+	this->expansions.resize(1);
+	Expansion &expansion = this->expansions[0];
+	Worker &worker = this->workers[0];
+	HullFaceIndexList seenFaces;
+	expansion.orphans.clear();
+
+	// Each point is settled by walking to the one face in its direction
+	// from the center: behind it, the point is inside the hull, and in
+	// front of it, the point can see it.
+	for (HullPointIndex i = first; i < this->points.size(); i++) {
+		HullFaceIndex face = this->centered ? locate(i, worker) : NO_HULL_FACE;
+
+		if (face == NO_HULL_FACE) {
+			expansion.orphans.push_back(i);
+			continue;
+		}
+
+		double d = distanceTo(this->hull.getFace(face), i, worker);
+
+		if (d > 0.0) {
+			associate(i, face, d);
+
+			if (this->hull.getFace(face).getNumAssociatedPoints() == 1) {
+				seenFaces.push_back(face);
+			}
+		} else if (this->dynamic) {
+			file(i, face);
+		}
+	}
+
+	// Without a center, the points are tested against every face instead.
+	// A face must only be scheduled once, so then every face is scheduled
+	// afterwards.
+	if (!expansion.orphans.empty()) {
+		expansion.newFaces.clear();
+
+		for (HullFaceIndex f = 0; f < this->hull.getCapacity(); f++) {
+			if (this->hull.isLive(f)) {
+				expansion.newFaces.push_back(f);
+			}
+		}
+
+		distributeOrphans();
+		seenFaces.swap(expansion.newFaces);
+	}
+
+	for (size_t i = 0; i < seenFaces.size(); i++) {
+		schedule(seenFaces[i]);
+	}
+
+	for (HullPointIndex i = first; i < this->points.size(); i++) {
+		if (this->pointFaces[i] != NO_HULL_FACE) {
+			this->complete = false;
+
+			if (this->randomOrder) {
+				this->insertionOrder.push_back(i);
+			}
+		}
+	}
+}
+
+/**
+ * Must only be called once the hull is complete, and turns on dynamic mode
+ * (see setDynamic) if it is off.  The point keeps its index, and insert()
+ * goes on numbering new points after it.
+ *
+ * A point inside the hull is only marked as removed: it is left in its
+ * face's group, and skipped whenever the group is next looked at.  A vertex
+ * takes its faces with it, and the hole they leave is filled with the part
+ * of the hull of the points filed under them (and the vertices around the
+ * hole) that the removed vertex could see.  Every other face stays as it
+ * was.  If the hole can't be filled that way (the points around it being
+ * degenerate, say), the hull is found again from scratch.
+ *
+ * \param p The point to remove
  */
-ConvexHullSolver::ConvexHullSolver(Point3dSet inputPoints) {
+template <typename T>
+void BasicConvexHullSolver<T>::remove(HullPointIndex p) {
+	if (!this->dynamic) {
+		setDynamic();
+	}
+
+	if (p >= this->points.size() || this->removedPoints[p]) {
+		return;
+	}
+
+	fileInteriorPoints();
+	this->removedPoints[p] = 1;
+
+	if (this->pointRegions[p] != NO_HULL_FACE) {
+		return;
+	}
+
+	if (this->dimension < 3 || !this->centered || !removeVertex(p)) {
+		rebuild();
+	}
+}
+
+template <typename T>
+void BasicConvexHullSolver<T>::initialize() {
 	this->complete = false;
+	this->round = 0;
+	this->dimension = 0;
+	this->culledFraction = 0.0;
+	this->randomOrder = false;
+	this->seed = DEFAULT_SEED;
+	this->nextInsertion = 0;
+	this->nextDeferred = 0;
+	this->centered = false;
+	this->walkStart = NO_HULL_FACE;
+	this->faceRegions.clear();
+	this->pointRegions.clear();
+	this->unfiledPoints.clear();
+	this->removedPoints.clear();
 
 	// If there are fewer than three points, the hull has no faces.
-	if (inputPoints.size() < 3) {
+	if (this->points.size() < 3) {
+		this->dimension = (this->points.size() < 2) ? 0 : 1;
+		this->complete = true;
+		return;
+	}
+
+	this->pointFaces.assign(this->points.size(), NO_HULL_FACE);
+	this->magnitude = this->points.getMagnitude();
+
+	// Start from the largest tetrahedron we can find cheaply.  If there is
+	// none, the points are collinear or coplanar and have no 3-D hull.
+	HullPointIndex simplex[4];
+	this->dimension = findInitialSimplex(simplex);
+
+	if (this->dimension < 3) {
 		this->complete = true;
 		return;
 	}
 
-	// Grab three points from the list.
-	Point3d p0 = inputPoints.popOne();
-	Point3d p1 = inputPoints.popOne();
-	Point3d p2 = inputPoints.popOne();
+	// Order the corners so that the last one is behind the face made by the
+	// first three.  The four faces are then all counter-clockwise as seen
+	// from outside.
+	if (HullPredicates::orientation(this->points, simplex[0], simplex[1], simplex[2], simplex[3],
+		&this->workers[0].statistics) > 0) {
+
+		std::swap(simplex[1], simplex[2]);
+	}
+
+	HullPointIndex p0 = simplex[0];
+	HullPointIndex p1 = simplex[1];
+	HullPointIndex p2 = simplex[2];
+	HullPointIndex p3 = simplex[3];
+
+	this->expansions.resize(1);
+	Expansion &expansion = this->expansions[0];
+	HullFaceIndexList &faces = expansion.newFaces;
+	faces.clear();
+	faces.push_back(this->hull.addFace(Face(p0, p1, p2, this->points, this->magnitude)));
+	faces.push_back(this->hull.addFace(Face(p0, p3, p1, this->points, this->magnitude)));
+	faces.push_back(this->hull.addFace(Face(p1, p3, p2, this->points, this->magnitude)));
+	faces.push_back(this->hull.addFace(Face(p2, p3, p0, this->points, this->magnitude)));
+
+	// Each edge of each face is shared with exactly one other face.
+	for (size_t a = 0; a < faces.size(); a++) {
+		for (int i = 0; i < 3; i++) {
+			const Face &face = this->hull.getFace(faces[a]);
+
+			for (size_t b = 0; b < faces.size(); b++) {
+				int j = this->hull.getFace(faces[b]).findEdge(face.getPoint((i + 1) % 3), face.getPoint(i));
+
+				if (b != a && j >= 0) {
+					this->hull.link(faces[a], i, faces[b], j);
+				}
+			}
+		}
+	}
+
+	// Until points are removed, the hull only grows, so a point inside the
+	// tetrahedron stays inside it.
+	recenter();
+
+	// Associate each of the remaining input points with a face it can see.
+	// Points inside the tetrahedron see none, and are dropped right away.
+	// If the filter is on, the points that it discards never get this far.
+	HullPointIndexList candidates;
+
+	if (this->filterDirections > 0) {
+		InteriorPointFilter filter(this->filterDirections, getNumThreads());
+		candidates = filter.apply(this->points);
+		this->culledFraction = filter.getCulledFraction();
+	} else {
+		candidates.resize(this->points.size());
+
+		for (HullPointIndex i = 0; i < this->points.size(); i++) {
+			candidates[i] = i;
+		}
+	}
+
+	expansion.orphans.clear();
+
+	for (HullPointIndexList::const_iterator i = candidates.begin(); i != candidates.end(); i++) {
+		if (*i != p0 && *i != p1 && *i != p2 && *i != p3) {
+			expansion.orphans.push_back(*i);
+		}
+	}
+
+	distributeOrphans();
+
+	for (size_t a = 0; a < faces.size(); a++) {
+		schedule(faces[a]);
+	}
+}
+
+/**
+ * Takes the points with the smallest and largest x, y and z, and picks the
+ * two of those six that are furthest apart.  The third corner is the point
+ * furthest from the line through the first two, and the fourth is the
+ * point furthest from the plane through the first three.  The points at the
+ * extremes of the input are likely to be on the hull, and a large starting
+ * tetrahedron swallows many interior points before any iteration runs.
+ *
+ * \param simplex Receives the corners of the tetrahedron
+ * \return The number of dimensions the points span: 3 if simplex holds a
+ *   tetrahedron with nonzero volume, 2 if the points are coplanar, 1 if they
+ *   are collinear, and 0 if they are all the same point
+ */
+template <typename T>
+unsigned int BasicConvexHullSolver<T>::findInitialSimplex(HullPointIndex simplex[4]) {
+	const PointBuffer &pts = this->points;
+	HullPointIndex extremes[6] = { 0, 0, 0, 0, 0, 0 };
+
+	for (HullPointIndex i = 1; i < pts.size(); i++) {
+		if (pts.getX(i) < pts.getX(extremes[0])) extremes[0] = i;
+		if (pts.getX(i) > pts.getX(extremes[1])) extremes[1] = i;
+		if (pts.getY(i) < pts.getY(extremes[2])) extremes[2] = i;
+		if (pts.getY(i) > pts.getY(extremes[3])) extremes[3] = i;
+		if (pts.getZ(i) < pts.getZ(extremes[4])) extremes[4] = i;
+		if (pts.getZ(i) > pts.getZ(extremes[5])) extremes[5] = i;
+	}
+
+	// The two extremes furthest apart...
+	double maxD = 0.0;
+
+	for (int a = 0; a < 6; a++) {
+		for (int b = a + 1; b < 6; b++) {
+			double dx = (double) pts.getX(extremes[b]) - pts.getX(extremes[a]);
+			double dy = (double) pts.getY(extremes[b]) - pts.getY(extremes[a]);
+			double dz = (double) pts.getZ(extremes[b]) - pts.getZ(extremes[a]);
+			double d = dx * dx + dy * dy + dz * dz;
+
+			if (d > maxD) {
+				simplex[0] = extremes[a];
+				simplex[1] = extremes[b];
+				maxD = d;
+			}
+		}
+	}
+
+	if (maxD == 0.0) {
+		return 0;
+	}
+
+	// ...the point furthest from the line through them...
+	double ux = (double) pts.getX(simplex[1]) - pts.getX(simplex[0]);
+	double uy = (double) pts.getY(simplex[1]) - pts.getY(simplex[0]);
+	double uz = (double) pts.getZ(simplex[1]) - pts.getZ(simplex[0]);
+	maxD = 0.0;
+
+	for (HullPointIndex i = 0; i < pts.size(); i++) {
+		double wx = (double) pts.getX(i) - pts.getX(simplex[0]);
+		double wy = (double) pts.getY(i) - pts.getY(simplex[0]);
+		double wz = (double) pts.getZ(i) - pts.getZ(simplex[0]);
+		double cx = uy * wz - uz * wy;
+		double cy = uz * wx - ux * wz;
+		double cz = ux * wy - uy * wx;
+		double d = cx * cx + cy * cy + cz * cz;
+
+		if (d > maxD) {
+			simplex[2] = i;
+			maxD = d;
+		}
+	}
+
+	if (maxD == 0.0) {
+		return 1;
+	}
 
-	// Construct two faces from the points we just grabbed.
-	HullFace face1(p0, p1, p2);
-	HullFace face2(p2, p1, p0);
+	// ...and the point furthest from the plane through all three.
+	double vx = (double) pts.getX(simplex[2]) - pts.getX(simplex[0]);
+	double vy = (double) pts.getY(simplex[2]) - pts.getY(simplex[0]);
+	double vz = (double) pts.getZ(simplex[2]) - pts.getZ(simplex[0]);
+	double nx = uy * vz - uz * vy;
+	double ny = uz * vx - ux * vz;
+	double nz = ux * vy - uy * vx;
+	maxD = 0.0;
+	simplex[3] = simplex[0];
 
-	// Associate each of the remaining input points with one of the two faces.
-	while (inputPoints.size() > 0) {
-		Point3d p = inputPoints.popOne();
-		double d = determinant(p2, p1, p0, p);
+	for (HullPointIndex i = 0; i < pts.size(); i++) {
+		double d = fabs(nx * ((double) pts.getX(i) - pts.getX(simplex[0]))
+			+ ny * ((double) pts.getY(i) - pts.getY(simplex[0]))
+			+ nz * ((double) pts.getZ(i) - pts.getZ(simplex[0])));
 
-		// If the determinant is positive, the point is in front of face1.
-		// If the determinant is negative, the point is in front of face2.
-		if (d >= 0.0) {
-			face1.associate(p);
+		if (d > maxD) {
+			simplex[3] = i;
+			maxD = d;
 		}
-		else if (d < 0.0) {
-			face2.associate(p);
+	}
+
+	if (HullPredicates::orientation(pts, simplex[0], simplex[1], simplex[2], simplex[3],
+		&this->workers[0].statistics) != 0) {
+
+		return 3;
+	}
+
+	// The points are all within rounding error of the plane.  Only if every
+	// one of them is exactly in it is there no tetrahedron at all.
+	for (HullPointIndex i = 0; i < pts.size(); i++) {
+		if (HullPredicates::orientation(pts, simplex[0], simplex[1], simplex[2], i,
+			&this->workers[0].statistics) != 0) {
+
+			simplex[3] = i;
+			return 3;
 		}
 	}
 
-	// Start the hull with the faces we just created.
-	this->hull.add(face1);
-	this->hull.add(face2);
+	return 2;
 }
 
-void ConvexHullSolver::iterate() {
+template <typename T>
+void BasicConvexHullSolver<T>::iterate() {
 	if (isComplete()) {
 		return;
 	}
 
-	auto_ptr<HullFace> potentialFace = determineNextFaceToConsider();
+	this->expansions.resize(1);
+	Expansion &expansion = this->expansions[0];
 
-	// If there are no more faces to consider, then the hull is complete.
-	if (potentialFace.get() == NULL) {
+	// If there are no more points to add, then the hull is complete.
+	if (!determineNextPointToAdd(expansion.point, expansion.face)) {
 		this->complete = true;
 		return;
 	}
 
-	// Find the point furthest from the face and add it to the hull.
-	HullPoint furthestPoint = potentialFace->getFurthestPoint();
-	addPointToHull(furthestPoint);
+	findVisibleFaces(0, 0);
+	replaceFaces(expansion);
+	distributeOrphans();
+
+	for (size_t i = 0; i < expansion.newFaces.size(); i++) {
+		schedule(expansion.newFaces[i]);
+	}
 }
 
-void ConvexHullSolver::iterateToCompletion() {
+/**
+ * With more than one thread, the hull is grown several points at a time
+ * (see iterateInParallel).  The hull that results is the same as with one
+ * thread, though where four or more points are coplanar, the triangles
+ * that cover the face may differ.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::iterateToCompletion() {
 	while (!isComplete()) {
-		iterate();
+		if (this->pool.get() != 0) {
+			iterateInParallel();
+		} else {
+			iterate();
+		}
+	}
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	// Keep the first worker, so that its counters carry over.
+	this->workers.resize(numThreads);
+
+	for (typename WorkerList::iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		(*i).search = 0;
+		(*i).blockPoints.resize(BLOCK_SIZE);
+		(*i).blockSlots.resize(BLOCK_SIZE);
+		(*i).blockDistances.resize(BLOCK_SIZE);
+		(*i).blockMask.resize(BLOCK_SIZE);
+	}
+
+	this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over all threads
+ */
+template <typename T>
+HullPredicateStatistics BasicConvexHullSolver<T>::getStatistics() const {
+	HullPredicateStatistics statistics;
+
+	for (typename WorkerList::const_iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		statistics += (*i).statistics;
+	}
+
+	return statistics;
+}
+
+/**
+ * Every input point is shuffled into the order, including those already on
+ * or inside the hull, which are skipped when they come up.  Added in a
+ * random order, the points each see a constant number of faces removed
+ * from under them on average (Clarkson and Shor), so the hull takes
+ * O(n log n) expected time however the input is ordered.  The bound only
+ * holds if this is called before iterating.
+ *
+ * \param seed The seed of the random order.  The same seed and input give
+ *   the same order, and so the same hull.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::setRandomOrder(unsigned int seed) {
+	this->randomOrder = true;
+	this->seed = seed;
+	this->insertionOrder.resize(this->points.size());
+
+	for (HullPointIndex i = 0; i < this->points.size(); i++) {
+		this->insertionOrder[i] = i;
+	}
+
+	boost::mt19937 generator(seed);
+
+	for (size_t i = this->insertionOrder.size(); i > 1; i--) {
+		boost::uniform_int<size_t> pick(0, i - 1);
+		std::swap(this->insertionOrder[i - 1], this->insertionOrder[pick(generator)]);
+	}
+
+	this->nextInsertion = 0;
+	this->deferredPoints.clear();
+	this->nextDeferred = 0;
+	this->scheduler.clear();
+}
+
+/**
+ * Each point inside the hull is filed under the face whose cone from the
+ * center holds it.  The cones of the faces around a vertex hold every
+ * point that could come to the surface if the vertex were removed, so
+ * remove() only ever has to look at those.  As the hull grows, the points
+ * of faces that are replaced, and the points and vertices that are newly
+ * inside, wait to be filed until a point is next removed.
+ *
+ * Filing every point costs a walk over the hull per point, so if the hull
+ * is already complete, this takes some time.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::setDynamic() {
+	this->dynamic = true;
+	this->removedPoints.resize(this->points.size(), 0);
+	regroup();
+}
+
+/**
+ * In the scheduler's order, the point is the furthest point of the next
+ * scheduled face.  In a random order, it is the next point in the order
+ * that is still outside the hull, and the face is the one it is associated
+ * with.
+ *
+ * \param point Receives the point to add
+ * \param face Receives a face that the point can see
+ * \return Whether or not there is a point left to add
+ */
+template <typename T>
+bool BasicConvexHullSolver<T>::determineNextPointToAdd(HullPointIndex &point, HullFaceIndex &face) {
+	if (!this->randomOrder) {
+		face = this->scheduler.next();
+
+		if (face == NO_HULL_FACE) {
+			return false;
+		}
+
+		point = this->hull.getFace(face).getFurthestPoint();
+		return true;
+	}
+
+	while (this->nextDeferred < this->deferredPoints.size()) {
+		point = this->deferredPoints[this->nextDeferred++];
+
+		if (this->pointFaces[point] != NO_HULL_FACE) {
+			face = this->pointFaces[point];
+			return true;
+		}
+	}
+
+	while (this->nextInsertion < this->insertionOrder.size()) {
+		point = this->insertionOrder[this->nextInsertion++];
+
+		if (this->pointFaces[point] != NO_HULL_FACE) {
+			face = this->pointFaces[point];
+			return true;
+		}
 	}
+
+	return false;
 }
 
 /**
- * \return A pointer to the face to consider. (A NULL pointer if there is none.)
- * \todo Implement using Boost Library's "optional" template, instead of auto_ptr
+ * Each face of the hull, together with the center, makes a cone, and the
+ * cones cover all of space without overlapping.  The walk starts from
+ * whichever is nearest the point of the face where the last walk ended and
+ * a sample of about the cube root of the number of faces (so that points
+ * with nothing in common with the last one still start nearby), and
+ * crosses the edges of the face with the point on their far side until it
+ * reaches the face whose cone holds the point.  The point is then inside
+ * the hull if and only if it is behind that face.  The sides of the cones
+ * are tested exactly, so a point on a side goes to one of the faces on
+ * either side of it, and never to neither.  To keep the walk from going
+ * around in circles, each face tries its edges starting from a different
+ * one at each step, and if the walk still goes on for more than a number
+ * of steps on the order of the square root of the number of faces, every
+ * face is tried instead.
  *
- * When the solver has run out of faces to consider, this function returns an uninitialized
- * auto_ptr.
+ * Must only be called if there is a center.
+ *
+ * \param p The point
+ * \param worker The worker whose counters to update
+ * \return The face whose cone holds the point
  */
-auto_ptr<HullFace> ConvexHullSolver::determineNextFaceToConsider() {
-	// Try to find a face with associated points...
-	for (HullFaceSet::iterator i = this->hull.begin(); i != this->hull.end(); i++) {
-		if ((*i).getNumAssociatedPoints() > 0) {
-			return auto_ptr<HullFace>(new HullFace(*i));
+template <typename T>
+HullFaceIndex BasicConvexHullSolver<T>::locate(HullPointIndex p, Worker &worker) {
+	const PointBuffer &pts = this->points;
+	HullFaceIndex capacity = this->hull.getCapacity();
+	HullFaceIndex numSamples = (HullFaceIndex) pow((double) capacity, 1.0 / 3.0) + 1;
+	HullFaceIndex face = NO_HULL_FACE;
+	double nearest = 0.0;
+
+	for (HullFaceIndex i = 0; i <= numSamples; i++) {
+		HullFaceIndex sample = (i == numSamples) ? this->walkStart
+			: (HullFaceIndex) ((double) i * capacity / numSamples);
+
+		if (sample < capacity && this->hull.isLive(sample)) {
+			HullPointIndex q = this->hull.getFace(sample).getP0();
+			double dx = (double) pts.getX(q) - pts.getX(p);
+			double dy = (double) pts.getY(q) - pts.getY(p);
+			double dz = (double) pts.getZ(q) - pts.getZ(p);
+			double d = dx * dx + dy * dy + dz * dz;
+
+			if (face == NO_HULL_FACE || d < nearest) {
+				face = sample;
+				nearest = d;
+			}
+		}
+	}
+
+	if (face == NO_HULL_FACE) {
+		for (face = 0; !this->hull.isLive(face); face++) {
+		}
+	}
+
+	size_t maxSteps = 16 + 4 * (size_t) sqrt((double) this->hull.getNumFaces());
+
+	for (size_t step = 0; step < maxSteps; step++) {
+		const Face &f = this->hull.getFace(face);
+		int crossed = -1;
+
+		for (int k = 0; k < 3 && crossed < 0; k++) {
+			int edge = (int) ((step + k) % 3);
+
+			if (orientationWithCenter(NO_HULL_POINT, f.getPoint(edge), f.getPoint((edge + 1) % 3), p, worker) < 0) {
+				crossed = edge;
+			}
+		}
+
+		if (crossed < 0) {
+			this->walkStart = face;
+			return face;
+		}
+
+		face = f.getNeighbor(crossed);
+	}
+
+	for (face = 0; face < capacity; face++) {
+		if (this->hull.isLive(face)) {
+			const Face &f = this->hull.getFace(face);
+
+			if (orientationWithCenter(NO_HULL_POINT, f.getP0(), f.getP1(), p, worker) >= 0
+				&& orientationWithCenter(NO_HULL_POINT, f.getP1(), f.getP2(), p, worker) >= 0
+				&& orientationWithCenter(NO_HULL_POINT, f.getP2(), f.getP0(), p, worker) >= 0) {
+
+				this->walkStart = face;
+				return face;
+			}
 		}
 	}
 
-	return auto_ptr<HullFace>();
+	return NO_HULL_FACE;
 }
 
 /**
- * \param p The point to add to the hull
+ * The four points are copied to a small buffer of their own, so the center
+ * is held to the same exact arithmetic as the input points.
+ *
+ * \param p0 The first corner of the plane, or NO_HULL_POINT for the center
+ * \param p1 The second corner of the plane, or NO_HULL_POINT for the center
+ * \param p2 The third corner of the plane, or NO_HULL_POINT for the center
+ * \param p The point to test, or NO_HULL_POINT for the center
+ * \param worker The worker whose counters to update
+ * \return 1 if the point is in front of the plane, -1 if it is behind, and 0
+ *   if it is in it
  */
-void ConvexHullSolver::addPointToHull(HullPoint p) {
-	// Remove from the hull all faces that the point can "see" (is in front
-	// of). Keep track of what edges are part of the hole we create in the
-	// hull, and maintain a list of all of the "candidate" points that were
-	// associated with the faces we're removing.
+template <typename T>
+int BasicConvexHullSolver<T>::orientationWithCenter(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2,
+	HullPointIndex p, Worker &worker) const {
+
+	HullPointIndex corners[4] = { p0, p1, p2, p };
+	T x[4], y[4], z[4];
 
-	HullPointSet points;
-	HullEdgeSet edges;
-	HullFaceSet facesToRemove;
+	for (int i = 0; i < 4; i++) {
+		if (corners[i] == NO_HULL_POINT) {
+			x[i] = this->center[0];
+			y[i] = this->center[1];
+			z[i] = this->center[2];
+		} else {
+			x[i] = this->points.getX(corners[i]);
+			y[i] = this->points.getY(corners[i]);
+			z[i] = this->points.getZ(corners[i]);
+		}
+	}
 
-	for (HullFaceSet::iterator i = this->hull.begin(); i != this->hull.end(); i++) {
-		HullPoint p0 = (*i).getP0();
-		HullPoint p1 = (*i).getP1();
-		HullPoint p2 = (*i).getP2();
-		HullPoint p3 = p;
+	return HullPredicates::orientation(PointBuffer(x, y, z, 4), 0, 1, 2, 3, &worker.statistics);
+}
 
-		// If the determinant is greater than zero, the point can "see" this
-		// face, so remove it.
-		if (determinant(p2, p1, p0, p3) > 0.0) {
-			// Add the face's associated points to our list of candidate
-			// points...
-			points.addAll((*i).getAssociatedPoints());
+/**
+ * The center is the average of the corners of the faces.  Each vertex has
+ * some weight in that average, so it is strictly inside the hull, but once
+ * rounded it may not be if the hull is very thin; in that case there is no
+ * center, and points are located some other way.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::recenter() {
+	double sum[3] = { 0.0, 0.0, 0.0 };
+	size_t count = 0;
 
-			// Get the new set of edges from the face to be removed.  If it
-			// has any edges in common with our current list of edges, they
-			// are removed because they were shared only by faces that were
-			// removed.
-			HullEdgeSet newEdges = (*i).getEdges();
-			HullEdgeSet commonEdges = setIntersection(edges, newEdges);
-			edges.addAll(newEdges);
-			edges.removeAll(commonEdges);
+	this->centered = false;
+	this->walkStart = NO_HULL_FACE;
 
-			// Marke the face for removal
-			facesToRemove.add(*i);
+	for (HullFaceIndex f = 0; f < this->hull.getCapacity(); f++) {
+		if (this->hull.isLive(f)) {
+			for (int i = 0; i < 3; i++) {
+				HullPointIndex q = this->hull.getFace(f).getPoint(i);
+				sum[0] += this->points.getX(q);
+				sum[1] += this->points.getY(q);
+				sum[2] += this->points.getZ(q);
+				count++;
+			}
 		}
 	}
 
-	this->hull.removeAll(facesToRemove);
+	if (count == 0) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		this->center[i] = (T) (sum[i] / count);
+	}
+
+	for (HullFaceIndex f = 0; f < this->hull.getCapacity(); f++) {
+		if (this->hull.isLive(f)) {
+			const Face &face = this->hull.getFace(f);
+
+			if (orientationWithCenter(face.getP0(), face.getP1(), face.getP2(), NO_HULL_POINT, this->workers[0]) >= 0) {
+				return;
+			}
+		}
+	}
 
-	// Add new faces to the hull to fill the hole we created and encompass
-	// the new point.
-	addFaces(p, edges, points);
+	this->centered = true;
 }
-	
+
 /**
- * Adds new faces to the hull between the given edges and the given point.
- * Tries associating each given point with one of the new faces.
- * 
- * \param p The point that all new faces will have in common
- * \param edges The edges to use in forming faces with point p
- * \param points The points to try associating with faces
+ * The points inside the hull are those that are neither vertices nor
+ * associated with a face.  If the hull is complete, they are filed right
+ * away; otherwise they wait until a point is removed.
  */
-void ConvexHullSolver::addFaces(HullPoint p, HullEdgeSet edges, HullPointSet points) {
-	// Make sure the point that the faces will have in common is not in the set
-	// of points to be associated with the faces.
-	points.remove(p);
+template <typename T>
+void BasicConvexHullSolver<T>::regroup() {
+	this->faceRegions.assign(this->hull.getCapacity(), HullPointIndexList());
+	this->pointRegions.assign(this->points.size(), NO_HULL_FACE);
+	this->unfiledPoints.clear();
 
-	// For each of the free edges, add a face.
-	for (HullEdgeSet::iterator i = edges.begin(); i != edges.end(); i++) {
-		HullPoint p0 = (*i).getP0();
-		HullPoint p1 = (*i).getP1();
-		HullPoint p2 = p;
-		HullFace face(p0, p1, p2);
-		HullPointSet leftoverPoints;
-	
-		// Try associating all of the "free" points with the new face.
-		for (HullPointSet::iterator j = points.begin(); j != points.end(); j++) {
-			// If the determinant is greater than zero, associate the point
-			// with the face.
-			if (determinant(p2, p1, p0, *j) > 0.0) {
-				face.associate(*j);
+	if (this->dimension < 3) {
+		return;
+	}
+
+	vector<char> vertices(this->points.size(), 0);
+
+	for (HullFaceIndex f = 0; f < this->hull.getCapacity(); f++) {
+		if (this->hull.isLive(f)) {
+			for (int i = 0; i < 3; i++) {
+				vertices[this->hull.getFace(f).getPoint(i)] = 1;
 			}
-			else {
-				leftoverPoints.add(*j);
+		}
+	}
+
+	for (HullPointIndex p = 0; p < this->points.size(); p++) {
+		if (!vertices[p] && !this->removedPoints[p] && this->pointFaces[p] == NO_HULL_FACE) {
+			this->unfiledPoints.push_back(p);
+		}
+	}
+
+	if (this->complete) {
+		fileInteriorPoints();
+	}
+}
+
+/**
+ * Points are only filed once the hull is complete, since until then the
+ * faces they would be filed under keep being replaced.  Without a center,
+ * the points go on waiting.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::fileInteriorPoints() {
+	if (!this->centered) {
+		return;
+	}
+
+	Worker &worker = this->workers[0];
+
+	for (HullPointIndexList::const_iterator i = this->unfiledPoints.begin(); i != this->unfiledPoints.end(); i++) {
+		if (!this->removedPoints[*i]) {
+			HullFaceIndex face = locate(*i, worker);
+
+			if (face != NO_HULL_FACE) {
+				file(*i, face);
 			}
 		}
+	}
 
-		points = leftoverPoints;
+	this->unfiledPoints.clear();
+}
 
-		this->hull.add(face);
+/**
+ * \param p The point
+ * \param face The face whose cone holds the point
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::file(HullPointIndex p, HullFaceIndex face) {
+	if (face >= this->faceRegions.size()) {
+		this->faceRegions.resize(this->hull.getCapacity());
 	}
 
-	// All unassociated candidate points must have been consumed by the hull.
+	this->faceRegions[face].push_back(p);
+	this->pointRegions[p] = face;
+}
+
+/**
+ * Removing a vertex v of the hull of a set of points P is adding it back
+ * in reverse: the faces around v are the faces of the hull of P - {v} that
+ * v can see, replaced by faces joining v to their horizon, which is the
+ * ring of edges around v.  So the faces to put back are the faces of the
+ * hull of P - {v} that v can see.  Every point that could be a corner of
+ * one is between the faces around v and the faces that replace them, and
+ * so is filed under one of the faces around v, since as long as the center
+ * is inside the new hull, their cones are the same as the new faces'
+ * cones.  The new faces are therefore the faces that v can see of the hull
+ * of the points filed under v's faces and the corners of the ring, found
+ * with a solver of their own.  If those points are coplanar, the new faces
+ * are instead a fan across the ring, which must then be convex, and must
+ * not leave the whole hull flat.
+ *
+ * The new faces must close up with the ring exactly, or they are not used.
+ * The points that were filed under v's faces, and haven't become vertices,
+ * are filed under the new faces.  If the center is no longer strictly
+ * inside the hull, a new one is picked and every point is filed again.
+ *
+ * \param v The vertex to remove
+ * \return Whether or not the vertex could be removed this way.  If not, the
+ *   hull is untouched.
+ */
+template <typename T>
+bool BasicConvexHullSolver<T>::removeVertex(HullPointIndex v) {
+	Worker &worker = this->workers[0];
+
+	// The cone that holds the vertex belongs to one of its faces.
+	HullFaceIndex start = locate(v, worker);
+
+	if (start == NO_HULL_FACE) {
+		return false;
+	}
+
+	// Go around the vertex, noting each face and its edge across from the
+	// vertex.  Those edges make the ring, counter-clockwise as seen from
+	// outside.
+	HullFaceIndexList star;
+	HorizonEdgeList ring;
+	HullFaceIndex face = start;
+
+	do {
+		const Face &f = this->hull.getFace(face);
+		int i = 0;
+
+		while (i < 3 && f.getPoint(i) != v) {
+			i++;
+		}
+
+		if (i == 3 || star.size() > this->hull.getNumFaces()) {
+			return false;
+		}
+
+		HorizonEdge edge;
+		edge.p0 = f.getPoint((i + 1) % 3);
+		edge.p1 = f.getPoint((i + 2) % 3);
+		edge.face = f.getNeighbor((i + 1) % 3);
+		edge.edge = this->hull.getFace(edge.face).findEdge(edge.p1, edge.p0);
+
+		star.push_back(face);
+		ring.push_back(edge);
+		face = f.getNeighbor((i + 2) % 3);
+	} while (face != start);
+
+	// The ring's corners come first, followed by the points under the faces.
+	HullPointIndexList candidates;
+
+	for (typename HorizonEdgeList::const_iterator i = ring.begin(); i != ring.end(); i++) {
+		candidates.push_back((*i).p0);
+	}
+
+	for (HullFaceIndexList::const_iterator i = star.begin(); i != star.end(); i++) {
+		if (*i < this->faceRegions.size()) {
+			const HullPointIndexList &region = this->faceRegions[*i];
+
+			for (HullPointIndexList::const_iterator j = region.begin(); j != region.end(); j++) {
+				if (!this->removedPoints[*j]) {
+					candidates.push_back(*j);
+				}
+			}
+		}
+	}
+
+	PointBuffer local;
+	local.reserve(candidates.size());
+
+	for (HullPointIndexList::const_iterator i = candidates.begin(); i != candidates.end(); i++) {
+		local.add(this->points.getX(*i), this->points.getY(*i), this->points.getZ(*i));
+	}
+
+	BasicConvexHullSolver solver(local);
+	solver.iterateToCompletion();
+	worker.statistics += solver.getStatistics();
+
+	// The new faces, three corners each
+	HullPointIndexList corners;
+
+	if (solver.getDimension() == 3) {
+		const Mesh &mesh = solver.getMesh();
+
+		for (HullFaceIndex f = 0; f < mesh.getCapacity(); f++) {
+			if (mesh.isLive(f)) {
+				HullPointIndex p0 = candidates[mesh.getFace(f).getP0()];
+				HullPointIndex p1 = candidates[mesh.getFace(f).getP1()];
+				HullPointIndex p2 = candidates[mesh.getFace(f).getP2()];
+
+				if (HullPredicates::orientation(this->points, p0, p1, p2, v, &worker.statistics) > 0) {
+					corners.push_back(p0);
+					corners.push_back(p1);
+					corners.push_back(p2);
+				}
+			}
+		}
+	} else if (solver.getDimension() == 2) {
+		for (size_t i = 0; i < ring.size(); i++) {
+			HullPointIndex p0 = ring[(i + ring.size() - 1) % ring.size()].p0;
+
+			if (HullPredicates::orientation(this->points, p0, ring[i].p0, ring[i].p1, v, &worker.statistics) <= 0) {
+				return false;
+			}
+		}
+
+		for (size_t i = 1; i + 1 < ring.size(); i++) {
+			corners.push_back(ring[0].p0);
+			corners.push_back(ring[i].p0);
+			corners.push_back(ring[i].p1);
+		}
+
+		// If the rest of the hull is in the same plane, the hull is flat.
+		bool flat = true;
+
+		for (HullFaceIndex f = 0; f < this->hull.getCapacity() && flat; f++) {
+			if (this->hull.isLive(f)) {
+				for (int i = 0; i < 3; i++) {
+					HullPointIndex q = this->hull.getFace(f).getPoint(i);
+
+					if (q != v && HullPredicates::orientation(this->points, ring[0].p0, ring[1].p0, ring[1].p1, q,
+						&worker.statistics) != 0) {
+
+						flat = false;
+					}
+				}
+			}
+		}
+
+		if (flat) {
+			return false;
+		}
+	}
+
+	// Match each edge of the new faces with the opposite edge of another,
+	// or with an edge of the ring.  Every edge of the ring must be used.
+	typedef std::map<std::pair<HullPointIndex, HullPointIndex>, size_t> EdgeMap;
+	EdgeMap edges;
+	EdgeMap ringEdges;
+	vector<size_t> twins(corners.size());
+	size_t numRingEdges = 0;
+
+	for (size_t i = 0; i < corners.size(); i++) {
+		edges[std::make_pair(corners[i], corners[i - i % 3 + (i + 1) % 3])] = i;
+	}
+
+	for (size_t i = 0; i < ring.size(); i++) {
+		ringEdges[std::make_pair(ring[i].p0, ring[i].p1)] = i;
+	}
+
+	for (size_t i = 0; i < corners.size(); i++) {
+		HullPointIndex a = corners[i];
+		HullPointIndex b = corners[i - i % 3 + (i + 1) % 3];
+		typename EdgeMap::const_iterator twin = edges.find(std::make_pair(b, a));
+
+		if (twin != edges.end()) {
+			twins[i] = (*twin).second;
+		} else {
+			typename EdgeMap::const_iterator edge = ringEdges.find(std::make_pair(a, b));
+
+			if (edge == ringEdges.end()) {
+				return false;
+			}
+
+			twins[i] = corners.size() + (*edge).second;
+			numRingEdges++;
+		}
+	}
+
+	if (corners.empty() || numRingEdges != ring.size()) {
+		return false;
+	}
+
+	// Swap the faces.
+	for (HullFaceIndexList::const_iterator i = star.begin(); i != star.end(); i++) {
+		if (*i < this->faceRegions.size()) {
+			this->faceRegions[*i].clear();
+		}
+
+		this->hull.removeFace(*i);
+	}
+
+	HullFaceIndexList newFaces;
+
+	for (size_t i = 0; i < corners.size(); i += 3) {
+		newFaces.push_back(this->hull.addFace(Face(corners[i], corners[i + 1], corners[i + 2],
+			this->points, this->magnitude)));
+	}
+
+	for (size_t i = 0; i < corners.size(); i++) {
+		if (twins[i] < corners.size()) {
+			this->hull.link(newFaces[i / 3], (int) (i % 3), newFaces[twins[i] / 3], (int) (twins[i] % 3));
+		} else {
+			const HorizonEdge &edge = ring[twins[i] - corners.size()];
+			this->hull.link(newFaces[i / 3], (int) (i % 3), edge.face, edge.edge);
+		}
+	}
+
+	// The points under the old faces that are not new vertices go under
+	// the new faces, if the center is still inside the hull.
+	std::sort(corners.begin(), corners.end());
+
+	for (HullPointIndexList::const_iterator i = candidates.begin() + ring.size(); i != candidates.end(); i++) {
+		this->pointRegions[*i] = NO_HULL_FACE;
+	}
+
+	for (HullFaceIndexList::const_iterator i = newFaces.begin(); i != newFaces.end(); i++) {
+		const Face &f = this->hull.getFace(*i);
+
+		if (orientationWithCenter(f.getP0(), f.getP1(), f.getP2(), NO_HULL_POINT, worker) >= 0) {
+			recenter();
+			regroup();
+			return true;
+		}
+	}
+
+	this->walkStart = newFaces[0];
+
+	for (HullPointIndexList::const_iterator i = candidates.begin() + ring.size(); i != candidates.end(); i++) {
+		if (!std::binary_search(corners.begin(), corners.end(), *i)) {
+			file(*i, locate(*i, worker));
+		}
+	}
+
+	return true;
+}
+
+/**
+ * The hull is found by a solver of its own, on a packed copy of the points
+ * that are left, and copied back face by face.  Every point is then filed
+ * afresh around a new center.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::rebuild() {
+	HullPointIndexList remaining;
+	PointBuffer packed;
+
+	for (HullPointIndex p = 0; p < this->points.size(); p++) {
+		if (!this->removedPoints[p]) {
+			remaining.push_back(p);
+			packed.add(this->points.getX(p), this->points.getY(p), this->points.getZ(p));
+		}
+	}
+
+	BasicConvexHullSolver solver(packed, this->scheduler.getPolicy(), this->filterDirections, getNumThreads());
+	solver.iterateToCompletion();
+	this->workers[0].statistics += solver.getStatistics();
+
+	this->hull.clear();
+	this->scheduler.clear();
+	this->insertionOrder.clear();
+	this->nextInsertion = 0;
+	this->deferredPoints.clear();
+	this->nextDeferred = 0;
+	this->pointFaces.assign(this->points.size(), NO_HULL_FACE);
+	this->magnitude = packed.getMagnitude();
+	this->dimension = solver.getDimension();
+	this->complete = true;
+
+	const Mesh &mesh = solver.getMesh();
+	HullFaceIndexList faceMap(mesh.getCapacity(), NO_HULL_FACE);
+
+	for (HullFaceIndex f = 0; f < mesh.getCapacity(); f++) {
+		if (mesh.isLive(f)) {
+			const Face &face = mesh.getFace(f);
+			faceMap[f] = this->hull.addFace(Face(remaining[face.getP0()], remaining[face.getP1()],
+				remaining[face.getP2()], this->points, this->magnitude));
+		}
+	}
+
+	for (HullFaceIndex f = 0; f < mesh.getCapacity(); f++) {
+		if (mesh.isLive(f)) {
+			for (int i = 0; i < 3; i++) {
+				this->hull.getFace(faceMap[f]).setNeighbor(i, faceMap[mesh.getFace(f).getNeighbor(i)]);
+			}
+		}
+	}
+
+	recenter();
+	regroup();
+}
+
+/**
+ * \param p The point
+ * \param face The face that the point can see
+ * \param distance The point's distance in front of the face
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::associate(HullPointIndex p, HullFaceIndex face, double distance) {
+	this->hull.getFace(face).associate(p, distance);
+	this->pointFaces[p] = face;
+}
+
+/**
+ * \param face The face
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::schedule(HullFaceIndex face) {
+	const Face &f = this->hull.getFace(face);
+
+	if (f.getNumAssociatedPoints() > 0 && !this->randomOrder) {
+		this->scheduler.schedule(face, f.getFurthestDistance());
+	}
+}
+
+/**
+ * Takes several points to add, in order, and finds, in parallel, the faces
+ * that each one can see.  Going down the list, each point is then added to
+ * the hull unless the faces it sees or borders overlap with those of a
+ * point already taken.  Points that are passed over are taken again first
+ * in a later round (their faces go back to the scheduler, or they go to the
+ * front of the random order).
+ *
+ * Two points that pass this test cannot see each other's new faces (a new
+ * face can only be seen from a point that sees the removed face or the
+ * horizon face on either side of its base), so adding them at once gives
+ * the same hull as adding them one after the other.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::iterateInParallel() {
+	HullPointIndexList candidatePoints;
+	HullFaceIndexList candidateFaces;
+	HullPointIndex point;
+	HullFaceIndex face;
+
+	while (candidatePoints.size() < CANDIDATES_PER_THREAD * getNumThreads()
+		&& determineNextPointToAdd(point, face)) {
+
+		candidatePoints.push_back(point);
+		candidateFaces.push_back(face);
+	}
+
+	// If there are no more points to add, then the hull is complete.
+	if (candidatePoints.empty()) {
+		this->complete = true;
+		return;
+	}
+
+	this->expansions.resize(candidatePoints.size());
+
+	for (size_t i = 0; i < candidatePoints.size(); i++) {
+		this->expansions[i].point = candidatePoints[i];
+		this->expansions[i].face = candidateFaces[i];
+	}
+
+	run(this->expansions.size(), &BasicConvexHullSolver::findVisibleFaces);
+
+	// Keep the expansions that don't interfere with any kept before them.
+	this->round++;
+	this->faceClaims.resize(this->hull.getCapacity(), 0);
+	this->faceClaimedVisible.resize(this->hull.getCapacity(), 0);
+	size_t numAccepted = 0;
+	HullPointIndexList passedOver;
+
+	for (size_t i = 0; i < this->expansions.size(); i++) {
+		if (isIndependent(this->expansions[i])) {
+			claim(this->expansions[i]);
+
+			if (i != numAccepted) {
+				std::swap(this->expansions[i], this->expansions[numAccepted]);
+			}
+
+			numAccepted++;
+		} else if (this->randomOrder) {
+			passedOver.push_back(this->expansions[i].point);
+		} else {
+			schedule(this->expansions[i].face);
+		}
+	}
+
+	this->expansions.resize(numAccepted);
+
+	// The points passed over come before any deferred points not yet taken,
+	// which came after them in the order.
+	if (this->randomOrder) {
+		passedOver.insert(passedOver.end(), this->deferredPoints.begin() + this->nextDeferred,
+			this->deferredPoints.end());
+		this->deferredPoints.swap(passedOver);
+		this->nextDeferred = 0;
+	}
+
+
+	// Changing the mesh is cheap next to classifying the orphans, so it is
+	// done on this thread alone.
+	for (typename ExpansionList::iterator i = this->expansions.begin(); i != this->expansions.end(); i++) {
+		replaceFaces(*i);
+	}
+
+	distributeOrphans();
+
+	for (typename ExpansionList::const_iterator i = this->expansions.begin(); i != this->expansions.end(); i++) {
+		for (HullFaceIndexList::const_iterator j = (*i).newFaces.begin(); j != (*i).newFaces.end(); j++) {
+			schedule(*j);
+		}
+	}
+}
+
+/**
+ * An expansion interferes with an earlier one if any face it would remove
+ * is one that the earlier one removes or borders, or if any face it borders
+ * is one that the earlier one removes.  Two expansions may share a horizon
+ * face, since each only re-links its own edge of that face.
+ *
+ * \param expansion The expansion
+ * \return Whether or not the expansion is free of interference
+ */
+template <typename T>
+bool BasicConvexHullSolver<T>::isIndependent(const Expansion &expansion) const {
+	for (HullFaceIndexList::const_iterator i = expansion.visibleFaces.begin(); i != expansion.visibleFaces.end(); i++) {
+		if (this->faceClaims[*i] == this->round) {
+			return false;
+		}
+	}
+
+	for (typename HorizonEdgeList::const_iterator i = expansion.horizon.begin(); i != expansion.horizon.end(); i++) {
+		if (this->faceClaims[(*i).face] == this->round && this->faceClaimedVisible[(*i).face]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \param expansion The expansion
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::claim(const Expansion &expansion) {
+	for (HullFaceIndexList::const_iterator i = expansion.visibleFaces.begin(); i != expansion.visibleFaces.end(); i++) {
+		this->faceClaims[*i] = this->round;
+		this->faceClaimedVisible[*i] = 1;
+	}
+
+	for (typename HorizonEdgeList::const_iterator i = expansion.horizon.begin(); i != expansion.horizon.end(); i++) {
+		if (this->faceClaims[(*i).face] != this->round) {
+			this->faceClaims[(*i).face] = this->round;
+			this->faceClaimedVisible[(*i).face] = 0;
+		}
+	}
+}
+
+/**
+ * Starting from the face that the point is associated with, walks across
+ * edges into neighboring faces for as long as they are visible too.
+ * Because the visible region is connected, this touches only the visible
+ * faces and the ring of faces around them, rather than the whole hull.
+ *
+ * The walk is depth-first and always leaves a face through the edge after
+ * the one it entered by, so the horizon edges come out in order around the
+ * hole, each one starting where the previous one ended.
+ *
+ * The hull is only read, so several of these may run at once, each on its
+ * own thread.
+ *
+ * \param expansion The expansion whose point and face to start from
+ * \param thread The thread doing the work
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::findVisibleFaces(size_t expansion, unsigned int thread) {
+	Expansion &e = this->expansions[expansion];
+	Worker &worker = this->workers[thread];
+	HullPointIndex p = e.point;
+
+	// Forget the visibility tests made for the previous point.
+	worker.search++;
+	worker.faceVisits.resize(this->hull.getCapacity(), 0);
+	worker.faceVisible.resize(this->hull.getCapacity(), 0);
+
+	// The point was associated with its face because it is strictly in
+	// front of it, so that face is visible.
+	worker.faceVisits[e.face] = worker.search;
+	worker.faceVisible[e.face] = 1;
+
+	e.visibleFaces.clear();
+	e.horizon.clear();
+	e.visibleFaces.push_back(e.face);
+
+	VisitList stack;
+	Visit start = { e.face, 0, 3 };
+	stack.push_back(start);
+
+	while (!stack.empty()) {
+		Visit &top = stack.back();
+
+		if (top.remaining == 0) {
+			stack.pop_back();
+			continue;
+		}
+
+		const Face &current = this->hull.getFace(top.face);
+		int edge = top.edge;
+		top.edge = (top.edge + 1) % 3;
+		top.remaining--;
+
+		HullPointIndex a = current.getPoint(edge);
+		HullPointIndex b = current.getPoint((edge + 1) % 3);
+		HullFaceIndex neighbor = current.getNeighbor(edge);
+		int neighborEdge = this->hull.getFace(neighbor).findEdge(b, a);
+
+		if (worker.faceVisits[neighbor] == worker.search && worker.faceVisible[neighbor]) {
+			continue;
+		}
+
+		if (canSee(p, neighbor, worker)) {
+			e.visibleFaces.push_back(neighbor);
+
+			// Note that pushing may invalidate "top".
+			Visit next = { neighbor, (neighborEdge + 1) % 3, 2 };
+			stack.push_back(next);
+		}
+		else {
+			HorizonEdge horizonEdge = { a, b, neighbor, neighborEdge };
+			e.horizon.push_back(horizonEdge);
+		}
+	}
+}
+
+/**
+ * The distance comes from the face's plane.  Only when it is too close to
+ * zero for its sign to be trusted is the orientation recomputed from the
+ * face's points.
+ *
+ * \param face The face
+ * \param p The point
+ * \param worker The worker whose counters to update
+ * \return The distance of the point in front of the face (negative if it is
+ *   behind, zero if it is in the face's plane)
+ */
+template <typename T>
+double BasicConvexHullSolver<T>::distanceTo(const Face &face, HullPointIndex p, Worker &worker) {
+	worker.statistics.planeTests++;
+
+	double d = face.distance(this->points, p);
+
+	if (fabs(d) > face.getErrorBound()) {
+		return d;
+	}
+
+	return resolveDistance(face, p, d, worker);
+}
+
+/**
+ * The sign is taken from the exact orientation of the point with respect to
+ * the face's corners, so every test of a point against a face agrees on
+ * which side it is on, no matter how close to the plane it is.
+ *
+ * \param face The face
+ * \param p The point
+ * \param d The distance computed from the face's plane
+ * \param worker The worker whose counters to update
+ * \return The distance with its sign corrected: positive if the point is in
+ *   front of the face, negative if it is behind, and zero only if it is
+ *   exactly in the face's plane
+ */
+template <typename T>
+double BasicConvexHullSolver<T>::resolveDistance(const Face &face, HullPointIndex p, double d, Worker &worker) {
+	int o = HullPredicates::orientation(this->points, face.getP0(), face.getP1(), face.getP2(), p,
+		&worker.statistics);
+
+	if (o == 0) {
+		return 0.0;
+	}
+
+	// Keep the (tiny) magnitude from the plane, but take the sign from the
+	// orientation.
+	double m = (fabs(d) > DBL_MIN) ? fabs(d) : DBL_MIN;
+	return (o > 0) ? m : -m;
+}
+
+/**
+ * The result is cached for the current search, since faces around the
+ * horizon are reached once for each edge they share with the visible region.
+ *
+ * \param p The point
+ * \param face The face
+ * \param worker The worker doing the search
+ * \return Whether or not the point is strictly in front of the face
+ */
+template <typename T>
+bool BasicConvexHullSolver<T>::canSee(HullPointIndex p, HullFaceIndex face, Worker &worker) {
+	if (worker.faceVisits[face] == worker.search) {
+		return worker.faceVisible[face] != 0;
+	}
+
+	bool visible = distanceTo(this->hull.getFace(face), p, worker) > 0.0;
+
+	worker.faceVisits[face] = worker.search;
+	worker.faceVisible[face] = visible ? 1 : 0;
+
+	return visible;
+}
+
+/**
+ * Releases the points that were associated with the visible faces, removes
+ * those faces from the hull, and fills the hole with new faces between the
+ * horizon edges and the point.  Only the removed faces' own lists are
+ * walked; the rest of the conflict graph is untouched.
+ *
+ * \param expansion The expansion, with its visible faces and horizon found
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::replaceFaces(Expansion &expansion) {
+	HullPointIndex p = expansion.point;
+
+	// The point is leaving the conflict graph.
+	this->pointFaces[p] = NO_HULL_FACE;
+	expansion.orphans.clear();
+	HullPointIndexList swallowed;
+
+	for (HullFaceIndexList::const_iterator i = expansion.visibleFaces.begin(); i != expansion.visibleFaces.end(); i++) {
+		const HullPointIndexList &released = this->hull.getFace(*i).getAssociatedPoints();
+
+		for (HullPointIndexList::const_iterator j = released.begin(); j != released.end(); j++) {
+			if (*j != p) {
+				this->pointFaces[*j] = NO_HULL_FACE;
+				expansion.orphans.push_back(*j);
+			}
+		}
+
+		// In dynamic mode, the points filed under the face must be filed
+		// again, and so must the face's corners if they end up inside.
+		if (this->dynamic) {
+			if (*i < this->faceRegions.size()) {
+				HullPointIndexList &region = this->faceRegions[*i];
+
+				for (HullPointIndexList::const_iterator j = region.begin(); j != region.end(); j++) {
+					if (!this->removedPoints[*j]) {
+						this->pointRegions[*j] = NO_HULL_FACE;
+						this->unfiledPoints.push_back(*j);
+					}
+				}
+
+				region.clear();
+			}
+
+			for (int j = 0; j < 3; j++) {
+				swallowed.push_back(this->hull.getFace(*i).getPoint(j));
+			}
+		}
+
+		this->scheduler.unschedule(*i);
+		this->hull.removeFace(*i);
+	}
+
+	// The corners that are not on the horizon are now inside the hull.
+	if (this->dynamic) {
+		HullPointIndexList horizon;
+
+		for (typename HorizonEdgeList::const_iterator i = expansion.horizon.begin(); i != expansion.horizon.end(); i++) {
+			horizon.push_back((*i).p0);
+		}
+
+		std::sort(horizon.begin(), horizon.end());
+		std::sort(swallowed.begin(), swallowed.end());
+		swallowed.erase(std::unique(swallowed.begin(), swallowed.end()), swallowed.end());
+
+		for (HullPointIndexList::const_iterator i = swallowed.begin(); i != swallowed.end(); i++) {
+			if (!std::binary_search(horizon.begin(), horizon.end(), *i)) {
+				this->unfiledPoints.push_back(*i);
+			}
+		}
+	}
+
+	// For each of the horizon edges, add a face.
+	expansion.newFaces.clear();
+
+	for (typename HorizonEdgeList::const_iterator i = expansion.horizon.begin(); i != expansion.horizon.end(); i++) {
+		HullPointIndex p0 = (*i).p0;
+		HullPointIndex p1 = (*i).p1;
+		HullPointIndex p2 = p;
+
+		// Edge 0 of the new face is the horizon edge, so the new face takes
+		// the place of the removed face as the neighbor across it.
+		HullFaceIndex newFace = this->hull.addFace(Face(p0, p1, p2, this->points, this->magnitude));
+		this->hull.link(newFace, 0, (*i).face, (*i).edge);
+		expansion.newFaces.push_back(newFace);
+	}
+
+	// The horizon is a closed loop, so each new face shares its second edge
+	// with the next new face's third edge.
+	for (size_t i = 0; i < expansion.newFaces.size(); i++) {
+		this->hull.link(expansion.newFaces[i], 1, expansion.newFaces[(i + 1) % expansion.newFaces.size()], 2);
+	}
+}
+
+/**
+ * Each expansion's orphans are cut into blocks, and the blocks of all the
+ * expansions are classified as separate tasks, so that one expansion with
+ * many orphans is still spread across the threads.  Each orphan goes to the
+ * first of its expansion's new faces that it is in front of.  Orphans that
+ * are in front of none are inside the hull, and are dropped.
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::distributeOrphans() {
+	this->chunks.clear();
+
+	for (size_t i = 0; i < this->expansions.size(); i++) {
+		Expansion &e = this->expansions[i];
+		e.orphanFaces.resize(e.orphans.size());
+		e.orphanDistances.resize(e.orphans.size());
+
+		for (size_t begin = 0; begin < e.orphans.size(); begin += BLOCK_SIZE) {
+			Chunk chunk = { i, begin };
+			this->chunks.push_back(chunk);
+		}
+	}
+
+	run(this->chunks.size(), &BasicConvexHullSolver::classifyChunk);
+
+	// In dynamic mode, the orphans that are inside the hull wait to be
+	// filed.
+	if (this->dynamic) {
+		for (typename ExpansionList::const_iterator i = this->expansions.begin(); i != this->expansions.end(); i++) {
+			for (size_t j = 0; j < (*i).orphans.size(); j++) {
+				if ((*i).orphanFaces[j] == NO_HULL_FACE) {
+					this->unfiledPoints.push_back((*i).orphans[j]);
+				}
+			}
+		}
+	}
+
+	run(this->expansions.size(), &BasicConvexHullSolver::associateOrphans);
+}
+
+/**
+ * Each face classifies the block's remaining points at once, and the
+ * points that it takes are swapped out, so that the next face only looks
+ * at the ones left over.  Nothing but the expansion's own record of where
+ * each orphan goes is written, so blocks can be classified in parallel.
+ *
+ * \param chunk The block to classify
+ * \param thread The thread doing the work
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::classifyChunk(size_t chunk, unsigned int thread) {
+	Expansion &e = this->expansions[this->chunks[chunk].expansion];
+	Worker &worker = this->workers[thread];
+	size_t begin = this->chunks[chunk].begin;
+	size_t count = e.orphans.size() - begin;
+	count = (count < BLOCK_SIZE) ? count : BLOCK_SIZE;
+
+	for (size_t j = 0; j < count; j++) {
+		worker.blockPoints[j] = e.orphans[begin + j];
+		worker.blockSlots[j] = begin + j;
+		e.orphanFaces[begin + j] = NO_HULL_FACE;
+	}
+
+	for (HullFaceIndexList::const_iterator i = e.newFaces.begin(); i != e.newFaces.end() && count > 0; i++) {
+		const Face &f = this->hull.getFace(*i);
+		size_t numLeftover = 0;
+
+		worker.statistics.planeTests += count;
+		PointClassifier::classifyIndexed(f.getPlane(), f.getErrorBound(),
+			this->points.getXArray(), this->points.getYArray(), this->points.getZArray(), this->points.getStride(),
+			&worker.blockPoints[0], count, &worker.blockDistances[0], &worker.blockMask[0]);
+
+		for (size_t j = 0; j < count; j++) {
+			HullPointIndex q = worker.blockPoints[j];
+			size_t slot = worker.blockSlots[j];
+
+			// If the point is in front of the face, it goes to the face.
+			// Points the classifier didn't flag are certainly behind it.
+			if (worker.blockMask[j]) {
+				double d = worker.blockDistances[j];
+
+				if (d <= f.getErrorBound()) {
+					d = resolveDistance(f, q, d, worker);
+				}
+
+				if (d > 0.0) {
+					e.orphanFaces[slot] = *i;
+					e.orphanDistances[slot] = d;
+					continue;
+				}
+			}
+
+			worker.blockPoints[numLeftover] = q;
+			worker.blockSlots[numLeftover] = slot;
+			numLeftover++;
+		}
+
+		count = numLeftover;
+	}
+}
+
+/**
+ * \param expansion The expansion whose orphans have been classified
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::associateOrphans(size_t expansion, unsigned int /*thread*/) {
+	Expansion &e = this->expansions[expansion];
+
+	for (size_t j = 0; j < e.orphans.size(); j++) {
+		if (e.orphanFaces[j] != NO_HULL_FACE) {
+			associate(e.orphans[j], e.orphanFaces[j], e.orphanDistances[j]);
+		}
+	}
+
+	e.orphans.clear();
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+template <typename T>
+void BasicConvexHullSolver<T>::run(size_t numTasks, void (BasicConvexHullSolver::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
 
-}
\ No newline at end of file
+template class BasicConvexHullSolver<double>;
+template class BasicConvexHullSolver<float>;
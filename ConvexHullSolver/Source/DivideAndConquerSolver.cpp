@@ -0,0 +1,1064 @@
+/**
+ * \file DivideAndConquerSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the DivideAndConquerSolver class
+ */
+
+#include "DivideAndConquerSolver.h"
+#include "ConvexHullSolver.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace peek;
+
+const unsigned int DivideAndConquerSolver::DEFAULT_LEAF_SIZE;
+
+namespace {
+
+	/** The smallest number of points in a run */
+	const unsigned int MIN_LEAF_SIZE = 4;
+
+	/** Below this many points per thread, sorting isn't worth splitting up */
+	const size_t MIN_POINTS_PER_STRETCH = 65536;
+
+	/** What a merge does with a face of one of the hulls */
+	enum FaceMark {
+		UNTOUCHED,
+		KEPT,
+		HIDDEN
+	};
+
+	/** Which candidates compareCandidates is choosing between */
+	enum Pivot {
+		/** Two neighbors of the band's left vertex */
+		PIVOT_LEFT,
+
+		/** Two neighbors of the band's right vertex */
+		PIVOT_RIGHT,
+
+		/** The best neighbor of the left vertex and that of the right vertex */
+		PIVOT_BOTH
+	};
+
+	/** Orders points by x, then y, then z, then by index */
+	struct LexicographicOrder {
+		const HullPointBuffer *points;
+
+		bool operator()(HullPointIndex i, HullPointIndex j) const {
+			if (this->points->getX(i) != this->points->getX(j)) {
+				return this->points->getX(i) < this->points->getX(j);
+			}
+
+			if (this->points->getY(i) != this->points->getY(j)) {
+				return this->points->getY(i) < this->points->getY(j);
+			}
+
+			if (this->points->getZ(i) != this->points->getZ(j)) {
+				return this->points->getZ(i) < this->points->getZ(j);
+			}
+
+			return i < j;
+		}
+	};
+
+	/**
+	 * Finds a coordinate plane onto which a triangle projects without
+	 * collapsing, preferring the one it is most nearly parallel to
+	 *
+	 * \param axis Receives the coordinate to drop
+	 * \param sign Receives 1 if the triangle is counter-clockwise in the
+	 *   projection, -1 if it is clockwise
+	 * \return false if the triangle's corners are collinear
+	 */
+	bool findProjection(const HullPointBuffer &points, HullPointIndex p0, HullPointIndex p1, HullPointIndex p2,
+		int &axis, int &sign, HullPredicateStatistics *statistics) {
+
+		double ux = points.getX(p1) - points.getX(p0);
+		double uy = points.getY(p1) - points.getY(p0);
+		double uz = points.getZ(p1) - points.getZ(p0);
+		double vx = points.getX(p2) - points.getX(p0);
+		double vy = points.getY(p2) - points.getY(p0);
+		double vz = points.getZ(p2) - points.getZ(p0);
+		double n[3] = { fabs(uy * vz - uz * vy), fabs(uz * vx - ux * vz), fabs(ux * vy - uy * vx) };
+
+		int axes[3] = { 0, 1, 2 };
+
+		if (n[axes[1]] > n[axes[0]]) std::swap(axes[0], axes[1]);
+		if (n[axes[2]] > n[axes[0]]) std::swap(axes[0], axes[2]);
+		if (n[axes[2]] > n[axes[1]]) std::swap(axes[1], axes[2]);
+
+		for (int i = 0; i < 3; i++) {
+			sign = HullPredicates::orientation2d(points, p0, p1, p2, axes[i], statistics);
+
+			if (sign != 0) {
+				axis = axes[i];
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/** Gets whether p is nearer to the origin point o than q is */
+	bool isNearer(const HullPointBuffer &points, HullPointIndex o, HullPointIndex p, HullPointIndex q) {
+		double px = points.getX(p) - points.getX(o);
+		double py = points.getY(p) - points.getY(o);
+		double pz = points.getZ(p) - points.getZ(o);
+		double qx = points.getX(q) - points.getX(o);
+		double qy = points.getY(q) - points.getY(o);
+		double qz = points.getZ(q) - points.getZ(o);
+
+		return px * px + py * py + pz * pz < qx * qx + qy * qy + qz * qz;
+	}
+
+	/** Gets whether a hull has neither faces nor points */
+	template <class Part>
+	bool isEmpty(const Part &part) {
+		return part.mesh.getNumFaces() == 0 && part.points.empty();
+	}
+
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find
+ * \param leafSize The largest number of points whose hull is found directly
+ *   (at least 4)
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+DivideAndConquerSolver::DivideAndConquerSolver(const Point3dSet &inputPoints, unsigned int leafSize,
+	unsigned int numThreads) : points(inputPoints), leafSize(leafSize) {
+
+	setNumThreads(numThreads);
+	initialize();
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find.  If the buffer
+ *   refers to arrays owned by the caller, the arrays must outlive the solver.
+ * \param leafSize The largest number of points whose hull is found directly
+ *   (at least 4)
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+DivideAndConquerSolver::DivideAndConquerSolver(const HullPointBuffer &inputPoints, unsigned int leafSize,
+	unsigned int numThreads) : points(inputPoints), leafSize(leafSize) {
+
+	setNumThreads(numThreads);
+	initialize();
+}
+
+DivideAndConquerSolver::~DivideAndConquerSolver() {
+	for (PartList::iterator i = this->parts.begin(); i != this->parts.end(); i++) {
+		delete *i;
+	}
+}
+
+/**
+ * Every run boundary falls between points that differ in x or y, so the
+ * shadows of neighboring runs on the xy-plane never overlap.
+ */
+void DivideAndConquerSolver::initialize() {
+	this->complete = false;
+	this->dimension = 0;
+	this->leafSize = (this->leafSize > MIN_LEAF_SIZE) ? this->leafSize : MIN_LEAF_SIZE;
+
+	sortOrder();
+
+	size_t n = this->points.size();
+
+	for (size_t i = 0; i < n; i++) {
+		this->sorted.add(this->points.getX(this->order[i]), this->points.getY(this->order[i]),
+			this->points.getZ(this->order[i]));
+	}
+
+	this->vertexFaces.assign(n, NO_HULL_FACE);
+
+	// Cut the points into a power of two runs, so that every level pairs up.
+	size_t numLeaves = 1;
+
+	while (n > numLeaves * this->leafSize) {
+		numLeaves *= 2;
+	}
+
+	this->bounds.resize(numLeaves + 1);
+	this->bounds[0] = 0;
+	this->bounds[numLeaves] = (HullPointIndex) n;
+
+	for (size_t k = 1; k < numLeaves; k++) {
+		HullPointIndex i = (HullPointIndex) (n * k / numLeaves);
+		i = (i > this->bounds[k - 1]) ? i : this->bounds[k - 1];
+
+		while (i > 0 && i < n && this->sorted.getX(i) == this->sorted.getX(i - 1)
+			&& this->sorted.getY(i) == this->sorted.getY(i - 1)) {
+
+			i++;
+		}
+
+		this->bounds[k] = i;
+	}
+}
+
+/**
+ * The points are sorted in one stretch per thread, and the stretches are
+ * then merged in pairs until one is left.  The stretch boundaries are kept
+ * in bounds until the runs replace them.
+ */
+void DivideAndConquerSolver::sortOrder() {
+	size_t n = this->points.size();
+	this->order.resize(n);
+
+	for (size_t i = 0; i < n; i++) {
+		this->order[i] = (HullPointIndex) i;
+	}
+
+	size_t numStretches = n / MIN_POINTS_PER_STRETCH;
+	numStretches = (numStretches < getNumThreads()) ? numStretches : getNumThreads();
+	numStretches = (numStretches > 0) ? numStretches : 1;
+
+	this->bounds.resize(numStretches + 1);
+
+	for (size_t i = 0; i <= numStretches; i++) {
+		this->bounds[i] = (HullPointIndex) (n * i / numStretches);
+	}
+
+	run(numStretches, &DivideAndConquerSolver::sortStretch);
+
+	while (numStretches > 1) {
+		run(numStretches / 2, &DivideAndConquerSolver::mergeStretches);
+
+		vector<HullPointIndex> merged;
+
+		for (size_t i = 0; i < numStretches; i += 2) {
+			merged.push_back(this->bounds[i]);
+		}
+
+		merged.push_back(this->bounds[numStretches]);
+		this->bounds.swap(merged);
+		numStretches = this->bounds.size() - 1;
+	}
+}
+
+/**
+ * \param stretch The stretch to sort
+ */
+void DivideAndConquerSolver::sortStretch(size_t stretch, unsigned int /*thread*/) {
+	LexicographicOrder lexicographic = { &this->points };
+	std::sort(this->order.begin() + this->bounds[stretch], this->order.begin() + this->bounds[stretch + 1],
+		lexicographic);
+}
+
+/**
+ * \param pair The pair of stretches to merge
+ */
+void DivideAndConquerSolver::mergeStretches(size_t pair, unsigned int /*thread*/) {
+	LexicographicOrder lexicographic = { &this->points };
+	std::inplace_merge(this->order.begin() + this->bounds[2 * pair], this->order.begin() + this->bounds[2 * pair + 1],
+		this->order.begin() + this->bounds[2 * pair + 2], lexicographic);
+}
+
+/**
+ * The first call finds the hull of every run; each later call merges the
+ * hulls in pairs.
+ */
+void DivideAndConquerSolver::iterate() {
+	if (isComplete()) {
+		return;
+	}
+
+	if (this->parts.empty()) {
+		this->parts.assign(this->bounds.size() - 1, NULL);
+		run(this->parts.size(), &DivideAndConquerSolver::solveLeaf);
+	} else {
+		run(this->parts.size() / 2, &DivideAndConquerSolver::mergePair);
+
+		for (size_t i = 0; i < this->parts.size() / 2; i++) {
+			this->parts[i] = this->parts[2 * i];
+		}
+
+		this->parts.resize(this->parts.size() / 2);
+	}
+
+	if (this->parts.size() == 1) {
+		this->dimension = this->parts[0]->dimension;
+		this->complete = true;
+	}
+}
+
+void DivideAndConquerSolver::iterateToCompletion() {
+	while (!isComplete()) {
+		iterate();
+	}
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+void DivideAndConquerSolver::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	this->workers.resize(numThreads);
+	this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+}
+
+/**
+ * \return The faces, whose points are indices into getPoints()
+ */
+HullFaceList DivideAndConquerSolver::getHull() const {
+	HullFaceList result;
+
+	for (PartList::const_iterator i = this->parts.begin(); i != this->parts.end(); i++) {
+		const HullMesh &mesh = (*i)->mesh;
+
+		for (HullFaceIndex j = 0; j < mesh.getCapacity(); j++) {
+			if (mesh.isLive(j)) {
+				const HullFace &face = mesh.getFace(j);
+				result.push_back(HullFace(this->order[face.getP0()], this->order[face.getP1()],
+					this->order[face.getP2()]));
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over all threads
+ */
+HullPredicateStatistics DivideAndConquerSolver::getStatistics() const {
+	HullPredicateStatistics statistics;
+
+	for (WorkerList::const_iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		statistics += (*i).statistics;
+	}
+
+	return statistics;
+}
+
+/**
+ * \return The number of merges whose band failed its check
+ */
+size_t DivideAndConquerSolver::getNumFallbacks() const {
+	size_t numFallbacks = 0;
+
+	for (WorkerList::const_iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		numFallbacks += (*i).numFallbacks;
+	}
+
+	return numFallbacks;
+}
+
+/**
+ * The run's coordinates are handed to ConvexHullSolver in place, without
+ * being copied.
+ *
+ * \param leaf The run to solve
+ * \param thread The thread doing the work
+ */
+void DivideAndConquerSolver::solveLeaf(size_t leaf, unsigned int thread) {
+	Worker &worker = this->workers[thread];
+	Part *part = new Part();
+	HullPointIndex begin = this->bounds[leaf];
+	HullPointIndex end = this->bounds[leaf + 1];
+
+	part->dimension = 0;
+	part->first = NO_HULL_POINT;
+	part->last = NO_HULL_POINT;
+	this->parts[leaf] = part;
+
+	if (begin == end) {
+		return;
+	}
+
+	HullPointBuffer run(this->sorted.getXArray() + begin, this->sorted.getYArray() + begin,
+		this->sorted.getZArray() + begin, end - begin);
+	ConvexHullSolver solver(run, HullFaceScheduler::FURTHEST_FIRST, 0, 1);
+	solver.iterateToCompletion();
+
+	worker.statistics += solver.getStatistics();
+	part->dimension = solver.getDimension();
+
+	if (part->dimension < 3) {
+		for (HullPointIndex i = begin; i < end; i++) {
+			part->points.push_back(i);
+		}
+	} else {
+		HullPointIndexList pointMap(end - begin);
+
+		for (HullPointIndex i = begin; i < end; i++) {
+			pointMap[i - begin] = i;
+		}
+
+		copyFaces(solver.getMesh(), &pointMap[0], NULL, part->mesh, worker);
+	}
+
+	findVertices(*part, worker.vertices);
+	part->first = worker.vertices.front();
+	part->last = worker.vertices.back();
+}
+
+/**
+ * The merged hull takes the place of the left one, and the right one is
+ * deleted.
+ *
+ * \param pair The pair of hulls to merge
+ * \param thread The thread doing the work
+ */
+void DivideAndConquerSolver::mergePair(size_t pair, unsigned int thread) {
+	Worker &worker = this->workers[thread];
+	Part *&left = this->parts[2 * pair];
+	Part *&right = this->parts[2 * pair + 1];
+
+	if (isEmpty(*left)) {
+		std::swap(left, right);
+	} else if (!isEmpty(*right)) {
+		if (left->dimension < 3 || right->dimension < 3) {
+			solveVertices(*left, *right, worker);
+		} else if (!wrap(*left, *right, worker)) {
+			worker.numFallbacks++;
+			solveVertices(*left, *right, worker);
+		}
+	}
+
+	delete right;
+	right = NULL;
+}
+
+/**
+ * Nothing is changed unless the band wraps all the way around and passes
+ * every check, so that a failed merge can be redone from the original hulls.
+ *
+ * \param left The hull of the lower run, which receives the merged hull
+ * \param right The hull of the upper run
+ * \param worker The worker doing the merge
+ * \return Whether or not the merge succeeded
+ */
+bool DivideAndConquerSolver::wrap(Part &left, Part &right, Worker &worker) {
+	HullPointIndex a, b;
+
+	if (!findTangent(left, right, a, b, worker)) {
+		return false;
+	}
+
+	// Wrap the band, a face at a time.  Each face pivots on the edge from a
+	// to b, and takes its third corner from the neighbors of a or of b; that
+	// corner then replaces a or b.
+	BandFaceList &band = worker.band;
+	band.clear();
+
+	HullPointIndex a0 = a, b0 = b, previous = NO_HULL_POINT;
+	size_t limit = left.mesh.getNumFaces() + right.mesh.getNumFaces() + 8;
+	bool leftStale = true, rightStale = true;
+
+	do {
+		if (band.size() > limit) {
+			return false;
+		}
+
+		if (leftStale && !findNeighbors(left.mesh, a, worker.leftCandidates)) {
+			return false;
+		}
+
+		if (rightStale && !findNeighbors(right.mesh, b, worker.rightCandidates)) {
+			return false;
+		}
+
+		leftStale = rightStale = false;
+
+		const Candidate *l = pickCandidate(a, b, previous, worker.leftCandidates, true, worker);
+		const Candidate *r = pickCandidate(a, b, previous, worker.rightCandidates, false, worker);
+
+		if (l == NULL && r == NULL) {
+			return false;
+		}
+
+		BandFace face;
+		face.a = a;
+		face.b = b;
+		face.left = (r == NULL)
+			|| (l != NULL && compareCandidates(a, b, previous, l->point, r->point, PIVOT_BOTH, worker) <= 0);
+
+		if (face.left) {
+			face.c = l->point;
+			face.kept = l->face;
+			face.keptEdge = l->edge;
+			face.hidden = left.mesh.getFace(face.kept).getNeighbor(face.keptEdge);
+			face.hiddenEdge = left.mesh.getFace(face.hidden).findEdge(face.c, a);
+			previous = a;
+			a = face.c;
+			leftStale = true;
+		} else {
+			face.c = r->point;
+			face.hidden = r->face;
+			face.hiddenEdge = r->edge;
+			face.kept = right.mesh.getFace(face.hidden).getNeighbor(face.hiddenEdge);
+			face.keptEdge = right.mesh.getFace(face.kept).findEdge(face.c, b);
+			previous = b;
+			b = face.c;
+			rightStale = true;
+		}
+
+		if (face.keptEdge < 0 || face.hiddenEdge < 0) {
+			return false;
+		}
+
+		band.push_back(face);
+	} while (a != a0 || b != b0);
+
+	if (!findTwins(true, worker) || !findTwins(false, worker)) {
+		return false;
+	}
+
+	// Each band face must be convex across its edges to the next band face
+	// and to the hull it is glued to.  Only coplanar points can break this.
+	for (size_t i = 0; i < band.size(); i++) {
+		const BandFace &face = band[i];
+		const BandFace &next = band[(i + 1) % band.size()];
+		HullPointIndex opposite;
+
+		if (face.twin >= 0) {
+			opposite = face.left ? band[face.twin].b : band[face.twin].a;
+		} else {
+			const HullMesh &mesh = face.left ? left.mesh : right.mesh;
+			opposite = mesh.getFace(face.kept).getPoint((face.keptEdge + 2) % 3);
+		}
+
+		if (!isConvexEdge(face.a, face.b, face.c, face.left ? 1 : 2, next.c, worker)
+			|| !isConvexEdge(face.a, face.b, face.c, face.left ? 2 : 1, opposite, worker)) {
+
+			return false;
+		}
+	}
+
+	if (!markHidden(left.mesh, true, worker) || !markHidden(right.mesh, false, worker)) {
+		return false;
+	}
+
+	// Everything checks out, so replace the hidden faces with the band.
+	for (HullFaceIndex i = 0; i < left.mesh.getCapacity(); i++) {
+		if (left.mesh.isLive(i) && worker.leftMarks[i] == HIDDEN) {
+			left.mesh.removeFace(i);
+		}
+	}
+
+	copyFaces(right.mesh, NULL, &worker.rightMarks, left.mesh, worker);
+
+	HullFaceIndexList bandFaces(band.size());
+
+	for (size_t i = 0; i < band.size(); i++) {
+		bandFaces[i] = left.mesh.addFace(HullFace(band[i].a, band[i].b, band[i].c));
+	}
+
+	for (size_t i = 0; i < band.size(); i++) {
+		const BandFace &face = band[i];
+		left.mesh.link(bandFaces[i], face.left ? 1 : 2, bandFaces[(i + 1) % band.size()], 0);
+
+		if (face.twin >= 0) {
+			left.mesh.link(bandFaces[i], face.left ? 2 : 1, bandFaces[face.twin], face.left ? 2 : 1);
+		} else {
+			HullFaceIndex kept = face.left ? face.kept : worker.faceMap[face.kept];
+			left.mesh.link(bandFaces[i], face.left ? 2 : 1, kept, face.keptEdge);
+		}
+
+		this->vertexFaces[face.a] = bandFaces[i];
+		this->vertexFaces[face.b] = bandFaces[i];
+		this->vertexFaces[face.c] = bandFaces[i];
+	}
+
+	left.last = right.last;
+	return true;
+}
+
+/**
+ * Every vertex of the merged hull is a vertex of one of the two hulls (or,
+ * for a flat hull, one of its points), so the rest of the points can be
+ * left out.
+ *
+ * \param left The hull of the lower run, which receives the merged hull
+ * \param right The hull of the upper run
+ * \param worker The worker doing the merge
+ */
+void DivideAndConquerSolver::solveVertices(Part &left, Part &right, Worker &worker) {
+	HullPointIndexList vertices;
+	findVertices(left, vertices);
+	findVertices(right, worker.vertices);
+	vertices.insert(vertices.end(), worker.vertices.begin(), worker.vertices.end());
+
+	HullPointBuffer buffer;
+
+	for (HullPointIndexList::const_iterator i = vertices.begin(); i != vertices.end(); i++) {
+		buffer.add(this->sorted.getX(*i), this->sorted.getY(*i), this->sorted.getZ(*i));
+	}
+
+	ConvexHullSolver solver(buffer, HullFaceScheduler::FURTHEST_FIRST, 0, 1);
+	solver.iterateToCompletion();
+
+	worker.statistics += solver.getStatistics();
+	left.mesh.clear();
+	left.points.clear();
+	left.dimension = solver.getDimension();
+
+	if (left.dimension < 3) {
+		left.points.swap(vertices);
+	} else {
+		copyFaces(solver.getMesh(), &vertices[0], NULL, left.mesh, worker);
+	}
+
+	findVertices(left, worker.vertices);
+	left.first = worker.vertices.front();
+	left.last = worker.vertices.back();
+}
+
+/**
+ * Starting from the last vertex of the left hull and the first of the
+ * right, each end steps to any neighbor that is to the right of the line
+ * between them, until neither can.  A vertical plane through a vertex that
+ * has all of the vertex's neighbors on one side has the whole hull on that
+ * side, so the line then has both hulls' shadows to its left.  Finally each
+ * end slides along the line toward the other, so that no point of either
+ * shadow lies on the line between them.
+ *
+ * \param left The hull of the lower run
+ * \param right The hull of the upper run
+ * \param a Receives the tangent's end on the left hull
+ * \param b Receives the tangent's end on the right hull
+ * \param worker The worker doing the merge
+ * \return false if the search did not settle
+ */
+bool DivideAndConquerSolver::findTangent(const Part &left, const Part &right,
+	HullPointIndex &a, HullPointIndex &b, Worker &worker) {
+
+	size_t limit = left.mesh.getNumFaces() + right.mesh.getNumFaces() + 8;
+	a = left.last;
+	b = right.first;
+
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t steps = 0; ; steps++) {
+			if (steps > limit) {
+				return false;
+			}
+
+			bool moved = false;
+
+			if (!findNeighbors(left.mesh, a, worker.leftCandidates)
+				|| !findNeighbors(right.mesh, b, worker.rightCandidates)) {
+
+				return false;
+			}
+
+			for (CandidateList::const_iterator i = worker.leftCandidates.begin(); !moved && i != worker.leftCandidates.end(); i++) {
+				int o = HullPredicates::orientation2d(this->sorted, a, b, (*i).point, 2, &worker.statistics);
+
+				if (o < 0 || (pass == 1 && o == 0 && isNearer(this->sorted, b, (*i).point, a))) {
+					a = (*i).point;
+					moved = true;
+				}
+			}
+
+			for (CandidateList::const_iterator i = worker.rightCandidates.begin(); !moved && i != worker.rightCandidates.end(); i++) {
+				int o = HullPredicates::orientation2d(this->sorted, a, b, (*i).point, 2, &worker.statistics);
+
+				if (o < 0 || (pass == 1 && o == 0 && isNearer(this->sorted, a, (*i).point, b))) {
+					b = (*i).point;
+					moved = true;
+				}
+			}
+
+			if (!moved) {
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * The faces around the vertex are visited in turn, starting from the one
+ * recorded in vertexFaces.
+ *
+ * \param mesh The hull
+ * \param v The vertex
+ * \param candidates Receives the neighbors
+ * \return false if the faces around the vertex don't form a closed fan
+ */
+bool DivideAndConquerSolver::findNeighbors(const HullMesh &mesh, HullPointIndex v, CandidateList &candidates) const {
+	candidates.clear();
+
+	HullFaceIndex start = this->vertexFaces[v];
+	HullFaceIndex f = start;
+	int i = -1;
+
+	for (int j = 0; j < 3; j++) {
+		if (mesh.getFace(f).getPoint(j) == v) {
+			i = j;
+		}
+	}
+
+	while (i >= 0) {
+		const HullFace &face = mesh.getFace(f);
+		Candidate candidate = { face.getPoint((i + 1) % 3), f, i };
+		candidates.push_back(candidate);
+
+		// The edge into v leads to the next face around it.
+		HullPointIndex p = face.getPoint((i + 2) % 3);
+		f = face.getNeighbor((i + 2) % 3);
+
+		if (f == start) {
+			return true;
+		}
+
+		if (f == NO_HULL_FACE || candidates.size() > mesh.getNumFaces()) {
+			return false;
+		}
+
+		i = mesh.getFace(f).findEdge(v, p);
+	}
+
+	return false;
+}
+
+/**
+ * Where the band meets a hull at a vertex that none of the hull's faces
+ * survive around, it runs out along an edge of the hull and back along the
+ * other side.  Neither face of the hull along that edge is kept; the two
+ * band faces are glued to each other instead.
+ *
+ * \param left Whether to pair up the band faces on the left hull
+ * \param worker The worker doing the merge, whose band receives the pairs
+ * \return false if more than two band faces share an edge
+ */
+bool DivideAndConquerSolver::findTwins(bool left, Worker &worker) const {
+	BandFaceList &band = worker.band;
+	LoopEdgeList &edges = worker.loopEdges;
+	edges.clear();
+
+	for (size_t i = 0; i < band.size(); i++) {
+		if (band[i].left == left) {
+			band[i].twin = -1;
+
+			HullPointIndex p = left ? band[i].a : band[i].b;
+			LoopEdge edge = { std::min(p, band[i].c), std::max(p, band[i].c), (int) i };
+			edges.push_back(edge);
+		}
+	}
+
+	std::sort(edges.begin(), edges.end());
+
+	for (size_t i = 1; i < edges.size(); i++) {
+		if (!(edges[i - 1] < edges[i])) {
+			if (i + 1 < edges.size() && !(edges[i] < edges[i + 1])) {
+				return false;
+			}
+
+			band[edges[i - 1].face].twin = edges[i].face;
+			band[edges[i].face].twin = edges[i - 1].face;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \param a The band's current vertex on the left hull
+ * \param b The band's current vertex on the right hull
+ * \param previous The third corner of the last band face (NO_HULL_POINT if
+ *   there is none yet)
+ * \param candidates The neighbors of a (if left) or of b
+ * \param left Whether the candidates are on the left hull
+ * \param worker The worker doing the merge
+ * \return The best candidate, or NULL if there are none
+ */
+const DivideAndConquerSolver::Candidate *DivideAndConquerSolver::pickCandidate(HullPointIndex a, HullPointIndex b,
+	HullPointIndex previous, const CandidateList &candidates, bool left, Worker &worker) const {
+
+	const Candidate *best = NULL;
+
+	for (CandidateList::const_iterator i = candidates.begin(); i != candidates.end(); i++) {
+		if (best == NULL || compareCandidates(a, b, previous, best->point, (*i).point,
+			left ? PIVOT_LEFT : PIVOT_RIGHT, worker) > 0) {
+
+			best = &*i;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * The candidates are ranked by how far the plane through a, b and the
+ * candidate is turned about the line from a to b, since the right one has
+ * no point in front of it.  When two candidates are coplanar with a and b,
+ * the tie is broken within that plane:
+ *
+ * - If they are on opposite sides of the line, one of them is on the side
+ *   of the last band face (or, for the first face, below the tangent), and
+ *   the other one wins.
+ * - Between two neighbors of a, the one making the smaller angle with the
+ *   line at a wins, since the other reaches across the left hull's face;
+ *   likewise for two neighbors of b.
+ * - Between a neighbor of a and a neighbor of b, the neighbor of a wins if
+ *   the neighbor of b is beyond the line from b to it.
+ *
+ * \param a The band's current vertex on the left hull
+ * \param b The band's current vertex on the right hull
+ * \param previous The third corner of the last band face (NO_HULL_POINT if
+ *   there is none yet)
+ * \param best The best candidate so far
+ * \param c The challenger
+ * \param pivot Which vertex the candidates are neighbors of (a Pivot)
+ * \param worker The worker doing the merge
+ * \return Positive if c beats best, negative if it doesn't
+ */
+int DivideAndConquerSolver::compareCandidates(HullPointIndex a, HullPointIndex b, HullPointIndex previous,
+	HullPointIndex best, HullPointIndex c, int pivot, Worker &worker) const {
+
+	const HullPointBuffer &pts = this->sorted;
+	int o = HullPredicates::orientation(pts, a, b, best, c, &worker.statistics);
+
+	if (o != 0) {
+		return o;
+	}
+
+	// A point on the line through a and b can't make a face.
+	if (HullPredicates::collinear(pts, a, b, c, &worker.statistics)) {
+		return -1;
+	}
+
+	int axis, sign;
+
+	if (!findProjection(pts, a, b, best, axis, sign, &worker.statistics)) {
+		return 1;
+	}
+
+	if (sign * HullPredicates::orientation2d(pts, a, b, c, axis, &worker.statistics) < 0) {
+		bool backward;
+
+		if (previous != NO_HULL_POINT) {
+			backward = sign * HullPredicates::orientation2d(pts, a, b, previous, axis, &worker.statistics) > 0;
+		} else {
+			// The plane is the tangent plane, and the face's outward normal
+			// has to point to the right of the tangent.
+			double dx = pts.getX(b) - pts.getX(a);
+			double dy = pts.getY(b) - pts.getY(a);
+			int n;
+
+			if (dy != 0.0) {
+				n = HullPredicates::orientation2d(pts, a, b, best, 0, &worker.statistics);
+				backward = (n > 0) != (dy > 0.0);
+			} else {
+				n = HullPredicates::orientation2d(pts, a, b, best, 1, &worker.statistics);
+				backward = (n > 0) != (dx < 0.0);
+			}
+		}
+
+		return backward ? 1 : -1;
+	}
+
+	int t;
+
+	switch (pivot) {
+		case PIVOT_LEFT:
+			t = -sign * HullPredicates::orientation2d(pts, a, best, c, axis, &worker.statistics);
+			return (t != 0) ? t : (isNearer(pts, a, c, best) ? 1 : -1);
+		case PIVOT_RIGHT:
+			t = sign * HullPredicates::orientation2d(pts, b, best, c, axis, &worker.statistics);
+			return (t != 0) ? t : (isNearer(pts, b, c, best) ? 1 : -1);
+		default:
+			t = -sign * HullPredicates::orientation2d(pts, best, b, c, axis, &worker.statistics);
+			return (t != 0) ? t : (isNearer(pts, b, c, best) ? 1 : -1);
+	}
+}
+
+/**
+ * \param p0 The first corner of the face
+ * \param p1 The second corner of the face
+ * \param p2 The third corner of the face
+ * \param edge The edge shared with the neighbor (0, 1 or 2)
+ * \param opposite The neighbor's corner that is not on the edge
+ * \param worker The worker doing the merge
+ * \return Whether the neighbor is behind the face, or in its plane and on
+ *   the far side of the edge
+ */
+bool DivideAndConquerSolver::isConvexEdge(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, int edge,
+	HullPointIndex opposite, Worker &worker) const {
+
+	int o = HullPredicates::orientation(this->sorted, p0, p1, p2, opposite, &worker.statistics);
+
+	if (o != 0) {
+		return o < 0;
+	}
+
+	int axis, sign;
+
+	if (!findProjection(this->sorted, p0, p1, p2, axis, sign, &worker.statistics)) {
+		return false;
+	}
+
+	HullPointIndex corners[3] = { p0, p1, p2 };
+
+	return sign * HullPredicates::orientation2d(this->sorted, corners[edge], corners[(edge + 1) % 3],
+		opposite, axis, &worker.statistics) < 0;
+}
+
+/**
+ * The faces that the band is glued to are kept, and the faces across those
+ * edges are hidden, along with every face reachable from them without
+ * crossing the band.  If the band touches the hull at a single vertex, the
+ * whole hull is hidden.
+ *
+ * \param mesh The hull
+ * \param left Whether the hull is the left one
+ * \param worker The worker doing the merge, whose band to use and whose
+ *   marks for the hull receive the results
+ * \return false if a kept face would be hidden as well
+ */
+bool DivideAndConquerSolver::markHidden(const HullMesh &mesh, bool left, Worker &worker) const {
+	vector<char> &marks = left ? worker.leftMarks : worker.rightMarks;
+	vector<unsigned char> &loops = left ? worker.leftLoops : worker.rightLoops;
+	const BandFaceList &band = worker.band;
+	HullFaceIndexList &stack = worker.faceMap;
+
+	marks.assign(mesh.getCapacity(), UNTOUCHED);
+	loops.assign(mesh.getCapacity(), 0);
+	stack.clear();
+
+	for (BandFaceList::const_iterator i = band.begin(); i != band.end(); i++) {
+		if ((*i).left == left && (*i).twin < 0) {
+			marks[(*i).kept] = KEPT;
+		}
+	}
+
+	for (BandFaceList::const_iterator i = band.begin(); i != band.end(); i++) {
+		if ((*i).left == left) {
+			if (marks[(*i).hidden] == KEPT) {
+				return false;
+			}
+
+			loops[(*i).hidden] |= (unsigned char) (1 << (*i).hiddenEdge);
+
+			if (marks[(*i).hidden] == UNTOUCHED) {
+				marks[(*i).hidden] = HIDDEN;
+				stack.push_back((*i).hidden);
+			}
+		}
+	}
+
+	if (stack.empty()) {
+		for (HullFaceIndex i = 0; i < mesh.getCapacity(); i++) {
+			marks[i] = mesh.isLive(i) ? HIDDEN : UNTOUCHED;
+		}
+
+		return true;
+	}
+
+	while (!stack.empty()) {
+		HullFaceIndex f = stack.back();
+		stack.pop_back();
+
+		for (int e = 0; e < 3; e++) {
+			if (loops[f] & (1 << e)) {
+				continue;
+			}
+
+			HullFaceIndex neighbor = mesh.getFace(f).getNeighbor(e);
+
+			if (marks[neighbor] == KEPT) {
+				return false;
+			}
+
+			if (marks[neighbor] == UNTOUCHED) {
+				marks[neighbor] = HIDDEN;
+				stack.push_back(neighbor);
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \param part The hull
+ * \param vertices Receives the vertices, in increasing order
+ */
+void DivideAndConquerSolver::findVertices(const Part &part, HullPointIndexList &vertices) const {
+	if (part.dimension < 3) {
+		vertices = part.points;
+		return;
+	}
+
+	vertices.clear();
+
+	for (HullFaceIndex i = 0; i < part.mesh.getCapacity(); i++) {
+		if (part.mesh.isLive(i)) {
+			const HullFace &face = part.mesh.getFace(i);
+			vertices.push_back(face.getP0());
+			vertices.push_back(face.getP1());
+			vertices.push_back(face.getP2());
+		}
+	}
+
+	std::sort(vertices.begin(), vertices.end());
+	vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+}
+
+/**
+ * Neighbors are carried over where they were copied too; edges whose
+ * neighbor was left out are left unlinked.  Each copied vertex has the copy
+ * of one of its faces recorded in vertexFaces.
+ *
+ * \param source The hull to copy from
+ * \param pointMap The sorted index of each of the source's points, or NULL
+ *   if it already refers to sorted points
+ * \param marks If not NULL, faces marked HIDDEN here are left out
+ * \param target The hull to copy into
+ * \param worker The worker doing the copy, whose faceMap receives the new
+ *   index of each face (NO_HULL_FACE if it was left out)
+ */
+void DivideAndConquerSolver::copyFaces(const HullMesh &source, const HullPointIndex *pointMap,
+	const vector<char> *marks, HullMesh &target, Worker &worker) {
+
+	HullFaceIndexList &faceMap = worker.faceMap;
+	faceMap.assign(source.getCapacity(), NO_HULL_FACE);
+
+	for (HullFaceIndex i = 0; i < source.getCapacity(); i++) {
+		if (source.isLive(i) && (marks == NULL || (*marks)[i] != HIDDEN)) {
+			const HullFace &face = source.getFace(i);
+			HullPointIndex p0 = (pointMap != NULL) ? pointMap[face.getP0()] : face.getP0();
+			HullPointIndex p1 = (pointMap != NULL) ? pointMap[face.getP1()] : face.getP1();
+			HullPointIndex p2 = (pointMap != NULL) ? pointMap[face.getP2()] : face.getP2();
+			faceMap[i] = target.addFace(HullFace(p0, p1, p2));
+		}
+	}
+
+	for (HullFaceIndex i = 0; i < source.getCapacity(); i++) {
+		if (faceMap[i] != NO_HULL_FACE) {
+			HullFace &face = target.getFace(faceMap[i]);
+
+			for (int e = 0; e < 3; e++) {
+				HullFaceIndex neighbor = source.getFace(i).getNeighbor(e);
+				face.setNeighbor(e, (neighbor != NO_HULL_FACE) ? faceMap[neighbor] : NO_HULL_FACE);
+				this->vertexFaces[face.getPoint(e)] = faceMap[i];
+			}
+		}
+	}
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+void DivideAndConquerSolver::run(size_t numTasks, void (DivideAndConquerSolver::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
@@ -0,0 +1,224 @@
+/**
+ * \file HullBatchSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the BasicHullBatchSolver class template
+ */
+
+#include "HullBatchSolver.h"
+#include "PlanarHullSolver.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+
+using namespace peek;
+
+namespace {
+
+	/** Gets double points for PlanarHullSolver, which are the points themselves if they are already double */
+	inline HullPointBuffer toDouble(const HullPointBuffer &points) {
+		return points;
+	}
+
+	/** Gets double points for PlanarHullSolver, which are a widened copy of float points */
+	HullPointBuffer toDouble(const FloatHullPointBuffer &points) {
+		HullPointBuffer widened;
+		widened.reserve(points.size());
+
+		for (size_t i = 0; i < points.size(); i++) {
+			HullPointIndex p = (HullPointIndex) i;
+			widened.add(points.getX(p), points.getY(p), points.getZ(p));
+		}
+
+		return widened;
+	}
+
+}
+
+template <typename T>
+const size_t BasicHullBatchSolver<T>::RANGES_PER_TASK;
+
+/**
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+template <typename T>
+BasicHullBatchSolver<T>::BasicHullBatchSolver(unsigned int numThreads) {
+	this->points = NULL;
+	this->rangeOffsets = NULL;
+	setNumThreads(numThreads);
+}
+
+template <typename T>
+BasicHullBatchSolver<T>::~BasicHullBatchSolver() {
+	for (size_t i = 0; i < this->solvers.size(); i++) {
+		delete this->solvers[i];
+	}
+}
+
+/**
+ * Range i holds the points from rangeOffsets[i] up to rangeOffsets[i + 1].
+ * Afterwards, the faces of hull i are the triangles from getFaceOffsets()[i]
+ * up to getFaceOffsets()[i + 1]; the corners of triangle f are entries
+ * 3f, 3f + 1 and 3f + 2 of getTriangles(), and are indices into the whole
+ * buffer rather than into the range.
+ *
+ * \param points The points of all of the ranges.  The coordinates are not
+ *   copied.
+ * \param rangeOffsets Where each range starts, followed by where the last
+ *   one ends
+ */
+template <typename T>
+void BasicHullBatchSolver<T>::solve(const PointBuffer &points, const vector<size_t> &rangeOffsets) {
+	size_t numRanges = rangeOffsets.empty() ? 0 : rangeOffsets.size() - 1;
+	size_t numBlocks = (numRanges + RANGES_PER_TASK - 1) / RANGES_PER_TASK;
+
+	this->points = &points;
+	this->rangeOffsets = &rangeOffsets;
+	this->dimensions.resize(numRanges);
+	this->faceOffsets.assign(numRanges + 1, 0);
+
+	if (this->blockTriangles.size() < numBlocks) {
+		this->blockTriangles.resize(numBlocks);
+	}
+
+	// Each block records the number of faces of each of its hulls, and the
+	// offsets are then the running totals of those.
+	run(numBlocks, &BasicHullBatchSolver::solveBlock);
+
+	for (size_t i = 0; i < numRanges; i++) {
+		this->faceOffsets[i + 1] += this->faceOffsets[i];
+	}
+
+	this->triangles.resize(3 * this->faceOffsets[numRanges]);
+
+	for (size_t b = 0; b < numBlocks; b++) {
+		const HullPointIndexList &block = this->blockTriangles[b];
+		std::copy(block.begin(), block.end(), this->triangles.begin() + 3 * this->faceOffsets[b * RANGES_PER_TASK]);
+	}
+
+	this->points = NULL;
+	this->rangeOffsets = NULL;
+}
+
+/**
+ * Each thread gets a solver of its own.  The solvers themselves only use
+ * the one thread, since the ranges are too small to be worth splitting.
+ *
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+template <typename T>
+void BasicHullBatchSolver<T>::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	for (size_t i = numThreads; i < this->solvers.size(); i++) {
+		delete this->solvers[i];
+	}
+
+	size_t numSolvers = this->solvers.size();
+	this->solvers.resize(numThreads);
+
+	for (size_t i = numSolvers; i < numThreads; i++) {
+		this->solvers[i] = new BasicConvexHullSolver<T>(PointBuffer());
+	}
+
+	this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over all threads and batches
+ */
+template <typename T>
+HullPredicateStatistics BasicHullBatchSolver<T>::getStatistics() const {
+	HullPredicateStatistics statistics;
+
+	for (size_t i = 0; i < this->solvers.size(); i++) {
+		statistics += this->solvers[i]->getStatistics();
+	}
+
+	return statistics;
+}
+
+/**
+ * The solver reads each range through a view of the batch's arrays, and
+ * its faces are read straight from its mesh, so nothing is copied but the
+ * corners of the faces.  A range that turns out to lie in a plane is
+ * solved again by PlanarHullSolver, as HullSolver::create() would send it,
+ * so that it gets the polygon's two-sided fan rather than no faces.
+ *
+ * \param block The block of ranges to solve
+ * \param thread The thread doing the work
+ */
+template <typename T>
+void BasicHullBatchSolver<T>::solveBlock(size_t block, unsigned int thread) {
+	BasicConvexHullSolver<T> &solver = *this->solvers[thread];
+	const PointBuffer &pts = *this->points;
+	const vector<size_t> &offsets = *this->rangeOffsets;
+	HullPointIndexList &output = this->blockTriangles[block];
+	size_t numRanges = offsets.size() - 1;
+	size_t first = block * RANGES_PER_TASK;
+	size_t last = std::min(first + RANGES_PER_TASK, numRanges);
+	size_t stride = pts.getStride();
+
+	output.clear();
+
+	for (size_t r = first; r < last; r++) {
+		size_t begin = offsets[r];
+		size_t end = offsets[r + 1];
+
+		solver.reset(PointBuffer(pts.getXArray() + begin * stride, pts.getYArray() + begin * stride,
+			pts.getZArray() + begin * stride, end - begin, stride));
+		solver.iterateToCompletion();
+
+		this->dimensions[r] = solver.getDimension();
+
+		if (solver.getDimension() == 2) {
+			PlanarHullSolver planarSolver(toDouble(solver.getPoints()));
+			planarSolver.iterateToCompletion();
+			HullFaceList faces = planarSolver.getHull();
+
+			for (size_t f = 0; f < faces.size(); f++) {
+				output.push_back((HullPointIndex) (faces[f].getP0() + begin));
+				output.push_back((HullPointIndex) (faces[f].getP1() + begin));
+				output.push_back((HullPointIndex) (faces[f].getP2() + begin));
+			}
+
+			this->faceOffsets[r + 1] = faces.size();
+			continue;
+		}
+
+		const typename BasicConvexHullSolver<T>::Mesh &mesh = solver.getMesh();
+
+		for (HullFaceIndex f = 0; f < mesh.getCapacity(); f++) {
+			if (mesh.isLive(f)) {
+				const BasicHullFace<T> &face = mesh.getFace(f);
+				output.push_back((HullPointIndex) (face.getP0() + begin));
+				output.push_back((HullPointIndex) (face.getP1() + begin));
+				output.push_back((HullPointIndex) (face.getP2() + begin));
+			}
+		}
+
+		this->faceOffsets[r + 1] = mesh.getNumFaces();
+	}
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+template <typename T>
+void BasicHullBatchSolver<T>::run(size_t numTasks, void (BasicHullBatchSolver::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
+
+template class BasicHullBatchSolver<double>;
+template class BasicHullBatchSolver<float>;
@@ -14,7 +14,7 @@ using namespace peek;
  * \param p0 The first point defining the edge
  * \param p1 The second point defining the edge
  */
-HullEdge::HullEdge(HullPoint p0, HullPoint p1) {
+HullEdge::HullEdge(HullPointIndex p0, HullPointIndex p1) {
 	this->p0 = p0;
 	this->p1 = p1;
 }
\ No newline at end of file
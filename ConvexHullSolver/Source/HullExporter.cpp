@@ -0,0 +1,284 @@
+/**
+ * \file HullExporter.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the BasicHullExporter class template
+ */
+
+#include "HullExporter.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+using namespace peek;
+
+namespace {
+
+	/** Gets whether or not a path ends in the given extension, ignoring case */
+	bool hasExtension(const char *path, const char *extension) {
+		size_t pathLength = strlen(path);
+		size_t extensionLength = strlen(extension);
+
+		if (pathLength < extensionLength) {
+			return false;
+		}
+
+		for (size_t i = 0; i < extensionLength; i++) {
+			if (tolower(path[pathLength - extensionLength + i]) != extension[i]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Gets the name PLY gives the type T */
+	template <typename T>
+	const char *plyTypeName();
+
+	template <>
+	const char *plyTypeName<double>() {
+		return "double";
+	}
+
+	template <>
+	const char *plyTypeName<float>() {
+		return "float";
+	}
+
+	/** Writes a coordinate in PLY's binary form */
+	inline void writeScalar(BufferedFileWriter &writer, double value) {
+		writer.writeDouble(value);
+	}
+
+	/** Writes a coordinate in PLY's binary form */
+	inline void writeScalar(BufferedFileWriter &writer, float value) {
+		writer.writeFloat(value);
+	}
+
+	/** Gets a printf format that writes a coordinate of type T exactly */
+	template <typename T>
+	const char *objVertexFormat() {
+		return (sizeof(T) == sizeof(float)) ? "v %.9g %.9g %.9g\n" : "v %.17g %.17g %.17g\n";
+	}
+
+}
+
+template <typename T>
+BasicHullExporter<T>::BasicHullExporter() {}
+
+/**
+ * \param faces The hull's faces
+ * \param points The points the faces' corners are indices of.  The points
+ *   that are corners are copied.
+ */
+template <typename T>
+void BasicHullExporter<T>::setHull(const HullFaceList &faces, const PointBuffer &points) {
+	this->triangles.resize(3 * faces.size());
+
+	for (size_t f = 0; f < faces.size(); f++) {
+		this->triangles[3 * f] = faces[f].getP0();
+		this->triangles[3 * f + 1] = faces[f].getP1();
+		this->triangles[3 * f + 2] = faces[f].getP2();
+	}
+
+	gatherVertices(points);
+}
+
+/**
+ * \param triangles The corners of the hull's faces, three per face, as
+ *   indices of the points (as from a HullMesh or a HullBatchSolver)
+ * \param points The points the corners are indices of.  The points that
+ *   are corners are copied.
+ */
+template <typename T>
+void BasicHullExporter<T>::setHull(const HullPointIndexList &triangles, const PointBuffer &points) {
+	this->triangles = triangles;
+	gatherVertices(points);
+}
+
+/**
+ * The distinct corners are found by sorting them, rather than by marking
+ * them off in a table the size of the input, so that the cost depends only
+ * on the size of the hull.
+ *
+ * \param points The points the corners are indices of
+ */
+template <typename T>
+void BasicHullExporter<T>::gatherVertices(const PointBuffer &points) {
+	this->inputIndices = this->triangles;
+	std::sort(this->inputIndices.begin(), this->inputIndices.end());
+	this->inputIndices.erase(std::unique(this->inputIndices.begin(), this->inputIndices.end()),
+		this->inputIndices.end());
+
+	this->vertices = PointBuffer();
+	this->vertices.reserve(this->inputIndices.size());
+
+	for (size_t v = 0; v < this->inputIndices.size(); v++) {
+		HullPointIndex p = this->inputIndices[v];
+		this->vertices.add(points.getX(p), points.getY(p), points.getZ(p));
+	}
+
+	for (size_t i = 0; i < this->triangles.size(); i++) {
+		this->triangles[i] = (HullPointIndex) (std::lower_bound(this->inputIndices.begin(),
+			this->inputIndices.end(), this->triangles[i]) - this->inputIndices.begin());
+	}
+}
+
+/**
+ * \param path The file to write, which is replaced if it exists
+ * \param format The file's layout
+ * \param bufferSize The size of the writer's buffer, in bytes
+ * \return Whether or not the whole file was written.  If not, the reason is
+ *   given by getError().
+ */
+template <typename T>
+bool BasicHullExporter<T>::write(const char *path, Format format, size_t bufferSize) {
+	this->error.clear();
+
+	if (format == AUTO) {
+		format = hasExtension(path, ".ply") ? PLY : hasExtension(path, ".stl") ? STL
+			: hasExtension(path, ".obj") ? OBJ : AUTO;
+
+		if (format == AUTO) {
+			this->error = "the file name doesn't end in .ply, .stl or .obj";
+			return false;
+		}
+	}
+
+	BufferedFileWriter writer(path, bufferSize);
+
+	if (writer.isOpen()) {
+		if (format == PLY) {
+			writePly(writer);
+		} else if (format == STL) {
+			writeStl(writer);
+		} else {
+			writeObj(writer);
+		}
+	}
+
+	if (!writer.close()) {
+		this->error = writer.getError();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * \param writer The file
+ */
+template <typename T>
+void BasicHullExporter<T>::writePly(BufferedFileWriter &writer) const {
+	char line[64];
+
+	writer.write("ply\nformat binary_little_endian 1.0\ncomment convex hull\n");
+	sprintf(line, "element vertex %lu\n", (unsigned long) this->vertices.size());
+	writer.write(line);
+
+	for (int axis = 0; axis < 3; axis++) {
+		sprintf(line, "property %s %c\n", plyTypeName<T>(), 'x' + axis);
+		writer.write(line);
+	}
+
+	sprintf(line, "element face %lu\n", (unsigned long) getNumFaces());
+	writer.write(line);
+	writer.write("property list uchar uint vertex_indices\nend_header\n");
+
+	for (size_t v = 0; v < this->vertices.size(); v++) {
+		writeScalar(writer, this->vertices.getX((HullPointIndex) v));
+		writeScalar(writer, this->vertices.getY((HullPointIndex) v));
+		writeScalar(writer, this->vertices.getZ((HullPointIndex) v));
+	}
+
+	for (size_t i = 0; i < this->triangles.size(); i += 3) {
+		writer.writeUint8(3);
+		writer.writeUint32(this->triangles[i]);
+		writer.writeUint32(this->triangles[i + 1]);
+		writer.writeUint32(this->triangles[i + 2]);
+	}
+}
+
+/**
+ * Each normal is worked out in double from the triangle's corners, so that
+ * it agrees with the winding of the corners whatever the type of the
+ * points.
+ *
+ * \param writer The file
+ */
+template <typename T>
+void BasicHullExporter<T>::writeStl(BufferedFileWriter &writer) const {
+	char header[80];
+	memset(header, 0, sizeof(header));
+	strcpy(header, "convex hull");
+
+	writer.write(header, sizeof(header));
+	writer.writeUint32((boost::uint32_t) getNumFaces());
+
+	for (size_t i = 0; i < this->triangles.size(); i += 3) {
+		double corners[3][3];
+
+		for (int c = 0; c < 3; c++) {
+			HullPointIndex v = this->triangles[i + c];
+			corners[c][0] = this->vertices.getX(v);
+			corners[c][1] = this->vertices.getY(v);
+			corners[c][2] = this->vertices.getZ(v);
+		}
+
+		double u[3], w[3], normal[3];
+
+		for (int axis = 0; axis < 3; axis++) {
+			u[axis] = corners[1][axis] - corners[0][axis];
+			w[axis] = corners[2][axis] - corners[0][axis];
+		}
+
+		normal[0] = u[1] * w[2] - u[2] * w[1];
+		normal[1] = u[2] * w[0] - u[0] * w[2];
+		normal[2] = u[0] * w[1] - u[1] * w[0];
+
+		double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		length = (length > 0) ? length : 1;
+
+		for (int axis = 0; axis < 3; axis++) {
+			writer.writeFloat((float) (normal[axis] / length));
+		}
+
+		for (int c = 0; c < 3; c++) {
+			for (int axis = 0; axis < 3; axis++) {
+				writer.writeFloat((float) corners[c][axis]);
+			}
+		}
+
+		writer.writeUint16(0);
+	}
+}
+
+/**
+ * The coordinates are written with enough digits to read back exactly.
+ *
+ * \param writer The file
+ */
+template <typename T>
+void BasicHullExporter<T>::writeObj(BufferedFileWriter &writer) const {
+	char line[96];
+
+	writer.write("# convex hull\n");
+
+	for (size_t v = 0; v < this->vertices.size(); v++) {
+		sprintf(line, objVertexFormat<T>(), (double) this->vertices.getX((HullPointIndex) v),
+			(double) this->vertices.getY((HullPointIndex) v), (double) this->vertices.getZ((HullPointIndex) v));
+		writer.write(line);
+	}
+
+	// OBJ numbers vertices from 1.
+	for (size_t i = 0; i < this->triangles.size(); i += 3) {
+		sprintf(line, "f %lu %lu %lu\n", (unsigned long) this->triangles[i] + 1,
+			(unsigned long) this->triangles[i + 1] + 1, (unsigned long) this->triangles[i + 2] + 1);
+		writer.write(line);
+	}
+}
+
+template class BasicHullExporter<double>;
+template class BasicHullExporter<float>;
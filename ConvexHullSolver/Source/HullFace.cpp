@@ -2,57 +2,171 @@
  * \file HullFace.cpp
  * \author Douglas W. Paul
  *
- * Defines the behavior of the HullFace class
+ * Defines the behavior of the BasicHullFace class template
  */
 
 #include "HullFace.h"
 #include <Peek_base.hpp>
+#include <cfloat>
+#include <cmath>
+#include <limits>
 
 using namespace peek;
 
 
 /**
- * A HullFace generated with this default constructor is invalid.  Since
- * all of the points are at the origin, the face is degenerate.
+ * A face generated with this default constructor is invalid.  Since all
+ * of the points are at the origin, the face is degenerate.
  */
-HullFace::HullFace() {}
+template <typename T>
+BasicHullFace<T>::BasicHullFace() {
+	this->neighbors[0] = NO_HULL_FACE;
+	this->neighbors[1] = NO_HULL_FACE;
+	this->neighbors[2] = NO_HULL_FACE;
+	this->furthestPoint = NO_HULL_POINT;
+	this->furthestDistance = 0.0;
+	this->plane[0] = this->plane[1] = this->plane[2] = this->plane[3] = 0.0;
+	this->errorBound = std::numeric_limits<T>::max();
+}
 
 /**
  * \param p0 The first point defining the face
  * \param p1 The second point defining the face
  * \param p2 The third point defining the face
  */
-HullFace::HullFace(HullPoint p0, HullPoint p1, HullPoint p2) {
+template <typename T>
+BasicHullFace<T>::BasicHullFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2) {
 	this->p0 = p0;
 	this->p1 = p1;
 	this->p2 = p2;
+	this->neighbors[0] = NO_HULL_FACE;
+	this->neighbors[1] = NO_HULL_FACE;
+	this->neighbors[2] = NO_HULL_FACE;
+	this->furthestPoint = NO_HULL_POINT;
+	this->furthestDistance = 0.0;
+	this->plane[0] = this->plane[1] = this->plane[2] = this->plane[3] = 0.0;
+	this->errorBound = std::numeric_limits<T>::max();
 }
 
 /**
+ * Computing the plane once up front means that classifying a point against
+ * the face later on costs a single dot product.  The plane is worked out in
+ * double whatever T is, and only rounded to T at the end.
+ *
+ * \param p0 The first point defining the face
+ * \param p1 The second point defining the face
+ * \param p2 The third point defining the face
+ * \param points The buffer holding the points
+ * \param magnitude An upper bound on |x| + |y| + |z| over every point that
+ *   will be tested against the face
+ */
+template <typename T>
+BasicHullFace<T>::BasicHullFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2,
+	const BasicHullPointBuffer<T> &points, double magnitude) {
+
+	this->p0 = p0;
+	this->p1 = p1;
+	this->p2 = p2;
+	this->neighbors[0] = NO_HULL_FACE;
+	this->neighbors[1] = NO_HULL_FACE;
+	this->neighbors[2] = NO_HULL_FACE;
+	this->furthestPoint = NO_HULL_POINT;
+	this->furthestDistance = 0.0;
+
+	double ax = (double) points.getX(p1) - points.getX(p0);
+	double ay = (double) points.getY(p1) - points.getY(p0);
+	double az = (double) points.getZ(p1) - points.getZ(p0);
+	double bx = (double) points.getX(p2) - points.getX(p0);
+	double by = (double) points.getY(p2) - points.getY(p0);
+	double bz = (double) points.getZ(p2) - points.getZ(p0);
+
+	double nx = ay * bz - az * by;
+	double ny = az * bx - ax * bz;
+	double nz = ax * by - ay * bx;
+	double length = sqrt(nx * nx + ny * ny + nz * nz);
+
+	// A degenerate face has no plane.  Its error bound is infinite, so every
+	// test against it falls back to the exact orientation.
+	if (length == 0.0) {
+		this->plane[0] = this->plane[1] = this->plane[2] = this->plane[3] = 0.0;
+		this->errorBound = std::numeric_limits<T>::max();
+		return;
+	}
+
+	double normal[3] = { nx / length, ny / length, nz / length };
+
+	// Measure the offset at the centroid, which is a little more accurate
+	// than measuring it at any one corner.
+	double cx = ((double) points.getX(p0) + points.getX(p1) + points.getX(p2)) / 3.0;
+	double cy = ((double) points.getY(p0) + points.getY(p1) + points.getY(p2)) / 3.0;
+	double cz = ((double) points.getZ(p0) + points.getZ(p1) + points.getZ(p2)) / 3.0;
+
+	this->plane[0] = (T) normal[0];
+	this->plane[1] = (T) normal[1];
+	this->plane[2] = (T) normal[2];
+	this->plane[3] = (T) (normal[0] * cx + normal[1] * cy + normal[2] * cz);
+
+	// The direction of the computed normal is off by an angle of a few
+	// epsilon, scaled up by how thin the triangle is (|a| |b| / |a x b|).  That
+	// tilt is multiplied by the distance to the query point.  Rounding the
+	// plane to T, the dot product and the offset add a few more epsilon of T
+	// times the magnitude on top.
+	double thinness = sqrt(ax * ax + ay * ay + az * az) * sqrt(bx * bx + by * by + bz * bz) / length;
+	this->errorBound = (T) ((8.0 * thinness * DBL_EPSILON + 8.0 * std::numeric_limits<T>::epsilon()) * magnitude);
+}
+
+/**
+ * The face keeps track of the furthest of its points as they are associated,
+ * so that it doesn't have to search for it later.
+ *
  * \param p The point to associate with the face
+ * \param distance How far the point is in front of the face.  Any measure
+ *   that is proportional to the true distance will do, as long as the same
+ *   one is used for every point.
  */
-void HullFace::associate(HullPoint p) {
-	this->associatedPoints.add(p);
+template <typename T>
+void BasicHullFace<T>::associate(HullPointIndex p, double distance) {
+	if (this->associatedPoints.empty() || distance > this->furthestDistance) {
+		setFurthestPoint(p, distance);
+	}
+
+	this->associatedPoints.push_back(p);
 }
 
 /**
- * \return The list of associated points
+ * \param i The index of the point (0, 1 or 2)
+ * \return The point
  */
-HullPointSet HullFace::getAssociatedPoints() {
-	return this->associatedPoints;
+template <typename T>
+HullPointIndex BasicHullFace<T>::getPoint(int i) const {
+	switch (i) {
+		case 0: return this->p0;
+		case 1: return this->p1;
+		default: return this->p2;
+	}
 }
 
 /**
- * \return The number of associated points
+ * \param a The point at which the edge starts
+ * \param b The point at which the edge ends
+ * \return The index of the edge, or -1 if the face has no such edge
  */
-size_t HullFace::getNumAssociatedPoints() {
-	return this->associatedPoints.size();
+template <typename T>
+int BasicHullFace<T>::findEdge(HullPointIndex a, HullPointIndex b) const {
+	for (int i = 0; i < 3; i++) {
+		if (getPoint(i) == a && getPoint((i + 1) % 3) == b) {
+			return i;
+		}
+	}
+
+	return -1;
 }
 
 /**
  * \return The face's edges
  */
-HullEdgeSet HullFace::getEdges() const {
+template <typename T>
+HullEdgeSet BasicHullFace<T>::getEdges() const {
 	HullEdgeSet edges;
 
 	edges.add(HullEdge(this->p0, this->p1));
@@ -62,22 +176,5 @@ HullEdgeSet HullFace::getEdges() const {
 	return edges;
 }
 
-HullPoint HullFace::getFurthestPoint() const {
-	double maxD = 0.0;
-	HullPointSet::const_iterator farthestPoint = associatedPoints.begin();
-
-	for (HullPointSet::const_iterator i = associatedPoints.begin() + 1;
-		i != associatedPoints.end(); i++) {
-		
-		// The determinant d is not actually the distance, but it is directly
-		// proportional to the distance.
-		double d = determinant(this->p2, this->p1, this->p0, *i);
-		
-		if (d >= maxD) {
-			farthestPoint = i;
-			maxD = d;
-		}
-	}
-
-	return *farthestPoint;
-}
\ No newline at end of file
+template class BasicHullFace<double>;
+template class BasicHullFace<float>;
@@ -0,0 +1,184 @@
+/**
+ * \file HullFaceScheduler.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the HullFaceScheduler class
+ */
+
+#include "HullFaceScheduler.h"
+
+using namespace peek;
+
+const size_t HullFaceScheduler::NOT_SCHEDULED;
+
+/**
+ * \param policy The order in which to hand out faces
+ */
+HullFaceScheduler::HullFaceScheduler(Policy policy) {
+	this->policy = policy;
+	this->head = 0;
+}
+
+/**
+ * \param face The face, which must not already be scheduled
+ * \param distance How far the face's furthest point is from it.  (Only
+ *   used by the FURTHEST_FIRST policy.)
+ */
+void HullFaceScheduler::schedule(HullFaceIndex face, double distance) {
+	if (face >= this->positions.size()) {
+		this->positions.resize(face + 1, NOT_SCHEDULED);
+	}
+
+	this->positions[face] = this->faces.size();
+	this->faces.push_back(face);
+
+	if (this->policy == FURTHEST_FIRST) {
+		this->distances.push_back(distance);
+		siftUp(this->faces.size() - 1);
+	}
+}
+
+/**
+ * Unscheduling is O(log h) for the heap.  The lists simply forget the face,
+ * and skip over its entry when they reach it.  If the face's slot is reused
+ * and scheduled again before then, the new face may be handed out early,
+ * which does no harm.
+ *
+ * \param face The face
+ */
+void HullFaceScheduler::unschedule(HullFaceIndex face) {
+	if (face >= this->positions.size() || this->positions[face] == NOT_SCHEDULED) {
+		return;
+	}
+
+	if (this->policy == FURTHEST_FIRST) {
+		size_t i = this->positions[face];
+		size_t last = this->faces.size() - 1;
+
+		swapEntries(i, last);
+		this->faces.pop_back();
+		this->distances.pop_back();
+
+		if (i < last) {
+			siftUp(i);
+			siftDown(i);
+		}
+	}
+
+	this->positions[face] = NOT_SCHEDULED;
+}
+
+/**
+ * \return The next face, or NO_HULL_FACE if none are scheduled
+ */
+HullFaceIndex HullFaceScheduler::next() {
+	if (this->policy == FURTHEST_FIRST) {
+		if (this->faces.empty()) {
+			return NO_HULL_FACE;
+		}
+
+		HullFaceIndex face = this->faces[0];
+		unschedule(face);
+		return face;
+	}
+
+	while (this->head < this->faces.size()) {
+		HullFaceIndex face;
+
+		if (this->policy == FIRST_IN_FIRST_OUT) {
+			face = this->faces[this->head++];
+
+			// Drop the entries already handed out once they make up most of
+			// the list, so that it doesn't grow without bound.
+			if (this->head >= 1024 && 2 * this->head >= this->faces.size()) {
+				this->faces.erase(this->faces.begin(), this->faces.begin() + this->head);
+				this->head = 0;
+			}
+		}
+		else {
+			face = this->faces.back();
+			this->faces.pop_back();
+		}
+
+		if (this->positions[face] != NOT_SCHEDULED) {
+			this->positions[face] = NOT_SCHEDULED;
+			return face;
+		}
+	}
+
+	// Everything has been handed out, so the list can start over.
+	this->faces.clear();
+	this->head = 0;
+	return NO_HULL_FACE;
+}
+
+/**
+ * \return Whether or not any faces are scheduled.  For the lists this may
+ *   be true even though every remaining entry has been unscheduled, in which
+ *   case next() returns NO_HULL_FACE.
+ */
+bool HullFaceScheduler::isEmpty() const {
+	return this->head >= this->faces.size();
+}
+
+void HullFaceScheduler::clear() {
+	this->faces.clear();
+	this->distances.clear();
+	this->positions.clear();
+	this->head = 0;
+}
+
+/**
+ * \param i The position of the entry
+ */
+void HullFaceScheduler::siftUp(size_t i) {
+	while (i > 0) {
+		size_t parent = (i - 1) / 2;
+
+		if (this->distances[parent] >= this->distances[i]) {
+			return;
+		}
+
+		swapEntries(i, parent);
+		i = parent;
+	}
+}
+
+/**
+ * \param i The position of the entry
+ */
+void HullFaceScheduler::siftDown(size_t i) {
+	size_t size = this->faces.size();
+
+	for (;;) {
+		size_t largest = i;
+		size_t left = 2 * i + 1;
+		size_t right = left + 1;
+
+		if (left < size && this->distances[left] > this->distances[largest]) {
+			largest = left;
+		}
+
+		if (right < size && this->distances[right] > this->distances[largest]) {
+			largest = right;
+		}
+
+		if (largest == i) {
+			return;
+		}
+
+		swapEntries(i, largest);
+		i = largest;
+	}
+}
+
+/**
+ * \param i The position of the first entry
+ * \param j The position of the second entry
+ */
+void HullFaceScheduler::swapEntries(size_t i, size_t j) {
+	std::swap(this->faces[i], this->faces[j]);
+	std::swap(this->distances[i], this->distances[j]);
+	this->positions[this->faces[i]] = i;
+	this->positions[this->faces[j]] = j;
+}
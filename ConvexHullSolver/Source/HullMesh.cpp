@@ -0,0 +1,90 @@
+/**
+ * \file HullMesh.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the BasicHullMesh class template
+ */
+
+#include "HullMesh.h"
+
+using namespace peek;
+
+
+template <typename T>
+BasicHullMesh<T>::BasicHullMesh() {}
+
+/**
+ * \param face The face to add
+ * \return The index of the new face
+ */
+template <typename T>
+HullFaceIndex BasicHullMesh<T>::addFace(const Face &face) {
+	if (!this->freeFaces.empty()) {
+		HullFaceIndex index = this->freeFaces.back();
+		this->freeFaces.pop_back();
+		this->faces[index] = face;
+		this->live[index] = 1;
+		return index;
+	}
+
+	this->faces.push_back(face);
+	this->live.push_back(1);
+	return (HullFaceIndex) (this->faces.size() - 1);
+}
+
+/**
+ * The face's slot is released for reuse.  Its neighbors are not updated; the
+ * caller is expected to re-link them.
+ *
+ * \param face The face to remove
+ */
+template <typename T>
+void BasicHullMesh<T>::removeFace(HullFaceIndex face) {
+	this->faces[face] = Face();
+	this->live[face] = 0;
+	this->freeFaces.push_back(face);
+}
+
+/**
+ * \param face0 The first face
+ * \param edge0 The edge of the first face that is shared
+ * \param face1 The second face
+ * \param edge1 The edge of the second face that is shared
+ */
+template <typename T>
+void BasicHullMesh<T>::link(HullFaceIndex face0, int edge0, HullFaceIndex face1, int edge1) {
+	this->faces[face0].setNeighbor(edge0, face1);
+	this->faces[face1].setNeighbor(edge1, face0);
+}
+
+/**
+ * The copies carry only the faces' points; their associated points and
+ * neighbors are internal to the mesh, and so is their plane, which is why
+ * they are the same type whatever T is.
+ *
+ * \return The faces
+ */
+template <typename T>
+HullFaceList BasicHullMesh<T>::getFaces() const {
+	HullFaceList result;
+	result.reserve(getNumFaces());
+
+	for (HullFaceIndex i = 0; i < getCapacity(); i++) {
+		if (isLive(i)) {
+			const Face &face = this->faces[i];
+			result.push_back(HullFace(face.getP0(), face.getP1(), face.getP2()));
+		}
+	}
+
+	return result;
+}
+
+template <typename T>
+void BasicHullMesh<T>::clear() {
+	this->faces.clear();
+	this->live.clear();
+	this->freeFaces.clear();
+}
+
+template class BasicHullMesh<double>;
+template class BasicHullMesh<float>;
@@ -0,0 +1,250 @@
+/**
+ * \file HullPointBuffer.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the BasicHullPointBuffer class template
+ */
+
+#include "HullPointBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace peek;
+
+
+template <typename T>
+BasicHullPointBuffer<T>::BasicHullPointBuffer() {
+	this->owning = true;
+	this->count = 0;
+	this->stride = 1;
+	bindOwned();
+}
+
+/**
+ * \param points The points to copy into the buffer
+ */
+template <typename T>
+BasicHullPointBuffer<T>::BasicHullPointBuffer(const Point3dSet &points) {
+	this->owning = true;
+	this->count = 0;
+	this->stride = 1;
+	this->ownedX.reserve(points.size());
+	this->ownedY.reserve(points.size());
+	this->ownedZ.reserve(points.size());
+
+	for (Point3dSet::const_iterator i = points.begin(); i != points.end(); i++) {
+		add((T) (*i).x, (T) (*i).y, (T) (*i).z);
+	}
+}
+
+/**
+ * No coordinates are copied; the buffer only remembers where they are.
+ *
+ * \param x The x-coordinates
+ * \param y The y-coordinates
+ * \param z The z-coordinates
+ * \param size The number of points
+ * \param stride The number of Ts from one point to the next in each array
+ */
+template <typename T>
+BasicHullPointBuffer<T>::BasicHullPointBuffer(const T *x, const T *y, const T *z, size_t size, size_t stride) {
+	this->owning = false;
+	this->x = x;
+	this->y = y;
+	this->z = z;
+	this->count = size;
+	this->stride = stride;
+}
+
+/**
+ * No coordinates are copied.  The points are records of byteStride bytes
+ * each, starting at data, with the coordinates at the given offsets within
+ * each record; this fits vertex buffers where the position is stored among
+ * other attributes.  The stride and offsets must be multiples of sizeof(T),
+ * and data must be aligned for T.
+ *
+ * \param data The first record
+ * \param size The number of points
+ * \param byteStride The number of bytes from one record to the next
+ * \param xOffset The offset of the x-coordinate within a record, in bytes
+ * \param yOffset The offset of the y-coordinate within a record, in bytes
+ * \param zOffset The offset of the z-coordinate within a record, in bytes
+ */
+template <typename T>
+BasicHullPointBuffer<T>::BasicHullPointBuffer(const void *data, size_t size, size_t byteStride,
+	size_t xOffset, size_t yOffset, size_t zOffset) {
+
+	this->owning = false;
+	this->x = (const T *) ((const char *) data + xOffset);
+	this->y = (const T *) ((const char *) data + yOffset);
+	this->z = (const T *) ((const char *) data + zOffset);
+	this->count = size;
+	this->stride = byteStride / sizeof(T);
+}
+
+/**
+ * \param rArg The buffer to copy.  If it refers to someone else's arrays, so
+ *   will the copy.
+ */
+template <typename T>
+BasicHullPointBuffer<T>::BasicHullPointBuffer(const BasicHullPointBuffer &rArg) {
+	*this = rArg;
+}
+
+/**
+ * \param rArg The buffer to copy.  If it refers to someone else's arrays, so
+ *   will this one.
+ * \return This buffer
+ */
+template <typename T>
+BasicHullPointBuffer<T> &BasicHullPointBuffer<T>::operator=(const BasicHullPointBuffer &rArg) {
+	if (this == &rArg) {
+		return *this;
+	}
+
+	this->owning = rArg.owning;
+	this->count = rArg.count;
+	this->stride = rArg.stride;
+
+	if (this->owning) {
+		this->ownedX = rArg.ownedX;
+		this->ownedY = rArg.ownedY;
+		this->ownedZ = rArg.ownedZ;
+		bindOwned();
+	}
+	else {
+		this->ownedX.clear();
+		this->ownedY.clear();
+		this->ownedZ.clear();
+		this->x = rArg.x;
+		this->y = rArg.y;
+		this->z = rArg.z;
+	}
+
+	return *this;
+}
+
+/**
+ * A buffer that refers to arrays owned by the caller first takes a packed
+ * copy of them, as append() does.
+ *
+ * \param capacity The number of points to make room for
+ */
+template <typename T>
+void BasicHullPointBuffer<T>::reserve(size_t capacity) {
+	makeOwning();
+	this->ownedX.reserve(capacity);
+	this->ownedY.reserve(capacity);
+	this->ownedZ.reserve(capacity);
+	bindOwned();
+}
+
+/**
+ * A buffer that refers to arrays owned by the caller first takes a packed
+ * copy of them, as append() does.
+ *
+ * \param x The x-coordinate of the point
+ * \param y The y-coordinate of the point
+ * \param z The z-coordinate of the point
+ * \return The index of the new point
+ */
+template <typename T>
+HullPointIndex BasicHullPointBuffer<T>::add(T x, T y, T z) {
+	makeOwning();
+	this->ownedX.push_back(x);
+	this->ownedY.push_back(y);
+	this->ownedZ.push_back(z);
+	bindOwned();
+
+	return (HullPointIndex) (this->count++);
+}
+
+/**
+ * A buffer that refers to arrays owned by the caller first takes a packed
+ * copy of them, and owns its arrays from then on.  The indices of the
+ * points already in the buffer don't change, and the new points follow
+ * them in order.
+ *
+ * \param points The points to add
+ */
+template <typename T>
+void BasicHullPointBuffer<T>::append(const BasicHullPointBuffer &points) {
+	size_t numPoints = points.count;
+
+	makeOwning();
+
+	// With the room made up front, adding the points can't move the arrays
+	// they are read from, even if they are this buffer's own.  The room
+	// grows geometrically, so that appending a few points at a time to a
+	// large buffer doesn't copy the whole buffer every time.
+	if (this->ownedX.capacity() < this->count + numPoints) {
+		reserve(std::max(this->count + numPoints, 2 * this->count));
+	}
+
+	for (size_t i = 0; i < numPoints; i++) {
+		this->ownedX.push_back(points.getX((HullPointIndex) i));
+		this->ownedY.push_back(points.getY((HullPointIndex) i));
+		this->ownedZ.push_back(points.getZ((HullPointIndex) i));
+	}
+
+	bindOwned();
+	this->count += numPoints;
+}
+
+/**
+ * This makes a pass over every point, so callers should hold on to the
+ * result rather than asking for it repeatedly.  The sum is taken in double,
+ * so that it isn't rounded down below the true magnitude of float points.
+ *
+ * \return The magnitude
+ */
+template <typename T>
+double BasicHullPointBuffer<T>::getMagnitude() const {
+	double magnitude = 0.0;
+
+	for (size_t i = 0; i < this->count; i++) {
+		double m = fabs((double) getX((HullPointIndex) i)) + fabs((double) getY((HullPointIndex) i))
+			+ fabs((double) getZ((HullPointIndex) i));
+
+		if (m > magnitude) {
+			magnitude = m;
+		}
+	}
+
+	return magnitude;
+}
+
+/**
+ * Does nothing to a buffer that already owns its arrays.  The indices of
+ * the points don't change.
+ */
+template <typename T>
+void BasicHullPointBuffer<T>::makeOwning() {
+	if (this->owning) {
+		return;
+	}
+
+	this->ownedX.resize(this->count);
+	this->ownedY.resize(this->count);
+	this->ownedZ.resize(this->count);
+
+	for (size_t i = 0; i < this->count; i++) {
+		this->ownedX[i] = getX((HullPointIndex) i);
+		this->ownedY[i] = getY((HullPointIndex) i);
+		this->ownedZ[i] = getZ((HullPointIndex) i);
+	}
+
+	this->owning = true;
+	this->stride = 1;
+	bindOwned();
+}
+
+template <typename T>
+void BasicHullPointBuffer<T>::bindOwned() {
+	this->x = this->ownedX.empty() ? NULL : &this->ownedX[0];
+	this->y = this->ownedY.empty() ? NULL : &this->ownedY[0];
+	this->z = this->ownedZ.empty() ? NULL : &this->ownedZ[0];
+}
+
+template class BasicHullPointBuffer<double>;
+template class BasicHullPointBuffer<float>;
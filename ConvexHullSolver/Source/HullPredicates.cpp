@@ -0,0 +1,440 @@
+/**
+ * \file HullPredicates.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the HullPredicates class
+ *
+ * The exact arithmetic follows Jonathan Shewchuk, "Adaptive Precision
+ * Floating-Point Arithmetic and Fast Robust Geometric Predicates" (1997).
+ * A number is represented as an expansion: a sum of doubles that don't
+ * overlap, stored in order of increasing magnitude, whose sign is the sign
+ * of its last (largest) component.  This relies on strict IEEE double
+ * arithmetic, so it must not be compiled with x87 extended precision or
+ * with floating-point contraction into fused multiply-adds.
+ */
+
+#include "HullPredicates.h"
+#include <cmath>
+
+namespace {
+
+	/** Half the distance between 1.0 and the next larger double, 2^-53 */
+	const double epsilon = 1.1102230246251565e-16;
+
+	/** Used to split a double into two halves of 26 significant bits */
+	const double splitter = 134217729.0;
+
+	/** Relative error bound of the floating-point orientation */
+	const double orientationErrorBound = (7.0 + 56.0 * epsilon) * epsilon;
+
+	/** Relative error bound of the floating-point 2-D orientation */
+	const double orientation2dErrorBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+	/** The most components a product of three expansions can need here */
+	const int MAX_EXPANSION = 256;
+
+	/** Computes a - b as x + y exactly */
+	inline void twoDiff(double a, double b, double &x, double &y) {
+		x = a - b;
+		double bVirtual = a - x;
+		double aVirtual = x + bVirtual;
+		double bRoundoff = bVirtual - b;
+		double aRoundoff = a - aVirtual;
+		y = aRoundoff + bRoundoff;
+	}
+
+	/** Computes a + b as x + y exactly */
+	inline void twoSum(double a, double b, double &x, double &y) {
+		x = a + b;
+		double bVirtual = x - a;
+		double aVirtual = x - bVirtual;
+		double bRoundoff = b - bVirtual;
+		double aRoundoff = a - aVirtual;
+		y = aRoundoff + bRoundoff;
+	}
+
+	/** Splits a into two halves, each with at most 26 significant bits */
+	inline void split(double a, double &hi, double &lo) {
+		double c = splitter * a;
+		double aBig = c - a;
+		hi = c - aBig;
+		lo = a - hi;
+	}
+
+	/** Computes a * b as x + y exactly */
+	inline void twoProduct(double a, double b, double &x, double &y) {
+		x = a * b;
+		double aHi, aLo, bHi, bLo;
+		split(a, aHi, aLo);
+		split(b, bHi, bLo);
+		double err1 = x - (aHi * bHi);
+		double err2 = err1 - (aLo * bHi);
+		double err3 = err2 - (aHi * bLo);
+		y = (aLo * bLo) - err3;
+	}
+
+	/**
+	 * Adds a double to an expansion, dropping zero components
+	 *
+	 * \return The length of the result, which may be written over e
+	 */
+	int growExpansion(int eLength, const double *e, double b, double *h) {
+		int hLength = 0;
+		double q = b;
+
+		for (int i = 0; i < eLength; i++) {
+			double sum, roundoff;
+			twoSum(q, e[i], sum, roundoff);
+			q = sum;
+
+			if (roundoff != 0.0) {
+				h[hLength++] = roundoff;
+			}
+		}
+
+		if (q != 0.0 || hLength == 0) {
+			h[hLength++] = q;
+		}
+
+		return hLength;
+	}
+
+	/**
+	 * Adds two expansions
+	 *
+	 * \return The length of the result
+	 */
+	int sumExpansions(int eLength, const double *e, int fLength, const double *f, double *h) {
+		for (int i = 0; i < eLength; i++) {
+			h[i] = e[i];
+		}
+
+		int hLength = eLength;
+
+		for (int i = 0; i < fLength; i++) {
+			hLength = growExpansion(hLength, h, f[i], h);
+		}
+
+		return hLength;
+	}
+
+	/**
+	 * Multiplies an expansion by a double
+	 *
+	 * \return The length of the result
+	 */
+	int scaleExpansion(int eLength, const double *e, double b, double *h) {
+		int hLength = 0;
+		double q, product, productRoundoff, sum, roundoff;
+
+		twoProduct(e[0], b, q, roundoff);
+
+		if (roundoff != 0.0) {
+			h[hLength++] = roundoff;
+		}
+
+		for (int i = 1; i < eLength; i++) {
+			twoProduct(e[i], b, product, productRoundoff);
+			twoSum(q, productRoundoff, sum, roundoff);
+
+			if (roundoff != 0.0) {
+				h[hLength++] = roundoff;
+			}
+
+			twoSum(product, sum, q, roundoff);
+
+			if (roundoff != 0.0) {
+				h[hLength++] = roundoff;
+			}
+		}
+
+		if (q != 0.0 || hLength == 0) {
+			h[hLength++] = q;
+		}
+
+		return hLength;
+	}
+
+	/**
+	 * Multiplies two expansions
+	 *
+	 * \return The length of the result
+	 */
+	int multiplyExpansions(int eLength, const double *e, int fLength, const double *f, double *h) {
+		double term[MAX_EXPANSION];
+		double sum[MAX_EXPANSION];
+		int hLength = 0;
+
+		for (int i = 0; i < fLength; i++) {
+			int termLength = scaleExpansion(eLength, e, f[i], term);
+			hLength = sumExpansions(hLength, h, termLength, term, sum);
+
+			for (int j = 0; j < hLength; j++) {
+				h[j] = sum[j];
+			}
+		}
+
+		return hLength;
+	}
+
+	/** Gets a point's coordinate along the given axis (0, 1 or 2) */
+	template <typename T>
+	inline double coordinate(const BasicHullPointBuffer<T> &points, HullPointIndex p, int axis) {
+		switch (axis) {
+			case 0: return points.getX(p);
+			case 1: return points.getY(p);
+			default: return points.getZ(p);
+		}
+	}
+
+	/** Gets the sign of an expansion */
+	inline int sign(int eLength, const double *e) {
+		double top = e[eLength - 1];
+		return (top > 0.0) ? 1 : ((top < 0.0) ? -1 : 0);
+	}
+
+	/**
+	 * Computes a * (b * c - d * e) exactly, where each argument is a
+	 * two-component expansion
+	 *
+	 * \return The length of the result
+	 */
+	int tripleTerm(const double *a, const double *b, const double *c,
+		const double *d, const double *e, double *h) {
+
+		double bc[8], de[8], difference[16];
+		int bcLength = multiplyExpansions(2, b, 2, c, bc);
+		int deLength = multiplyExpansions(2, d, 2, e, de);
+
+		for (int i = 0; i < deLength; i++) {
+			de[i] = -de[i];
+		}
+
+		int differenceLength = sumExpansions(bcLength, bc, deLength, de, difference);
+		return multiplyExpansions(differenceLength, difference, 2, a, h);
+	}
+
+}
+
+HullPredicateStatistics::HullPredicateStatistics() {
+	this->planeTests = 0;
+	this->filteredTests = 0;
+	this->exactTests = 0;
+}
+
+/**
+ * \param rArg The counts to add
+ * \return These counts
+ */
+HullPredicateStatistics &HullPredicateStatistics::operator+=(const HullPredicateStatistics &rArg) {
+	this->planeTests += rArg.planeTests;
+	this->filteredTests += rArg.filteredTests;
+	this->exactTests += rArg.exactTests;
+	return *this;
+}
+
+/**
+ * The orientation is first computed in ordinary floating point, along with
+ * a bound on its error.  Only if the result is within the bound of zero is
+ * it recomputed with exact arithmetic, which almost never happens except for
+ * points that really are (nearly) coplanar.
+ *
+ * \param points The buffer holding the points
+ * \param p0 The first point on the plane
+ * \param p1 The second point on the plane
+ * \param p2 The third point on the plane
+ * \param p The point to test
+ * \param statistics If not NULL, receives counts of the stages reached
+ * \return 1 if p is in front of the triangle p0 p1 p2 (the triangle appears
+ *   counter-clockwise as seen from p), -1 if it is behind, and 0 if the
+ *   four points are coplanar
+ */
+template <typename T>
+int HullPredicates::orientation(const BasicHullPointBuffer<T> &points,
+	HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, HullPointIndex p,
+	HullPredicateStatistics *statistics) {
+
+	if (statistics != NULL) {
+		statistics->filteredTests++;
+	}
+
+	double ux = (double) points.getX(p1) - points.getX(p0);
+	double uy = (double) points.getY(p1) - points.getY(p0);
+	double uz = (double) points.getZ(p1) - points.getZ(p0);
+	double vx = (double) points.getX(p2) - points.getX(p0);
+	double vy = (double) points.getY(p2) - points.getY(p0);
+	double vz = (double) points.getZ(p2) - points.getZ(p0);
+	double wx = (double) points.getX(p) - points.getX(p0);
+	double wy = (double) points.getY(p) - points.getY(p0);
+	double wz = (double) points.getZ(p) - points.getZ(p0);
+
+	double uyvz = uy * vz, uzvy = uz * vy;
+	double uzvx = uz * vx, uxvz = ux * vz;
+	double uxvy = ux * vy, uyvx = uy * vx;
+
+	double det = wx * (uyvz - uzvy) + wy * (uzvx - uxvz) + wz * (uxvy - uyvx);
+	double permanent = fabs(wx) * (fabs(uyvz) + fabs(uzvy))
+		+ fabs(wy) * (fabs(uzvx) + fabs(uxvz))
+		+ fabs(wz) * (fabs(uxvy) + fabs(uyvx));
+	double errorBound = orientationErrorBound * permanent;
+
+	if (det > errorBound) {
+		return 1;
+	}
+
+	if (-det > errorBound) {
+		return -1;
+	}
+
+	if (statistics != NULL) {
+		statistics->exactTests++;
+	}
+
+	return exactOrientation(points, p0, p1, p2, p);
+}
+
+/**
+ * \param points The buffer holding the points
+ * \param p0 The first point on the plane
+ * \param p1 The second point on the plane
+ * \param p2 The third point on the plane
+ * \param p The point to test
+ * \return 1 if p is in front of the triangle p0 p1 p2, -1 if it is behind,
+ *   and 0 if the four points are coplanar
+ */
+template <typename T>
+int HullPredicates::exactOrientation(const BasicHullPointBuffer<T> &points,
+	HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, HullPointIndex p) {
+
+	// Each difference is exact as a two-component expansion (tail first).
+	double u[3][2], v[3][2], w[3][2];
+
+	twoDiff(points.getX(p1), points.getX(p0), u[0][1], u[0][0]);
+	twoDiff(points.getY(p1), points.getY(p0), u[1][1], u[1][0]);
+	twoDiff(points.getZ(p1), points.getZ(p0), u[2][1], u[2][0]);
+	twoDiff(points.getX(p2), points.getX(p0), v[0][1], v[0][0]);
+	twoDiff(points.getY(p2), points.getY(p0), v[1][1], v[1][0]);
+	twoDiff(points.getZ(p2), points.getZ(p0), v[2][1], v[2][0]);
+	twoDiff(points.getX(p), points.getX(p0), w[0][1], w[0][0]);
+	twoDiff(points.getY(p), points.getY(p0), w[1][1], w[1][0]);
+	twoDiff(points.getZ(p), points.getZ(p0), w[2][1], w[2][0]);
+
+	// det = wx (uy vz - uz vy) + wy (uz vx - ux vz) + wz (ux vy - uy vx)
+	double termX[MAX_EXPANSION], termY[MAX_EXPANSION], termZ[MAX_EXPANSION];
+	double partial[MAX_EXPANSION], det[MAX_EXPANSION];
+
+	int xLength = tripleTerm(w[0], u[1], v[2], u[2], v[1], termX);
+	int yLength = tripleTerm(w[1], u[2], v[0], u[0], v[2], termY);
+	int zLength = tripleTerm(w[2], u[0], v[1], u[1], v[0], termZ);
+
+	int partialLength = sumExpansions(xLength, termX, yLength, termY, partial);
+	int detLength = sumExpansions(partialLength, partial, zLength, termZ, det);
+
+	return sign(detLength, det);
+}
+
+/**
+ * The two axes that are kept are taken in cyclic order after the dropped
+ * one (y and z when dropping x, z and x when dropping y, x and y when
+ * dropping z), so that counter-clockwise in the projection is
+ * counter-clockwise as seen from the positive end of the dropped axis.
+ *
+ * \param points The buffer holding the points
+ * \param p0 The first point on the line
+ * \param p1 The second point on the line
+ * \param p The point to test
+ * \param dropAxis The coordinate to ignore (0, 1 or 2 for x, y or z)
+ * \param statistics If not NULL, receives counts of the stages reached
+ * \return 1 if p is to the left of the line from p0 to p1 (p0, p1 and p
+ *   are counter-clockwise), -1 if it is to the right, and 0 if the three
+ *   points are collinear in the projection
+ */
+template <typename T>
+int HullPredicates::orientation2d(const BasicHullPointBuffer<T> &points,
+	HullPointIndex p0, HullPointIndex p1, HullPointIndex p, int dropAxis,
+	HullPredicateStatistics *statistics) {
+
+	if (statistics != NULL) {
+		statistics->filteredTests++;
+	}
+
+	int s = (dropAxis + 1) % 3;
+	int t = (dropAxis + 2) % 3;
+
+	double us = coordinate(points, p1, s) - coordinate(points, p0, s);
+	double ut = coordinate(points, p1, t) - coordinate(points, p0, t);
+	double ws = coordinate(points, p, s) - coordinate(points, p0, s);
+	double wt = coordinate(points, p, t) - coordinate(points, p0, t);
+
+	double left = us * wt, right = ut * ws;
+	double det = left - right;
+	double errorBound = orientation2dErrorBound * (fabs(left) + fabs(right));
+
+	if (det > errorBound) {
+		return 1;
+	}
+
+	if (-det > errorBound) {
+		return -1;
+	}
+
+	if (statistics != NULL) {
+		statistics->exactTests++;
+	}
+
+	double u[2][2], w[2][2];
+
+	twoDiff(coordinate(points, p1, s), coordinate(points, p0, s), u[0][1], u[0][0]);
+	twoDiff(coordinate(points, p1, t), coordinate(points, p0, t), u[1][1], u[1][0]);
+	twoDiff(coordinate(points, p, s), coordinate(points, p0, s), w[0][1], w[0][0]);
+	twoDiff(coordinate(points, p, t), coordinate(points, p0, t), w[1][1], w[1][0]);
+
+	// det = us wt - ut ws
+	double uswt[8], utws[8], exact[16];
+	int uswtLength = multiplyExpansions(2, u[0], 2, w[1], uswt);
+	int utwsLength = multiplyExpansions(2, u[1], 2, w[0], utws);
+
+	for (int i = 0; i < utwsLength; i++) {
+		utws[i] = -utws[i];
+	}
+
+	int exactLength = sumExpansions(uswtLength, uswt, utwsLength, utws, exact);
+
+	return sign(exactLength, exact);
+}
+
+/**
+ * \param points The buffer holding the points
+ * \param p0 The first point on the line
+ * \param p1 The second point on the line
+ * \param p The point to test
+ * \param statistics If not NULL, receives counts of the stages reached
+ * \return true if the three points are collinear (which includes any two
+ *   of them coinciding)
+ */
+template <typename T>
+bool HullPredicates::collinear(const BasicHullPointBuffer<T> &points,
+	HullPointIndex p0, HullPointIndex p1, HullPointIndex p,
+	HullPredicateStatistics *statistics) {
+
+	return orientation2d(points, p0, p1, p, 2, statistics) == 0
+		&& orientation2d(points, p0, p1, p, 0, statistics) == 0
+		&& orientation2d(points, p0, p1, p, 1, statistics) == 0;
+}
+
+template int HullPredicates::orientation(const HullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPointIndex, HullPredicateStatistics *);
+template int HullPredicates::orientation(const FloatHullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPointIndex, HullPredicateStatistics *);
+template int HullPredicates::exactOrientation(const HullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPointIndex);
+template int HullPredicates::exactOrientation(const FloatHullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPointIndex);
+template int HullPredicates::orientation2d(const HullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, int, HullPredicateStatistics *);
+template int HullPredicates::orientation2d(const FloatHullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, int, HullPredicateStatistics *);
+template bool HullPredicates::collinear(const HullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPredicateStatistics *);
+template bool HullPredicates::collinear(const FloatHullPointBuffer &,
+	HullPointIndex, HullPointIndex, HullPointIndex, HullPredicateStatistics *);
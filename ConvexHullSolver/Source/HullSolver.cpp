@@ -0,0 +1,52 @@
+/**
+ * \file HullSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the HullSolver interface
+ */
+
+#include "HullSolver.h"
+#include "ChanSolver.h"
+#include "ConvexHullSolver.h"
+#include "DivideAndConquerSolver.h"
+#include "PlanarHullSolver.h"
+
+using namespace peek;
+
+const unsigned int HullSolver::DEFAULT_SEED;
+
+/**
+ * Points that all lie within PlanarHullSolver::DEFAULT_TOLERANCE of a plane
+ * are solved in the plane whatever the algorithm, since the 3-D solvers
+ * would find no hull for them, or a sliver of one at great cost.
+ *
+ * \param algorithm The algorithm to solve with
+ * \param inputPoints The points whose convex hull to find
+ * \param numThreads The number of threads to solve with (0 for one per
+ *   processor)
+ * \param seed The seed of the random order, for RANDOMIZED_INCREMENTAL
+ * \return The solver, which the caller owns
+ */
+HullSolver *HullSolver::create(Algorithm algorithm, const HullPointBuffer &inputPoints, unsigned int numThreads,
+	unsigned int seed) {
+
+	double normal[3];
+
+	if (PlanarHullSolver::fitPlane(inputPoints, normal) <= PlanarHullSolver::DEFAULT_TOLERANCE) {
+		return new PlanarHullSolver(inputPoints, numThreads);
+	}
+
+	switch (algorithm) {
+		case RANDOMIZED_INCREMENTAL: {
+			ConvexHullSolver *solver = new ConvexHullSolver(inputPoints, HullFaceScheduler::FURTHEST_FIRST, 0, numThreads);
+			solver->setRandomOrder(seed);
+			return solver;
+		}
+		case DIVIDE_AND_CONQUER:
+			return new DivideAndConquerSolver(inputPoints, DivideAndConquerSolver::DEFAULT_LEAF_SIZE, numThreads);
+		case OUTPUT_SENSITIVE:
+			return new ChanSolver(inputPoints, numThreads);
+		default:
+			return new ConvexHullSolver(inputPoints, HullFaceScheduler::FURTHEST_FIRST, 0, numThreads);
+	}
+}
@@ -0,0 +1,161 @@
+/**
+ * \file HullThreadPool.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the HullThreadPool class
+ */
+
+#include "HullThreadPool.h"
+#include <boost/bind.hpp>
+
+
+/**
+ * \param numThreads The number of threads, including the one that will call
+ *   run().  At least one is used.
+ */
+HullThreadPool::HullThreadPool(unsigned int numThreads) {
+	this->numThreads = (numThreads > 0) ? numThreads : 1;
+	this->batch = 0;
+	this->numUnfinished = 0;
+	this->stopping = false;
+
+	for (unsigned int i = 0; i < this->numThreads; i++) {
+		this->queues.push_back(new Queue());
+	}
+
+	for (unsigned int i = 1; i < this->numThreads; i++) {
+		this->threads.create_thread(boost::bind(&HullThreadPool::work, this, i));
+	}
+}
+
+HullThreadPool::~HullThreadPool() {
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->stopping = true;
+	}
+
+	this->started.notify_all();
+	this->threads.join_all();
+
+	for (unsigned int i = 0; i < this->numThreads; i++) {
+		delete this->queues[i];
+	}
+}
+
+/**
+ * The tasks are dealt out to the threads' queues in contiguous runs, so that
+ * neighboring tasks tend to run on the same thread.  Tasks may run in any
+ * order, and at the same time as one another.
+ *
+ * \param numTasks The number of tasks
+ * \param task The function to call for each task
+ */
+void HullThreadPool::run(size_t numTasks, const Task &task) {
+	if (numTasks == 0) {
+		return;
+	}
+
+	// With a single thread or a single task, there's nothing to share.
+	if (this->numThreads == 1 || numTasks == 1) {
+		for (size_t i = 0; i < numTasks; i++) {
+			task(i, 0);
+		}
+
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock lock(this->mutex);
+		this->task = task;
+		this->numUnfinished = numTasks;
+
+		for (unsigned int i = 0; i < this->numThreads; i++) {
+			boost::mutex::scoped_lock queueLock(this->queues[i]->mutex);
+
+			for (size_t j = numTasks * i / this->numThreads; j < numTasks * (i + 1) / this->numThreads; j++) {
+				this->queues[i]->tasks.push_back(j);
+			}
+		}
+
+		this->batch++;
+	}
+
+	this->started.notify_all();
+	drain(0);
+
+	boost::mutex::scoped_lock lock(this->mutex);
+
+	while (this->numUnfinished > 0) {
+		this->finished.wait(lock);
+	}
+}
+
+/**
+ * \param thread The thread's number
+ */
+void HullThreadPool::work(unsigned int thread) {
+	unsigned int lastBatch = 0;
+
+	for (;;) {
+		{
+			boost::mutex::scoped_lock lock(this->mutex);
+
+			while (this->batch == lastBatch && !this->stopping) {
+				this->started.wait(lock);
+			}
+
+			if (this->stopping) {
+				return;
+			}
+
+			lastBatch = this->batch;
+		}
+
+		drain(thread);
+	}
+}
+
+/**
+ * \param thread The thread's number
+ */
+void HullThreadPool::drain(unsigned int thread) {
+	size_t taskNumber;
+
+	while (take(thread, taskNumber)) {
+		this->task(taskNumber, thread);
+
+		boost::mutex::scoped_lock lock(this->mutex);
+
+		if (--this->numUnfinished == 0) {
+			this->finished.notify_all();
+		}
+	}
+}
+
+/**
+ * \param thread The thread's number
+ * \param taskNumber Receives the task's number
+ * \return Whether or not there was a task to take
+ */
+bool HullThreadPool::take(unsigned int thread, size_t &taskNumber) {
+	for (unsigned int i = 0; i < this->numThreads; i++) {
+		Queue &queue = *this->queues[(thread + i) % this->numThreads];
+		boost::mutex::scoped_lock lock(queue.mutex);
+
+		if (queue.tasks.empty()) {
+			continue;
+		}
+
+		if (i == 0) {
+			taskNumber = queue.tasks.back();
+			queue.tasks.pop_back();
+		} else {
+			taskNumber = queue.tasks.front();
+			queue.tasks.pop_front();
+		}
+
+		return true;
+	}
+
+	return false;
+}
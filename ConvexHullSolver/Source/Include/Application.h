@@ -17,8 +17,12 @@
 #include <ResizeEventHandler.hpp>
 #include <Engine.hpp>
 #include <GlWrappers.hpp>
-#include "ConvexHullSolver.h"
+#include "HullExporter.h"
 #include "HullFace.h"
+#include "HullPointBuffer.h"
+#include "HullSolver.h"
+#include "MappedPointFile.h"
+#include "TextPointFile.h"
 #include "UiHandler_pre.h"
 
 using namespace peek;
@@ -40,6 +44,12 @@ public:
 
 	void run();
 
+	/** Takes the input points from a point cloud file rather than generating them */
+	bool load(const char *path);
+
+	/** Gets why the point cloud file couldn't be loaded, if it couldn't */
+	inline const string &getLoadError() const { return this->loadError; }
+
 	/** Draws the scene */
 	virtual void draw();
 
@@ -52,6 +62,12 @@ public:
 	/** Iterates the solver to completion */
 	void iterateToCompletion();
 
+	/** Switches to the next solver algorithm and resets the solver */
+	void nextAlgorithm();
+
+	/** Writes the current hull to a file */
+	bool exportHull(const char *path);
+
 	/** Provides access to the screen width */
 	inline int getScreenWidth() { return this->screenWidth; }
 
@@ -73,14 +89,29 @@ protected:
 
 	auto_ptr<UiHandler> uiHandler;
 
-	/** The input points */
+	/** The input points, if they are generated */
 	Point3dSet inputPoints;
 
+	/** The binary file the input points are taken from, if any */
+	auto_ptr<MappedPointFile> inputFile;
+
+	/** The text file the input points are taken from, if any */
+	auto_ptr<TextPointFile> textFile;
+
+	/** Why the point cloud file couldn't be loaded, if it couldn't */
+	string loadError;
+
+	/** The input points as the solver was given them */
+	HullPointBuffer points;
+
+	/** The algorithm the solver uses */
+	HullSolver::Algorithm algorithm;
+
 	/** The convex hull solver */
-	auto_ptr<ConvexHullSolver> solver;
+	auto_ptr<HullSolver> solver;
 
 	/** The current hull */
-	HullFaceSet hull;
+	HullFaceList hull;
 
 	/** The camera rigging */
 	FixedTargetCameraRigging::handle cameraRigging;
@@ -118,3 +149,6 @@ static const int CHSE_INCREASE_LONGITUDE = 5;
 static const int CHSE_RESET = 6;
 static const int CHSE_ITERATE = 7;
 static const int CHSE_ITERATE_TO_COMPLETION = 8;
+static const int CHSE_NEXT_ALGORITHM = 9;
+static const int CHSE_EXPORT_HULL = 10;
+
@@ -0,0 +1,103 @@
+/**
+ * \file BufferedFileWriter.h
+ * \author Douglas W. Paul
+ *
+ * Declares the BufferedFileWriter class
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Writes a file front to back through a large buffer of its own
+ *
+ * Small writes are gathered into the buffer and handed to the C library a
+ * buffer at a time, so writing a value at a time costs little more than
+ * copying it.  Binary values are written little-endian whatever the byte
+ * order of the machine, as PLY and STL files want them.
+ *
+ * A failed write is remembered rather than reported at once, so callers
+ * can write everything and then check close() or isOpen() once.
+ */
+class BufferedFileWriter {
+public:
+
+	/** The size of the buffer unless another is given */
+	static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+	/** Constructor */
+	BufferedFileWriter(const char *path, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+	/** Destructor, which closes the file if it is still open */
+	~BufferedFileWriter();
+
+	/** Gets whether or not the file was opened, and every write so far has succeeded */
+	inline bool isOpen() const { return this->error.empty(); }
+
+	/** Gets why the file couldn't be opened or written, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+	/** Writes bytes */
+	inline void write(const void *data, size_t size) {
+		if (this->used + size <= this->buffer.size()) {
+			memcpy(&this->buffer[this->used], data, size);
+			this->used += size;
+		} else {
+			writeThrough(data, size);
+		}
+	}
+
+	/** Writes a string, without its terminator */
+	inline void write(const char *text) { write(text, strlen(text)); }
+
+	/** Writes a byte */
+	inline void writeUint8(boost::uint8_t value) { write(&value, 1); }
+
+	/** Writes a 16-bit integer, little-endian */
+	void writeUint16(boost::uint16_t value);
+
+	/** Writes a 32-bit integer, little-endian */
+	void writeUint32(boost::uint32_t value);
+
+	/** Writes a float, little-endian */
+	void writeFloat(float value);
+
+	/** Writes a double, little-endian */
+	void writeDouble(double value);
+
+	/** Writes out what is buffered and closes the file */
+	bool close();
+
+private:
+
+	/** The file, or NULL once it is closed */
+	FILE *file;
+
+	/** The bytes not yet written out */
+	vector<char> buffer;
+
+	/** The number of bytes of the buffer in use */
+	size_t used;
+
+	/** Why the file couldn't be opened or written, or empty if it could */
+	string error;
+
+	/** Writes out what is buffered */
+	void flush();
+
+	/** Writes bytes that don't fit in what is left of the buffer */
+	void writeThrough(const void *data, size_t size);
+
+	/** Not copyable */
+	BufferedFileWriter(const BufferedFileWriter &);
+
+	/** Not copyable */
+	BufferedFileWriter &operator=(const BufferedFileWriter &);
+};
@@ -0,0 +1,244 @@
+/**
+ * \file ChanSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the ChanSolver class
+ */
+
+#pragma once
+
+#include <Geometry.hpp>
+#include "HullFace.h"
+#include "HullMesh.h"
+#include "HullPointBuffer.h"
+#include "HullPredicates.h"
+#include "HullSolver.h"
+#include "HullThreadPool.h"
+#include <map>
+#include <memory>
+
+using namespace peek;
+
+/**
+ * Solves the 3D convex hull problem by wrapping the hull around the hulls of
+ * small groups of points, after Chan
+ *
+ * Each round guesses that the hull has at most m vertices.  The points are
+ * cut into groups of m, and the hull of each group is found with
+ * ConvexHullSolver, in parallel.  The groups are cut from the points in
+ * order along a Z-order curve through their bounding box, so that each is
+ * compact.  The hull of all the points is then wrapped a face at a time,
+ * starting from the lowest point: the third corner of the face across each
+ * open edge is the best of the groups' candidates, and each group's
+ * candidate is found by climbing its hull from where the last search ended.
+ * Groups whose bounding spheres are behind the best plane found so far are
+ * skipped.  If the wrap runs past 2m - 4 faces, the guess was too small,
+ * and the next round squares it.
+ *
+ * This is not Chan's O(n log h) bound.  The climb is a walk over the
+ * group's hull rather than a search of a Dobkin-Kirkpatrick hierarchy, so
+ * finding a group's candidate costs O(m) in the worst case rather than
+ * O(log m).  With n / m groups to search for each of up to 2m - 4 faces, a
+ * round costs O(n m) in the worst case, besides the O(n log m) of the
+ * groups' hulls, and the rounds together O(n h^2) for a hull of h vertices.
+ * In practice the walks are short, since each starts where the last one
+ * ended, and most groups are skipped by their bounding spheres.
+ *
+ * The wrap relies on no four points of the hull being coplanar.  If a tie
+ * turns up, the hull is found instead by solving the vertices of the
+ * groups' hulls with ConvexHullSolver, which still leaves out every point
+ * that was inside its group's hull.  Points on a grid, or with many faces
+ * of the hull in common planes, therefore take that path every time.
+ */
+class ChanSolver : public HullSolver {
+public:
+
+	/** The number of points in each group in the first round */
+	static const unsigned int INITIAL_GROUP_SIZE = 1024;
+
+	/** Constructor */
+	ChanSolver(const Point3dSet &inputPoints, unsigned int numThreads = 1);
+
+	/** Constructor */
+	ChanSolver(const HullPointBuffer &inputPoints, unsigned int numThreads = 1);
+
+	/** Iterates once (one round, with a larger guess than the last) */
+	virtual void iterate();
+
+	/** Iterates until the hull is complete */
+	virtual void iterateToCompletion();
+
+	/** Sets the number of threads to solve with */
+	virtual void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to solve with */
+	virtual unsigned int getNumThreads() const { return (unsigned int) this->workers.size(); }
+
+	/** Gets the current hull */
+	virtual HullFaceList getHull() const { return this->hull.getFaces(); }
+
+	/** Provides access to the points that the hull's faces refer to */
+	inline const HullPointBuffer &getPoints() const { return this->points; }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const;
+
+	/**
+	 * Gets the number of dimensions the input spans (3 for a solid hull;
+	 * less if the points are coplanar, collinear or all the same, in which
+	 * case the hull has no faces).  Only meaningful once the hull is complete.
+	 */
+	virtual unsigned int getDimension() const { return this->dimension; }
+
+	/** Gets whether or not the hull is complete */
+	virtual bool isComplete() const { return this->complete; }
+
+	/** Gets the number of points in each group in the latest round */
+	inline unsigned int getGroupSize() const { return this->groupSize; }
+
+	/** Gets whether the hull had to be found from the groups' vertices instead */
+	inline bool isFallback() const { return this->fallback; }
+
+private:
+
+	/** How a wrap ended */
+	enum WrapResult {
+		/** The hull is complete */
+		WRAPPED,
+
+		/** The hull has more vertices than the guess */
+		TOO_LARGE,
+
+		/** The hull has four or more coplanar points */
+		DEGENERATE
+	};
+
+	/** The hull of a group of points, with the neighbors of each vertex */
+	struct Group {
+		/** The hull's vertices (or all of the group's points, if it is flat) */
+		HullPointIndexList vertices;
+
+		/**
+		 * Where each vertex's neighbors start in the neighbor list, and one
+		 * past the last vertex's.  Empty if the group is flat.
+		 */
+		vector<unsigned int> offsets;
+
+		/** The neighbors of each vertex, as positions in the vertex list */
+		vector<unsigned int> neighbors;
+
+		/** The vertex at which the last search ended */
+		unsigned int start;
+
+		/** The center of a sphere that holds the group's points */
+		double center[3];
+
+		/** The radius of that sphere */
+		double radius;
+	};
+
+	typedef vector<Group> GroupList;
+
+	/** An edge of a face of the hull */
+	struct FaceEdge {
+		/** The face */
+		HullFaceIndex face;
+
+		/** The index of the edge within the face */
+		int edge;
+	};
+
+	typedef vector<FaceEdge> FaceEdgeList;
+
+	/** The edge with the given start and end points, if a face has it */
+	typedef std::map<std::pair<HullPointIndex, HullPointIndex>, FaceEdge> FaceEdgeMap;
+
+	/** The scratch space and counters that each thread works with */
+	struct Worker {
+		/** The position in the group's vertex list of each of its points */
+		vector<unsigned int> vertexPositions;
+
+		/** Counts of how often each stage of point classification was reached */
+		HullPredicateStatistics statistics;
+	};
+
+	typedef vector<Worker> WorkerList;
+
+	/** The input points */
+	HullPointBuffer points;
+
+	/** The input points in Z order, from which the groups are cut */
+	HullPointBuffer sorted;
+
+	/** The index in the input of each sorted point */
+	HullPointIndexList order;
+
+	/** The hulls of the groups of the current round */
+	GroupList groups;
+
+	/** The number of points in each group of the current round */
+	unsigned int groupSize;
+
+	/** The group that offered the last face's third corner */
+	size_t lastGroup;
+
+	/** The hull */
+	HullMesh hull;
+
+	/** The edges of the faces wrapped so far */
+	FaceEdgeMap faceEdges;
+
+	/** The edges of the faces wrapped so far that have no neighbor yet */
+	FaceEdgeList openEdges;
+
+	/** One worker per thread */
+	WorkerList workers;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** Whether or not the hull is complete */
+	bool complete;
+
+	/** Whether the hull was found from the groups' vertices */
+	bool fallback;
+
+	/** The number of dimensions the input spans */
+	unsigned int dimension;
+
+	/** Sorts the points into Z order */
+	void sortPoints();
+
+	/** Finds the hull of a group with ConvexHullSolver */
+	void solveGroup(size_t group, unsigned int thread);
+
+	/** Lists the vertices of a group's hull along with their neighbors */
+	void findNeighbors(const HullMesh &mesh, HullPointIndex begin, Group &group, Worker &worker);
+
+	/** Wraps the hull around the groups' hulls */
+	WrapResult wrap();
+
+	/** Adds a wrapped face to the hull */
+	bool addFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2);
+
+	/** Finds the point that makes a face of the hull with the given edge */
+	bool findCandidate(HullPointIndex p0, HullPointIndex p1, HullPointIndex &candidate);
+
+	/** Finds the point of a group that makes the best face with the given edge */
+	bool climb(Group &group, HullPointIndex p0, HullPointIndex p1, HullPointIndex &candidate);
+
+	/** Gets whether all of a group is certain to be behind a plane */
+	bool isBehind(const Group &group, HullPointIndex p0, HullPointIndex p1, HullPointIndex p2) const;
+
+	/** Finds the hull with ConvexHullSolver, from the given points only */
+	void solve(const HullPointBuffer &buffer, const HullPointIndex *pointMap);
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (ChanSolver::*task)(size_t, unsigned int));
+
+	/** Not copyable */
+	ChanSolver(const ChanSolver &);
+
+	/** Not copyable */
+	ChanSolver &operator=(const ChanSolver &);
+};
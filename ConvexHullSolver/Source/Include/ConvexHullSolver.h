@@ -2,51 +2,400 @@
  * \file ConvexHullSolver.h
  * \author Douglas W. Paul
  *
- * Declares the ConvexHullSolver class
+ * Declares the BasicConvexHullSolver class template and its typedefs
  */
 
 #pragma once
 
 #include <Geometry.hpp>
 #include "HullFace.h"
+#include "HullMesh.h"
+#include "HullPointBuffer.h"
+#include "HullFaceScheduler.h"
+#include "HullPredicates.h"
+#include "HullSolver.h"
+#include "HullThreadPool.h"
+#include <memory>
 
 using namespace peek;
 
 /**
  * Solves the 3D convex hull problem
+ *
+ * The points' coordinates and the faces' planes are of type T, double or
+ * float, so points are classified against faces in that type.  The
+ * orientation tests that settle close calls are exact either way.
  */
-class ConvexHullSolver {
+template <typename T>
+class BasicConvexHullSolver : public HullSolver {
 public:
 
+	/** The type of the points' buffer */
+	typedef BasicHullPointBuffer<T> PointBuffer;
+
+	/** The type of the hull's faces */
+	typedef BasicHullFace<T> Face;
+
+	/** The type of the hull's mesh */
+	typedef BasicHullMesh<T> Mesh;
+
 	/** Constructor */
-	ConvexHullSolver(Point3dSet inputPoints);
+	BasicConvexHullSolver(const Point3dSet &inputPoints,
+		HullFaceScheduler::Policy policy = HullFaceScheduler::FURTHEST_FIRST,
+		unsigned int filterDirections = 0, unsigned int numThreads = 1);
+
+	/** Constructor */
+	BasicConvexHullSolver(const PointBuffer &inputPoints,
+		HullFaceScheduler::Policy policy = HullFaceScheduler::FURTHEST_FIRST,
+		unsigned int filterDirections = 0, unsigned int numThreads = 1);
+
+	/** Starts over on new points, reusing the memory of the last solve */
+	void reset(const PointBuffer &inputPoints);
+
+	/** Adds points to a complete hull, to be taken in by iterating again */
+	void insert(const PointBuffer &newPoints);
+
+	/** Removes a point from a complete hull, re-hulling only what it held up */
+	void remove(HullPointIndex p);
 
 	/** Iterates once */
-	void iterate();
+	virtual void iterate();
 
 	/** Iterates until the hull is complete */
-	void iterateToCompletion();
+	virtual void iterateToCompletion();
+
+	/** Sets the number of threads that iterateToCompletion() uses */
+	virtual void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads that iterateToCompletion() uses */
+	virtual unsigned int getNumThreads() const { return (unsigned int) this->workers.size(); }
 
 	/** Gets the current hull */
-	inline HullFaceSet getHull() const { return this->hull; }
+	virtual HullFaceList getHull() const { return this->hull.getFaces(); }
+
+	/** Provides access to the hull's faces along with their adjacency */
+	inline const Mesh &getMesh() const { return this->hull; }
+
+	/** Provides access to the points that the hull's faces refer to */
+	inline const PointBuffer &getPoints() const { return this->points; }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const;
+
+	/**
+	 * Gets the number of dimensions the input spans (3 for a solid hull;
+	 * less if the points are coplanar, collinear or all the same, in which
+	 * case the hull has no faces)
+	 */
+	virtual unsigned int getDimension() const { return this->dimension; }
+
+	/** Gets the fraction of the input discarded by the interior point filter */
+	inline double getCulledFraction() const { return this->culledFraction; }
 
 	/** Gets whether or not the hull is complete */
-	inline bool isComplete() const { return this->complete; }
+	virtual bool isComplete() const { return this->complete; }
+
+	/** Adds the remaining points in a random order drawn from the given seed */
+	void setRandomOrder(unsigned int seed = DEFAULT_SEED);
+
+	/** Gets whether or not points are added in a random order */
+	inline bool isRandomOrder() const { return this->randomOrder; }
+
+	/** Gets the seed of the random order */
+	inline unsigned int getSeed() const { return this->seed; }
+
+	/** Keeps the points inside the hull grouped by the face they lie under, so that points can be removed */
+	void setDynamic();
+
+	/** Gets whether or not the points inside the hull are kept grouped */
+	inline bool isDynamic() const { return this->dynamic; }
+
+	/** Gets whether or not a point has been removed */
+	inline bool isRemoved(HullPointIndex p) const {
+		return p < this->removedPoints.size() && this->removedPoints[p] != 0;
+	}
 
 private:
 
+	/**
+	 * An edge on the boundary between the faces that a new point can see and
+	 * the faces that it cannot
+	 */
+	struct HorizonEdge {
+		/** The points at either end of the edge, as seen from the visible face */
+		HullPointIndex p0, p1;
+
+		/** The face across the edge that the point cannot see */
+		HullFaceIndex face;
+
+		/** The index of the edge within that face */
+		int edge;
+	};
+
+	typedef vector<HorizonEdge> HorizonEdgeList;
+
+	/**
+	 * A face being walked by findVisibleFaces, with the next of its edges to
+	 * cross and how many of its edges remain to be crossed
+	 */
+	struct Visit {
+		HullFaceIndex face;
+		int edge;
+		int remaining;
+	};
+
+	typedef vector<Visit> VisitList;
+
+	/**
+	 * The addition of one point to the hull, from finding the faces it can
+	 * see to handing the points of those faces out to the new ones
+	 */
+	struct Expansion {
+		/** The point being added */
+		HullPointIndex point;
+
+		/** The face with which the point was associated */
+		HullFaceIndex face;
+
+		/** The faces that the point can see */
+		HullFaceIndexList visibleFaces;
+
+		/** The edges around the visible faces, in order */
+		HorizonEdgeList horizon;
+
+		/** The faces that replace the visible ones */
+		HullFaceIndexList newFaces;
+
+		/** The points released by the visible faces */
+		HullPointIndexList orphans;
+
+		/** The new face that each orphan goes to (NO_HULL_FACE if none) */
+		HullFaceIndexList orphanFaces;
+
+		/** How far each orphan is in front of the face it goes to */
+		vector<double> orphanDistances;
+	};
+
+	typedef vector<Expansion> ExpansionList;
+
+	/** A block of an expansion's orphans, classified as one task */
+	struct Chunk {
+		/** The expansion */
+		size_t expansion;
+
+		/** The position of the block's first orphan */
+		size_t begin;
+	};
+
+	typedef vector<Chunk> ChunkList;
+
+	/** The scratch space and counters that each thread works with */
+	struct Worker {
+		/** The search in which each face was last visited by the flood fill */
+		vector<unsigned int> faceVisits;
+
+		/** Whether each face visited in the current search was visible */
+		vector<char> faceVisible;
+
+		/** The current search */
+		unsigned int search;
+
+		/** The points of a block that remain to be classified */
+		HullPointIndexList blockPoints;
+
+		/** The positions of those points among the expansion's orphans */
+		vector<size_t> blockSlots;
+
+		/** The distances of a block of classified points */
+		vector<T> blockDistances;
+
+		/** The mask of a block of classified points */
+		vector<unsigned char> blockMask;
+
+		/** Counts of how often each stage of point classification was reached */
+		HullPredicateStatistics statistics;
+	};
+
+	typedef vector<Worker> WorkerList;
+
+	/** The input points */
+	PointBuffer points;
+
+	/** The largest value of |x| + |y| + |z| over the input points */
+	double magnitude;
+
+	/** The face with which each point is associated (NO_HULL_FACE if none) */
+	HullFaceIndexList pointFaces;
+
+	/** The expansions under way */
+	ExpansionList expansions;
+
+	/** The blocks of orphans awaiting classification */
+	ChunkList chunks;
+
+	/** One worker per thread */
+	WorkerList workers;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** The number of points classified at once */
+	static const size_t BLOCK_SIZE = 1024;
+
+	/** The number of faces per thread to consider at once */
+	static const size_t CANDIDATES_PER_THREAD = 4;
+
+	/** The round in which each face was last claimed by an expansion */
+	vector<unsigned int> faceClaims;
+
+	/** Whether each claimed face was claimed as visible or as horizon */
+	vector<char> faceClaimedVisible;
+
+	/** The current round of parallel expansions */
+	unsigned int round;
+
 	/** The hull */
-	HullFaceSet hull;
+	Mesh hull;
+
+	/** The faces that still have associated points */
+	HullFaceScheduler scheduler;
+
+	/** Whether points are added in a random order rather than the scheduler's */
+	bool randomOrder;
+
+	/** The seed of the random order */
+	unsigned int seed;
+
+	/** The order in which to add the points, if it is random */
+	HullPointIndexList insertionOrder;
+
+	/** The position in insertionOrder of the next point to add */
+	size_t nextInsertion;
+
+	/** Points passed over by a parallel round, to be added before the rest */
+	HullPointIndexList deferredPoints;
+
+	/** The position in deferredPoints of the next point to add */
+	size_t nextDeferred;
 
 	/** Whether or not the hull is complete */
 	bool complete;
 
-	/** Determines the next face to consider */
-	auto_ptr<HullFace> determineNextFaceToConsider();
+	/** The number of dimensions the input spans */
+	unsigned int dimension;
+
+	/** The number of directions used by the interior point filter (0 if none) */
+	unsigned int filterDirections;
+
+	/** The fraction of the input discarded by the interior point filter */
+	double culledFraction;
+
+	/** A point strictly inside the hull, from which points are located */
+	T center[3];
+
+	/** Whether or not the center is known to be strictly inside the hull */
+	bool centered;
+
+	/** The face at which the last walk to locate a point ended */
+	HullFaceIndex walkStart;
+
+	/** Whether or not the points inside the hull are kept grouped by face */
+	bool dynamic;
+
+	/**
+	 * The points filed under each face, which are those inside the hull in
+	 * the face's cone from the center
+	 */
+	vector<HullPointIndexList> faceRegions;
+
+	/** The face under which each point is filed (NO_HULL_FACE if none) */
+	HullFaceIndexList pointRegions;
+
+	/** Points known to be inside the hull that have yet to be filed */
+	HullPointIndexList unfiledPoints;
+
+	/** Whether or not each point has been removed */
+	vector<char> removedPoints;
 
-	/** Adds a point to the hull */
-	void addPointToHull(HullPoint p);
+	/** Determines the next point to add, and a face that it can see */
+	bool determineNextPointToAdd(HullPointIndex &point, HullFaceIndex &face);
 
-	/** Adds faces to the hull */
-	void addFaces(HullPoint p, HullEdgeSet edges, HullPointSet points);
+	/** Builds the initial hull and associates the remaining points with it */
+	void initialize();
+
+	/** Finds a large tetrahedron to start the hull from */
+	unsigned int findInitialSimplex(HullPointIndex simplex[4]);
+
+	/** Finds the face whose cone from the center holds a point */
+	HullFaceIndex locate(HullPointIndex p, Worker &worker);
+
+	/** Same as HullPredicates::orientation(), with NO_HULL_POINT standing for the center */
+	int orientationWithCenter(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, HullPointIndex p,
+		Worker &worker) const;
+
+	/** Picks a center strictly inside the hull, if it can */
+	void recenter();
+
+	/** Files every point inside the hull afresh */
+	void regroup();
+
+	/** Files the points that are waiting to be filed */
+	void fileInteriorPoints();
+
+	/** Files a point inside the hull under a face */
+	void file(HullPointIndex p, HullFaceIndex face);
+
+	/** Removes a vertex by re-hulling the points under the faces around it */
+	bool removeVertex(HullPointIndex p);
+
+	/** Finds the hull of the points that haven't been removed from scratch */
+	void rebuild();
+
+	/** Associates a point with a face */
+	void associate(HullPointIndex p, HullFaceIndex face, double distance);
+
+	/** Schedules a face for consideration if it has associated points */
+	void schedule(HullFaceIndex face);
+
+	/** Adds the furthest points of several faces to the hull at once */
+	void iterateInParallel();
+
+	/** Gets whether an expansion touches no face claimed this round */
+	bool isIndependent(const Expansion &expansion) const;
+
+	/** Claims the faces that an expansion touches for this round */
+	void claim(const Expansion &expansion);
+
+	/** Finds the faces that a point can see, and the horizon around them */
+	void findVisibleFaces(size_t expansion, unsigned int thread);
+
+	/** Gets the signed distance of a point in front of a face */
+	double distanceTo(const Face &face, HullPointIndex p, Worker &worker);
+
+	/** Settles the sign of a distance that was too close to zero to trust */
+	double resolveDistance(const Face &face, HullPointIndex p, double d, Worker &worker);
+
+	/** Gets whether or not the given point can see the given face */
+	bool canSee(HullPointIndex p, HullFaceIndex face, Worker &worker);
+
+	/** Replaces the faces that a point can see with faces joining it to the horizon */
+	void replaceFaces(Expansion &expansion);
+
+	/** Associates the expansions' orphaned points with their new faces */
+	void distributeOrphans();
+
+	/** Classifies a block of orphans against an expansion's new faces */
+	void classifyChunk(size_t chunk, unsigned int thread);
+
+	/** Associates an expansion's classified orphans with their faces */
+	void associateOrphans(size_t expansion, unsigned int thread);
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (BasicConvexHullSolver::*task)(size_t, unsigned int));
 };
+
+/** Solves for the hull of double-precision points */
+typedef BasicConvexHullSolver<double> ConvexHullSolver;
+
+/** Solves for the hull of single-precision points */
+typedef BasicConvexHullSolver<float> FloatConvexHullSolver;
@@ -0,0 +1,303 @@
+/**
+ * \file DivideAndConquerSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the DivideAndConquerSolver class
+ */
+
+#pragma once
+
+#include <Geometry.hpp>
+#include "HullFace.h"
+#include "HullMesh.h"
+#include "HullPointBuffer.h"
+#include "HullPredicates.h"
+#include "HullSolver.h"
+#include "HullThreadPool.h"
+#include <memory>
+
+using namespace peek;
+
+/**
+ * Solves the 3D convex hull problem by divide and conquer
+ *
+ * The points are sorted by x, then y, then z, and cut into runs of at most
+ * the leaf size.  The hull of each run is found with ConvexHullSolver, and
+ * then neighboring hulls are merged in pairs, a level at a time, until a
+ * single hull is left.  The hulls merged at each level are independent of
+ * one another, so they are merged in parallel.
+ *
+ * Two hulls are merged as described by Preparata and Hong: an edge of the
+ * merged hull is found from the lower tangent of the hulls' shadows on the
+ * xy-plane, and a band of new faces is wrapped around both hulls starting
+ * from it, each new face pivoting on an edge of the last one.  The faces
+ * of each hull that the band hides are then removed.  The candidates for
+ * each new face are only the neighbors of the edge's two ends, so a merge
+ * costs time in proportion to the size of the two hulls rather than the
+ * number of points inside them.
+ *
+ * Where points are coplanar, the band can come out folded.  Every merge is
+ * checked, and a merge that fails the check, or that involves a flat hull,
+ * is redone by solving the vertices of both hulls with ConvexHullSolver.
+ */
+class DivideAndConquerSolver : public HullSolver {
+public:
+
+	/** The default number of points in each run */
+	static const unsigned int DEFAULT_LEAF_SIZE = 1024;
+
+	/** Constructor */
+	DivideAndConquerSolver(const Point3dSet &inputPoints,
+		unsigned int leafSize = DEFAULT_LEAF_SIZE, unsigned int numThreads = 1);
+
+	/** Constructor */
+	DivideAndConquerSolver(const HullPointBuffer &inputPoints,
+		unsigned int leafSize = DEFAULT_LEAF_SIZE, unsigned int numThreads = 1);
+
+	/** Destructor */
+	~DivideAndConquerSolver();
+
+	/** Iterates once */
+	virtual void iterate();
+
+	/** Iterates until the hull is complete */
+	virtual void iterateToCompletion();
+
+	/** Sets the number of threads to solve with */
+	virtual void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to solve with */
+	virtual unsigned int getNumThreads() const { return (unsigned int) this->workers.size(); }
+
+	/** Gets the largest number of points in a run */
+	inline unsigned int getLeafSize() const { return this->leafSize; }
+
+	/** Gets the current hull (the faces of every hull solved so far) */
+	virtual HullFaceList getHull() const;
+
+	/** Provides access to the points that the hull's faces refer to */
+	inline const HullPointBuffer &getPoints() const { return this->points; }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const;
+
+	/** Gets the number of merges that were redone with ConvexHullSolver */
+	size_t getNumFallbacks() const;
+
+	/**
+	 * Gets the number of dimensions the input spans (3 for a solid hull;
+	 * less if the points are coplanar, collinear or all the same, in which
+	 * case the hull has no faces).  Only meaningful once the hull is complete.
+	 */
+	virtual unsigned int getDimension() const { return this->dimension; }
+
+	/** Gets whether or not the hull is complete */
+	virtual bool isComplete() const { return this->complete; }
+
+
+private:
+
+	/** The hull of a run of points */
+	struct Part {
+		/** The hull's faces, which refer to the sorted points */
+		HullMesh mesh;
+
+		/** The number of dimensions the run spans */
+		unsigned int dimension;
+
+		/** For a run that spans fewer than 3 dimensions, all of its points */
+		HullPointIndexList points;
+
+		/** The first and last vertex of the hull in sorted order */
+		HullPointIndex first, last;
+	};
+
+	typedef vector<Part *> PartList;
+
+	/** A neighbor of a vertex, with the face whose edge leads to it */
+	struct Candidate {
+		/** The neighbor */
+		HullPointIndex point;
+
+		/** The face with an edge from the vertex to the neighbor */
+		HullFaceIndex face;
+
+		/** The index of that edge within the face */
+		int edge;
+	};
+
+	typedef vector<Candidate> CandidateList;
+
+	/** A face of the band that joins two hulls */
+	struct BandFace {
+		/** The corners: a on the left hull, b on the right, and c on either */
+		HullPointIndex a, b, c;
+
+		/** Whether c is on the left hull */
+		bool left;
+
+		/** The face of c's hull that stays, across the band face's edge on it */
+		HullFaceIndex kept;
+
+		/** The index of the shared edge within the kept face */
+		int keptEdge;
+
+		/** The face of c's hull across the same edge that the band hides */
+		HullFaceIndex hidden;
+
+		/** The index of the shared edge within the hidden face */
+		int hiddenEdge;
+
+		/**
+		 * The band face that covers the kept face's side of the edge instead,
+		 * if the band runs along both sides of it (otherwise -1)
+		 */
+		int twin;
+	};
+
+	typedef vector<BandFace> BandFaceList;
+
+	/** An edge of a hull that the band is glued along */
+	struct LoopEdge {
+		/** The edge's ends, lower first */
+		HullPointIndex p0, p1;
+
+		/** The band face glued along it */
+		int face;
+
+		inline bool operator<(const LoopEdge &other) const {
+			return (this->p0 != other.p0) ? (this->p0 < other.p0) : (this->p1 < other.p1);
+		}
+	};
+
+	typedef vector<LoopEdge> LoopEdgeList;
+
+	/** The scratch space and counters that each thread works with */
+	struct Worker {
+		/** The neighbors of the band's current left and right vertices */
+		CandidateList leftCandidates, rightCandidates;
+
+		/** The band being wrapped */
+		BandFaceList band;
+
+		/** The edges the band is glued along */
+		LoopEdgeList loopEdges;
+
+		/** What a merge does with each face of the left and right hulls */
+		vector<char> leftMarks, rightMarks;
+
+		/** Which edges of each hidden face the band is glued along */
+		vector<unsigned char> leftLoops, rightLoops;
+
+		/** Where each face of a hull went when it was copied */
+		HullFaceIndexList faceMap;
+
+		/** The vertices of a hull */
+		HullPointIndexList vertices;
+
+		/** Counts of how often each stage of point classification was reached */
+		HullPredicateStatistics statistics;
+
+		/** The number of merges redone with ConvexHullSolver */
+		size_t numFallbacks;
+	};
+
+	typedef vector<Worker> WorkerList;
+
+	/** The input points */
+	HullPointBuffer points;
+
+	/** The input points, sorted */
+	HullPointBuffer sorted;
+
+	/** The index in the input of each sorted point */
+	HullPointIndexList order;
+
+	/** A face of each hull that each sorted point is a vertex of */
+	HullFaceIndexList vertexFaces;
+
+	/** The sorted position at which each run starts, and one past the last */
+	vector<HullPointIndex> bounds;
+
+	/** The hulls of the current level */
+	PartList parts;
+
+	/** The largest number of points in a run */
+	unsigned int leafSize;
+
+	/** One worker per thread */
+	WorkerList workers;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** Whether or not the hull is complete */
+	bool complete;
+
+	/** The number of dimensions the input spans */
+	unsigned int dimension;
+
+	/** Sorts the points and cuts them into runs */
+	void initialize();
+
+	/** Sorts the points' indices into order */
+	void sortOrder();
+
+	/** Sorts one stretch of the points' indices */
+	void sortStretch(size_t stretch, unsigned int thread);
+
+	/** Merges two neighboring sorted stretches */
+	void mergeStretches(size_t pair, unsigned int thread);
+
+	/** Finds the hull of a run with ConvexHullSolver */
+	void solveLeaf(size_t leaf, unsigned int thread);
+
+	/** Merges a pair of neighboring hulls of the current level */
+	void mergePair(size_t pair, unsigned int thread);
+
+	/** Merges two hulls by wrapping a band around them */
+	bool wrap(Part &left, Part &right, Worker &worker);
+
+	/** Merges two hulls by solving their vertices with ConvexHullSolver */
+	void solveVertices(Part &left, Part &right, Worker &worker);
+
+	/** Finds the lower tangent of the hulls' shadows on the xy-plane */
+	bool findTangent(const Part &left, const Part &right, HullPointIndex &a, HullPointIndex &b, Worker &worker);
+
+	/** Lists the neighbors of a hull vertex */
+	bool findNeighbors(const HullMesh &mesh, HullPointIndex v, CandidateList &candidates) const;
+
+	/** Pairs up band faces that are glued to both sides of the same edge */
+	bool findTwins(bool left, Worker &worker) const;
+
+	/** Picks the candidate that makes the next face of the band */
+	const Candidate *pickCandidate(HullPointIndex a, HullPointIndex b, HullPointIndex previous,
+		const CandidateList &candidates, bool left, Worker &worker) const;
+
+	/** Gets whether a point beats the best candidate so far */
+	int compareCandidates(HullPointIndex a, HullPointIndex b, HullPointIndex previous,
+		HullPointIndex best, HullPointIndex c, int pivot, Worker &worker) const;
+
+	/** Checks that a face meets its neighbor across an edge without folding */
+	bool isConvexEdge(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, int edge,
+		HullPointIndex opposite, Worker &worker) const;
+
+	/** Marks the faces of a hull that the band hides */
+	bool markHidden(const HullMesh &mesh, bool left, Worker &worker) const;
+
+	/** Lists the vertices of a hull (or all the points of a flat one) */
+	void findVertices(const Part &part, HullPointIndexList &vertices) const;
+
+	/** Copies a hull's faces into another, leaving out marked faces */
+	void copyFaces(const HullMesh &source, const HullPointIndex *pointMap,
+		const vector<char> *marks, HullMesh &target, Worker &worker);
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (DivideAndConquerSolver::*task)(size_t, unsigned int));
+
+	/** Not copyable */
+	DivideAndConquerSolver(const DivideAndConquerSolver &);
+
+	/** Not copyable */
+	DivideAndConquerSolver &operator=(const DivideAndConquerSolver &);
+};
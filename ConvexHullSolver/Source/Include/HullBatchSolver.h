@@ -0,0 +1,122 @@
+/**
+ * \file HullBatchSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the BasicHullBatchSolver class template and its typedefs
+ */
+
+#pragma once
+
+#include "ConvexHullSolver.h"
+#include "HullPointBuffer.h"
+#include "HullPredicates.h"
+#include "HullThreadPool.h"
+#include <memory>
+
+using namespace peek;
+
+/**
+ * Finds the convex hulls of many small sets of points at once
+ *
+ * The sets are consecutive ranges of one buffer of points, marked off by a
+ * list of offsets.  The ranges are handed to the threads in blocks, and
+ * each thread solves its ranges one after another with a single
+ * BasicConvexHullSolver that it resets for each one, so that once the first
+ * few ranges have been solved, the rest allocate next to nothing.  The
+ * faces of all of the hulls go into one packed list of triangles, with a
+ * list of offsets marking off each hull's faces.
+ *
+ * The solvers and the output are kept from one call of solve() to the
+ * next, so a caller that solves a new batch every frame reuses all of that
+ * memory as well.  Ranges that lie in a plane get the two-sided fan of
+ * their polygon, as from PlanarHullSolver, and ranges that lie on a line
+ * or at a point get no faces.
+ */
+template <typename T>
+class BasicHullBatchSolver {
+public:
+
+	/** The type of the points' buffer */
+	typedef BasicHullPointBuffer<T> PointBuffer;
+
+	/** The number of ranges in each block handed to a thread */
+	static const size_t RANGES_PER_TASK = 64;
+
+	/** Constructor */
+	BasicHullBatchSolver(unsigned int numThreads = 1);
+
+	/** Destructor */
+	~BasicHullBatchSolver();
+
+	/** Finds the hull of each range of the points */
+	void solve(const PointBuffer &points, const vector<size_t> &rangeOffsets);
+
+	/** Sets the number of threads to solve with */
+	void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to solve with */
+	inline unsigned int getNumThreads() const { return (unsigned int) this->solvers.size(); }
+
+	/** Gets the number of hulls found by the last call to solve() */
+	inline size_t getNumHulls() const { return this->dimensions.size(); }
+
+	/** Provides access to the corners of every hull's faces, three per face */
+	inline const HullPointIndexList &getTriangles() const { return this->triangles; }
+
+	/** Provides access to where each hull's faces start, and where the last one's end */
+	inline const vector<size_t> &getFaceOffsets() const { return this->faceOffsets; }
+
+	/** Gets the number of faces of a hull */
+	inline size_t getNumFaces(size_t hull) const { return this->faceOffsets[hull + 1] - this->faceOffsets[hull]; }
+
+	/** Gets the number of dimensions that a hull's range spans */
+	inline unsigned int getDimension(size_t hull) const { return this->dimensions[hull]; }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	HullPredicateStatistics getStatistics() const;
+
+private:
+
+	/** The solver of each thread, reset for each range */
+	vector<BasicConvexHullSolver<T> *> solvers;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** The points of the batch being solved */
+	const PointBuffer *points;
+
+	/** Where each range of the batch being solved starts, and where the last one ends */
+	const vector<size_t> *rangeOffsets;
+
+	/** The triangles of each block of ranges */
+	vector<HullPointIndexList> blockTriangles;
+
+	/** The triangles of all of the hulls */
+	HullPointIndexList triangles;
+
+	/** Where each hull's faces start, and where the last one's end */
+	vector<size_t> faceOffsets;
+
+	/** The number of dimensions that each hull's range spans */
+	vector<unsigned int> dimensions;
+
+	/** Solves a block of ranges */
+	void solveBlock(size_t block, unsigned int thread);
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (BasicHullBatchSolver::*task)(size_t, unsigned int));
+
+	/** Not copyable */
+	BasicHullBatchSolver(const BasicHullBatchSolver &);
+
+	/** Not copyable */
+	BasicHullBatchSolver &operator=(const BasicHullBatchSolver &);
+
+};
+
+/** Solves batches of double-precision points */
+typedef BasicHullBatchSolver<double> HullBatchSolver;
+
+/** Solves batches of single-precision points */
+typedef BasicHullBatchSolver<float> FloatHullBatchSolver;
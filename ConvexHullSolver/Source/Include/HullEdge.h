@@ -19,13 +19,13 @@ class HullEdge {
 public:
 
 	/** Constructor */
-	HullEdge(HullPoint p0, HullPoint p1);
+	HullEdge(HullPointIndex p0, HullPointIndex p1);
 
 	/** Gets the first point defining the edge */
-	inline HullPoint getP0() const { return this->p0; }
+	inline HullPointIndex getP0() const { return this->p0; }
 
 	/** Gets the second point defining the edge */
-	inline HullPoint getP1() const { return this->p1; }
+	inline HullPointIndex getP1() const { return this->p1; }
 
 	/** Equality operator */
 	inline bool operator==(const HullEdge &rArg) const {
@@ -36,7 +36,7 @@ public:
 private:
 
 	/** The points that define the edge */
-	HullPoint p0, p1;
+	HullPointIndex p0, p1;
 
 };
 
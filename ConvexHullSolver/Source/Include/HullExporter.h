@@ -0,0 +1,116 @@
+/**
+ * \file HullExporter.h
+ * \author Douglas W. Paul
+ *
+ * Declares the BasicHullExporter class template and its typedefs
+ */
+
+#pragma once
+
+#include "BufferedFileWriter.h"
+#include "HullFace.h"
+#include "HullPointBuffer.h"
+#include <string>
+
+using namespace peek;
+
+/**
+ * Writes a hull out to a binary PLY, binary STL or OBJ file
+ *
+ * The faces' corners are indices into the whole input, most of which is
+ * inside the hull, so the points that are corners are first gathered into
+ * a vertex buffer of their own, each once, in the order of their input
+ * indices.  The triangles are then indices into that buffer, and
+ * getInputIndices() gives the input point behind each vertex, for callers
+ * that keep other data alongside their points.
+ *
+ * PLY and OBJ files share the vertices between triangles.  STL files have
+ * no way to, so each triangle repeats its corners there, along with its
+ * normal.  The files are written through a BufferedFileWriter, so that
+ * writing a vertex at a time costs next to nothing.
+ *
+ * The coordinates are of type T, which is double or float.  PLY files keep
+ * the type of the points; STL files only hold float.
+ */
+template <typename T>
+class BasicHullExporter {
+public:
+
+	/** The type of the points' buffer */
+	typedef BasicHullPointBuffer<T> PointBuffer;
+
+	/** The layout of a file */
+	enum Format {
+		/** Whichever of the others the file name's extension names */
+		AUTO,
+
+		/** Binary little-endian PLY */
+		PLY,
+
+		/** Binary STL */
+		STL,
+
+		/** Wavefront OBJ, which has no binary form */
+		OBJ
+	};
+
+	/** Constructor */
+	BasicHullExporter();
+
+	/** Gathers the vertices of a hull's faces */
+	void setHull(const HullFaceList &faces, const PointBuffer &points);
+
+	/** Gathers the vertices of a hull's triangles, three corners to a face */
+	void setHull(const HullPointIndexList &triangles, const PointBuffer &points);
+
+	/** Provides access to the hull's vertices */
+	inline const PointBuffer &getVertices() const { return this->vertices; }
+
+	/** Provides access to the input point behind each vertex */
+	inline const HullPointIndexList &getInputIndices() const { return this->inputIndices; }
+
+	/** Provides access to the corners of the faces, as indices of vertices, three per face */
+	inline const HullPointIndexList &getTriangles() const { return this->triangles; }
+
+	/** Gets the number of faces */
+	inline size_t getNumFaces() const { return this->triangles.size() / 3; }
+
+	/** Writes the hull to a file */
+	bool write(const char *path, Format format = AUTO,
+		size_t bufferSize = BufferedFileWriter::DEFAULT_BUFFER_SIZE);
+
+	/** Gets why the last file couldn't be written, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+private:
+
+	/** The hull's vertices */
+	PointBuffer vertices;
+
+	/** The input point behind each vertex */
+	HullPointIndexList inputIndices;
+
+	/** The corners of the faces, as indices of vertices */
+	HullPointIndexList triangles;
+
+	/** Why the last file couldn't be written, or empty if it could */
+	string error;
+
+	/** Replaces the corners of the triangles with indices of vertices */
+	void gatherVertices(const PointBuffer &points);
+
+	/** Writes the hull as PLY */
+	void writePly(BufferedFileWriter &writer) const;
+
+	/** Writes the hull as STL */
+	void writeStl(BufferedFileWriter &writer) const;
+
+	/** Writes the hull as OBJ */
+	void writeObj(BufferedFileWriter &writer) const;
+};
+
+/** Exports hulls of double-precision points */
+typedef BasicHullExporter<double> HullExporter;
+
+/** Exports hulls of single-precision points */
+typedef BasicHullExporter<float> FloatHullExporter;
@@ -2,7 +2,7 @@
  * \file HullFace.h
  * \author Douglas W. Paul
  *
- * Declares the HullFace class and associated typedefs
+ * Declares the BasicHullFace class template and associated typedefs
  */
 
 #pragma once
@@ -10,61 +10,155 @@
 #include <Set.hpp>
 #include "HullPoint.h"
 #include "HullEdge.h"
+#include "HullPointBuffer.h"
 
 using namespace peek;
 
+/** Identifies a face within a HullMesh */
+typedef unsigned int HullFaceIndex;
+
+/** Marks the absence of a face (e.g., an unlinked neighbor) */
+static const HullFaceIndex NO_HULL_FACE = (HullFaceIndex) -1;
+
 /**
  * Represents a face of a 3-D hull
+ *
+ * The face's points are indices into the solver's HullPointBuffer, and are
+ * ordered counter-clockwise as seen from outside the hull.  Edge i of the
+ * face runs from point i to point (i + 1) % 3.  Each face also knows which
+ * face lies across each of its edges, so that the hull can be walked from
+ * face to face without searching.
+ *
+ * The plane is kept in the same type T as the coordinates of the points it
+ * is tested against, so that float points are classified in float.
  */
-class HullFace {
+template <typename T>
+class BasicHullFace {
 public:
 
 	/** No-arg constructor */
-	HullFace();
+	BasicHullFace();
 
 	/** Constructor */
-	HullFace(HullPoint p0, HullPoint p1, HullPoint p2);
+	BasicHullFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2);
+
+	/** Constructor that also computes the face's plane */
+	BasicHullFace(HullPointIndex p0, HullPointIndex p1, HullPointIndex p2,
+		const BasicHullPointBuffer<T> &points, double magnitude);
 
 	/** Associates a point with this face */
-	void associate(HullPoint p);
+	void associate(HullPointIndex p, double distance);
 
-	/** Gets the list of associated points */
-	HullPointSet getAssociatedPoints();
+	/** Provides access to the list of associated points */
+	inline const HullPointIndexList &getAssociatedPoints() const { return this->associatedPoints; }
 
 	/** Gets the number of associated points */
-	size_t getNumAssociatedPoints();
+	inline size_t getNumAssociatedPoints() const { return this->associatedPoints.size(); }
+
+	/** Gets the associated point furthest from the face */
+	inline HullPointIndex getFurthestPoint() const { return this->furthestPoint; }
+
+	/** Gets the distance of the furthest associated point from the face */
+	inline double getFurthestDistance() const { return this->furthestDistance; }
+
+	/** Sets the associated point furthest from the face */
+	inline void setFurthestPoint(HullPointIndex p, double distance) {
+		this->furthestPoint = p;
+		this->furthestDistance = distance;
+	}
 
 	/** Gets the first point defining the face */
-	inline HullPoint getP0() const { return p0; }
+	inline HullPointIndex getP0() const { return p0; }
 
 	/** Gets the second point defining the face */
-	inline HullPoint getP1() const { return p1; }
+	inline HullPointIndex getP1() const { return p1; }
 
 	/** Gets the third point defining the face */
-	inline HullPoint getP2() const { return p2; }
+	inline HullPointIndex getP2() const { return p2; }
+
+	/** Gets the point at the given index (0, 1 or 2) */
+	HullPointIndex getPoint(int i) const;
+
+	/** Gets the face across the given edge */
+	inline HullFaceIndex getNeighbor(int edge) const { return this->neighbors[edge]; }
+
+	/** Sets the face across the given edge */
+	inline void setNeighbor(int edge, HullFaceIndex face) { this->neighbors[edge] = face; }
+
+	/** Finds the edge running from point a to point b (-1 if there is none) */
+	int findEdge(HullPointIndex a, HullPointIndex b) const;
 
 	/** Equality operator */
-	inline bool operator==(const HullFace &rArg) const {
+	inline bool operator==(const BasicHullFace &rArg) const {
 		return ((this->p0 == rArg.p0) && (this->p1 == rArg.p1) && (this->p2 == rArg.p2)
 			||  (this->p0 == rArg.p1) && (this->p1 == rArg.p2) && (this->p2 == rArg.p0)
 			||  (this->p0 == rArg.p2) && (this->p1 == rArg.p0) && (this->p2 == rArg.p1));
 	}
 
+	/**
+	 * Gets the signed distance of a point from the face's plane, positive if
+	 * the point is in front of the face.  Only meaningful if the face was
+	 * constructed with its plane.
+	 */
+	inline T distance(const BasicHullPointBuffer<T> &points, HullPointIndex p) const {
+		return this->plane[0] * points.getX(p) + this->plane[1] * points.getY(p)
+			+ this->plane[2] * points.getZ(p) - this->plane[3];
+	}
+
+	/** Gets the face's plane as its unit normal (x, y and z) and offset */
+	inline const T *getPlane() const { return this->plane; }
+
+	/**
+	 * Gets a bound on the error in distance().  A distance whose magnitude is
+	 * no greater than this may have the wrong sign.
+	 */
+	inline T getErrorBound() const { return this->errorBound; }
+
 	/** Gets the face's edges */
 	HullEdgeSet getEdges() const;
 
-	/** Gets the furthest associated point */
-	HullPoint getFurthestPoint() const;
-
 protected:
 
 	/** The points that define the face */
-	HullPoint p0, p1, p2;
+	HullPointIndex p0, p1, p2;
+
+	/**
+	 * The unit normal of the face's plane, followed by the distance of the
+	 * plane from the origin along the normal
+	 */
+	T plane[4];
 
-	/** Points that are associated with this face */
-	HullPointSet associatedPoints;
+	/** The bound on the error in distance() */
+	T errorBound;
+
+	/** The faces across each edge */
+	HullFaceIndex neighbors[3];
+
+	/**
+	 * Points that are associated with this face.  Each point outside the
+	 * hull is associated with exactly one face that it can see; this list
+	 * and the solver's record of each point's face are the two halves of
+	 * the conflict graph.
+	 */
+	HullPointIndexList associatedPoints;
+
+	/** The associated point furthest from the face (NO_HULL_POINT if none) */
+	HullPointIndex furthestPoint;
+
+	/**
+	 * The distance of the furthest point from the face, in whatever units
+	 * were passed to associate()
+	 */
+	double furthestDistance;
 
 };
 
+/** A face whose plane is kept in double precision */
+typedef BasicHullFace<double> HullFace;
+
+/** A face whose plane is kept in single precision */
+typedef BasicHullFace<float> FloatHullFace;
+
 typedef vector<HullFace> HullFaceList;
-typedef Set<HullFace> HullFaceSet;
\ No newline at end of file
+typedef Set<HullFace> HullFaceSet;
+typedef vector<HullFaceIndex> HullFaceIndexList;
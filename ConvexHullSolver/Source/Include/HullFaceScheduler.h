@@ -0,0 +1,94 @@
+/**
+ * \file HullFaceScheduler.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullFaceScheduler class
+ */
+
+#pragma once
+
+#include "HullFace.h"
+
+using namespace peek;
+
+/**
+ * Keeps track of the faces that still have associated points, and decides
+ * which one the solver should consider next
+ *
+ * Faces are referred to by their index in the HullMesh.  Scheduling,
+ * unscheduling and picking the next face never allocate once the internal
+ * arrays have grown to fit the hull.
+ */
+class HullFaceScheduler {
+public:
+
+	/** The order in which scheduled faces are handed out */
+	enum Policy {
+		/** The face whose furthest point is furthest away goes first */
+		FURTHEST_FIRST,
+
+		/** Faces go in the order in which they were scheduled */
+		FIRST_IN_FIRST_OUT,
+
+		/** The most recently scheduled face goes first */
+		LAST_IN_FIRST_OUT
+	};
+
+	/** Constructor */
+	HullFaceScheduler(Policy policy = FURTHEST_FIRST);
+
+	/** Gets the scheduling policy */
+	inline Policy getPolicy() const { return this->policy; }
+
+	/** Schedules a face */
+	void schedule(HullFaceIndex face, double distance);
+
+	/** Unschedules a face that has been removed from the hull */
+	void unschedule(HullFaceIndex face);
+
+	/** Removes and returns the next face to consider */
+	HullFaceIndex next();
+
+	/** Gets whether or not any faces are scheduled */
+	bool isEmpty() const;
+
+	/** Unschedules all faces */
+	void clear();
+
+private:
+
+	/** The scheduling policy */
+	Policy policy;
+
+	/**
+	 * The scheduled faces.  For FURTHEST_FIRST this is a binary max-heap
+	 * ordered by distance; otherwise it is the list of faces in the order
+	 * they were scheduled.
+	 */
+	HullFaceIndexList faces;
+
+	/** The distance of each face in the heap, parallel to faces */
+	vector<double> distances;
+
+	/** The first live entry of the FIFO list */
+	size_t head;
+
+	/**
+	 * For the heap, the position of each face in it.  For the lists, whether
+	 * or not each face is scheduled.  NOT_SCHEDULED if it is not.
+	 */
+	vector<size_t> positions;
+
+	/** The position of a face that is not scheduled */
+	static const size_t NOT_SCHEDULED = (size_t) -1;
+
+	/** Moves a heap entry toward the root until the heap is ordered */
+	void siftUp(size_t i);
+
+	/** Moves a heap entry toward the leaves until the heap is ordered */
+	void siftDown(size_t i);
+
+	/** Swaps two heap entries */
+	void swapEntries(size_t i, size_t j);
+
+};
@@ -0,0 +1,78 @@
+/**
+ * \file HullMesh.h
+ * \author Douglas W. Paul
+ *
+ * Declares the BasicHullMesh class template and its typedefs
+ */
+
+#pragma once
+
+#include "HullFace.h"
+
+using namespace peek;
+
+/**
+ * Stores the faces of a hull along with the adjacency between them
+ *
+ * Faces are kept in a pool and referred to by index, so that a face can name
+ * its neighbors without holding pointers that would be invalidated as the
+ * pool grows.  The slots of removed faces are reused by later faces.
+ */
+template <typename T>
+class BasicHullMesh {
+public:
+
+	/** The type of the faces */
+	typedef BasicHullFace<T> Face;
+
+	/** Constructor */
+	BasicHullMesh();
+
+	/** Adds a face to the mesh */
+	HullFaceIndex addFace(const Face &face);
+
+	/** Removes a face from the mesh */
+	void removeFace(HullFaceIndex face);
+
+	/** Makes two faces neighbors across the given edges */
+	void link(HullFaceIndex face0, int edge0, HullFaceIndex face1, int edge1);
+
+	/** Provides access to a face */
+	inline Face &getFace(HullFaceIndex face) { return this->faces[face]; }
+
+	/** Provides access to a face */
+	inline const Face &getFace(HullFaceIndex face) const { return this->faces[face]; }
+
+	/** Gets whether or not the given slot holds a face */
+	inline bool isLive(HullFaceIndex face) const { return this->live[face] != 0; }
+
+	/** Gets the number of face slots (live or not) */
+	inline HullFaceIndex getCapacity() const { return (HullFaceIndex) this->faces.size(); }
+
+	/** Gets the number of faces in the mesh */
+	inline size_t getNumFaces() const { return this->faces.size() - this->freeFaces.size(); }
+
+	/** Gets a copy of each face in the mesh */
+	HullFaceList getFaces() const;
+
+	/** Removes all faces */
+	void clear();
+
+private:
+
+	/** The face pool */
+	vector<Face> faces;
+
+	/** Whether or not each slot in the pool holds a face */
+	vector<char> live;
+
+	/** Slots that can be reused */
+	HullFaceIndexList freeFaces;
+
+};
+
+/** A mesh of faces whose planes are kept in double precision */
+typedef BasicHullMesh<double> HullMesh;
+
+/** A mesh of faces whose planes are kept in single precision */
+typedef BasicHullMesh<float> FloatHullMesh;
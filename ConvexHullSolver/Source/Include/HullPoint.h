@@ -2,16 +2,23 @@
  * \file HullPoint.h
  * \author Douglas W. Paul
  *
- * Declares the HullPoint typedef and associated typedefs
+ * Declares the HullPointIndex typedef and associated typedefs
  */
 
 #pragma once
 
 #include <Set.hpp>
-#include <Geometry.hpp>
+#include <boost/cstdint.hpp>
 
 using namespace peek;
 
-typedef Point3d HullPoint;
-typedef Point3dList HullPointList;
-typedef Point3dSet HullPointSet;
\ No newline at end of file
+/** Identifies a point by its position in a HullPointBuffer */
+typedef boost::uint32_t HullPointIndex;
+
+/** Marks the absence of a point */
+static const HullPointIndex NO_HULL_POINT = (HullPointIndex) -1;
+
+/** The most points that can be indexed, since NO_HULL_POINT is not an index */
+static const size_t MAX_HULL_POINTS = NO_HULL_POINT;
+
+typedef vector<HullPointIndex> HullPointIndexList;
@@ -0,0 +1,124 @@
+/**
+ * \file HullPointBuffer.h
+ * \author Douglas W. Paul
+ *
+ * Declares the BasicHullPointBuffer class template and its typedefs
+ */
+
+#pragma once
+
+#include <Geometry.hpp>
+#include "HullPoint.h"
+
+using namespace peek;
+
+/**
+ * Holds the coordinates of a set of points as three separate arrays, one
+ * each for x, y and z
+ *
+ * A buffer either owns its arrays, or refers to arrays owned by someone else
+ * so that existing data can be handed to a solver without being converted or
+ * copied.  In the latter case the arrays must outlive the buffer.  The
+ * caller's points need not be packed: each array may have a stride, so
+ * that a buffer can refer to the positions in an interleaved vertex buffer
+ * as easily as to three separate arrays.
+ *
+ * The coordinates are of type T, which is double or float.  Points kept as
+ * float take half the memory and bandwidth; wherever an answer must be
+ * exact, they are widened to double, which represents every float exactly.
+ */
+template <typename T>
+class BasicHullPointBuffer {
+public:
+
+	/** The type of the coordinates */
+	typedef T Scalar;
+
+	/** Constructs an empty buffer that owns its arrays */
+	BasicHullPointBuffer();
+
+	/** Constructs a buffer that owns a copy of the given points */
+	BasicHullPointBuffer(const Point3dSet &points);
+
+	/** Constructs a buffer that refers to arrays owned by the caller */
+	BasicHullPointBuffer(const T *x, const T *y, const T *z, size_t size, size_t stride = 1);
+
+	/** Constructs a buffer that refers to interleaved points owned by the caller */
+	BasicHullPointBuffer(const void *data, size_t size, size_t byteStride,
+		size_t xOffset, size_t yOffset, size_t zOffset);
+
+	/** Copy constructor */
+	BasicHullPointBuffer(const BasicHullPointBuffer &rArg);
+
+	/** Assignment operator */
+	BasicHullPointBuffer &operator=(const BasicHullPointBuffer &rArg);
+
+	/** Makes room in the buffer for the given number of points */
+	void reserve(size_t capacity);
+
+	/** Adds a point to the end of the buffer */
+	HullPointIndex add(T x, T y, T z);
+
+	/** Adds copies of the given points to the end of the buffer */
+	void append(const BasicHullPointBuffer &points);
+
+	/** Gets the number of points */
+	inline size_t size() const { return this->count; }
+
+	/** Gets the x-coordinate of a point */
+	inline T getX(HullPointIndex i) const { return this->x[i * this->stride]; }
+
+	/** Gets the y-coordinate of a point */
+	inline T getY(HullPointIndex i) const { return this->y[i * this->stride]; }
+
+	/** Gets the z-coordinate of a point */
+	inline T getZ(HullPointIndex i) const { return this->z[i * this->stride]; }
+
+	/** Provides access to the x-coordinate array, whose points are getStride() apart */
+	inline const T *getXArray() const { return this->x; }
+
+	/** Provides access to the y-coordinate array, whose points are getStride() apart */
+	inline const T *getYArray() const { return this->y; }
+
+	/** Provides access to the z-coordinate array, whose points are getStride() apart */
+	inline const T *getZArray() const { return this->z; }
+
+	/** Gets the number of Ts from one point to the next in each array */
+	inline size_t getStride() const { return this->stride; }
+
+	/** Gets the largest value of |x| + |y| + |z| over all of the points */
+	double getMagnitude() const;
+
+	/** Gets a copy of a point */
+	inline Point3d getPoint(HullPointIndex i) const { return Point3d(getX(i), getY(i), getZ(i)); }
+
+private:
+
+	/** Storage for buffers that own their coordinates */
+	vector<T> ownedX, ownedY, ownedZ;
+
+	/** The coordinate arrays */
+	const T *x, *y, *z;
+
+	/** The number of points */
+	size_t count;
+
+	/** The number of Ts from one point to the next in each array */
+	size_t stride;
+
+	/** Whether or not the coordinate arrays are ownedX, ownedY and ownedZ */
+	bool owning;
+
+	/** Takes a packed copy of arrays owned by the caller, and owns it from then on */
+	void makeOwning();
+
+	/** Points the coordinate arrays at the owned storage */
+	void bindOwned();
+
+};
+
+/** A buffer of double-precision points */
+typedef BasicHullPointBuffer<double> HullPointBuffer;
+
+/** A buffer of single-precision points */
+typedef BasicHullPointBuffer<float> FloatHullPointBuffer;
@@ -0,0 +1,28 @@
+/**
+ * \file HullPointSource.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullPointSource interface
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * A sequence of points that can be read a block at a time, for input too
+ * large to hold all at once
+ *
+ * Reads may come from a thread other than the one that made the source,
+ * but never from two threads at once.
+ */
+class HullPointSource {
+public:
+
+	/** Destructor */
+	virtual ~HullPointSource() {}
+
+	/** Reads up to the given number of points, returning how many were read (fewer only once the source runs dry) */
+	virtual size_t read(double *x, double *y, double *z, size_t maxPoints) = 0;
+
+};
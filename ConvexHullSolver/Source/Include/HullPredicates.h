@@ -0,0 +1,72 @@
+/**
+ * \file HullPredicates.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullPredicates class and the HullPredicateStatistics struct
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include "HullPointBuffer.h"
+
+/**
+ * Counts how often each stage of point classification is reached
+ */
+struct HullPredicateStatistics {
+
+	/** Constructor */
+	HullPredicateStatistics();
+
+	/** Points tested against a face's plane */
+	boost::uint64_t planeTests;
+
+	/** Tests too close to call from the plane, passed to the filter */
+	boost::uint64_t filteredTests;
+
+	/** Tests too close to call for the filter, evaluated exactly */
+	boost::uint64_t exactTests;
+
+	/** Adds another set of counts to this one */
+	HullPredicateStatistics &operator+=(const HullPredicateStatistics &rArg);
+
+};
+
+/**
+ * Container class for static methods that answer geometric questions about
+ * points exactly
+ *
+ * The methods take buffers of double or float points.  Float coordinates
+ * are widened to double, which holds them exactly, so the answers are just
+ * as exact either way.
+ */
+class HullPredicates {
+public:
+
+	/** Gets which side of the plane through p0, p1 and p2 the point p is on */
+	template <typename T>
+	static int orientation(const BasicHullPointBuffer<T> &points,
+		HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, HullPointIndex p,
+		HullPredicateStatistics *statistics = NULL);
+
+	/** Same as orientation(), but always uses exact arithmetic */
+	template <typename T>
+	static int exactOrientation(const BasicHullPointBuffer<T> &points,
+		HullPointIndex p0, HullPointIndex p1, HullPointIndex p2, HullPointIndex p);
+
+	/**
+	 * Gets which side of the line through p0 and p1 the point p is on, with
+	 * the points projected onto a coordinate plane
+	 */
+	template <typename T>
+	static int orientation2d(const BasicHullPointBuffer<T> &points,
+		HullPointIndex p0, HullPointIndex p1, HullPointIndex p, int dropAxis = 2,
+		HullPredicateStatistics *statistics = NULL);
+
+	/** Gets whether or not the point p is on the line through p0 and p1 */
+	template <typename T>
+	static bool collinear(const BasicHullPointBuffer<T> &points,
+		HullPointIndex p0, HullPointIndex p1, HullPointIndex p,
+		HullPredicateStatistics *statistics = NULL);
+
+};
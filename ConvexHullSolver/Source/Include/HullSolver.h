@@ -0,0 +1,86 @@
+/**
+ * \file HullSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullSolver interface
+ */
+
+#pragma once
+
+#include "HullFace.h"
+#include "HullPointBuffer.h"
+#include "HullPredicates.h"
+
+using namespace peek;
+
+/**
+ * The interface shared by the 3D convex hull solvers, so that callers can
+ * pick whichever algorithm suits their input
+ *
+ * The faces of the hull are indices into the points the solver was given.
+ * Solvers may keep those points as double or float, so it is up to the
+ * caller to hold on to them.
+ */
+class HullSolver {
+public:
+
+	/** The algorithms that create() can pick from */
+	enum Algorithm {
+		/** ConvexHullSolver: adds the furthest point a face at a time */
+		INCREMENTAL,
+
+		/** ConvexHullSolver: adds the points in a seeded random order */
+		RANDOMIZED_INCREMENTAL,
+
+		/** DivideAndConquerSolver: merges the hulls of sorted runs */
+		DIVIDE_AND_CONQUER,
+
+		/** ChanSolver: wraps the hull around the hulls of small groups */
+		OUTPUT_SENSITIVE
+	};
+
+
+
+	/** The seed of the random order unless another is given */
+	static const unsigned int DEFAULT_SEED = 1;
+
+	/** Creates a solver that uses the given algorithm, or PlanarHullSolver if the points are planar */
+	static HullSolver *create(Algorithm algorithm, const HullPointBuffer &inputPoints, unsigned int numThreads = 1,
+		unsigned int seed = DEFAULT_SEED);
+
+
+	/** Destructor */
+	virtual ~HullSolver() {}
+
+	/** Iterates once */
+	virtual void iterate() = 0;
+
+	/** Iterates until the hull is complete */
+	virtual void iterateToCompletion() = 0;
+
+	/** Sets the number of threads to solve with (0 for one per processor) */
+	virtual void setNumThreads(unsigned int numThreads) = 0;
+
+	/** Gets the number of threads to solve with */
+	virtual unsigned int getNumThreads() const = 0;
+
+	/** Gets the current hull */
+	virtual HullFaceList getHull() const = 0;
+
+	/** Gets the outline of a planar hull (empty unless the solver works in the plane) */
+	virtual HullPointIndexList getPolygon() const { return HullPointIndexList(); }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const = 0;
+
+	/**
+	 * Gets the number of dimensions the input spans (3 for a solid hull;
+	 * less if the points are coplanar, collinear or all the same, in which
+	 * case the hull has no faces, unless the solver works in the plane)
+	 */
+	virtual unsigned int getDimension() const = 0;
+
+	/** Gets whether or not the hull is complete */
+	virtual bool isComplete() const = 0;
+
+};
@@ -0,0 +1,97 @@
+/**
+ * \file HullThreadPool.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullThreadPool class
+ */
+
+#pragma once
+
+#include <boost/thread.hpp>
+#include <boost/function.hpp>
+#include <deque>
+#include <vector>
+
+using namespace std;
+
+/**
+ * A fixed set of threads that run batches of tasks
+ *
+ * Each thread has its own queue of tasks.  A thread takes tasks from the
+ * back of its own queue, and when that runs dry, steals them from the front
+ * of the others', so that a thread that drew cheap tasks helps out the
+ * threads that drew expensive ones.  The thread that calls run() takes
+ * part as thread 0.
+ */
+class HullThreadPool {
+public:
+
+	/** A task, given its number within the batch and the thread running it */
+	typedef boost::function<void (size_t task, unsigned int thread)> Task;
+
+	/** Constructor */
+	HullThreadPool(unsigned int numThreads);
+
+	/** Destructor */
+	~HullThreadPool();
+
+	/** Runs a batch of tasks, returning once all of them are done */
+	void run(size_t numTasks, const Task &task);
+
+	/** Gets the number of threads (including the calling thread) */
+	inline unsigned int getNumThreads() const { return this->numThreads; }
+
+private:
+
+	/** A thread's queue of tasks */
+	struct Queue {
+		boost::mutex mutex;
+		deque<size_t> tasks;
+	};
+
+	/** The number of threads (including the calling thread) */
+	unsigned int numThreads;
+
+	/** Each thread's queue */
+	vector<Queue *> queues;
+
+	/** The threads other than the calling thread */
+	boost::thread_group threads;
+
+	/** Guards the fields below */
+	boost::mutex mutex;
+
+	/** Signaled when a batch starts, or when the pool is shutting down */
+	boost::condition_variable started;
+
+	/** Signaled when the last task of a batch finishes */
+	boost::condition_variable finished;
+
+	/** The task being run */
+	Task task;
+
+	/** The number of batches started so far */
+	unsigned int batch;
+
+	/** The number of tasks in the current batch that have not finished */
+	size_t numUnfinished;
+
+	/** Whether or not the threads should exit */
+	bool stopping;
+
+	/** The body of each thread other than the calling thread */
+	void work(unsigned int thread);
+
+	/** Runs tasks until there are none left to take */
+	void drain(unsigned int thread);
+
+	/** Takes a task from a thread's own queue, or steals one from another */
+	bool take(unsigned int thread, size_t &taskNumber);
+
+	/** Not copyable */
+	HullThreadPool(const HullThreadPool &);
+
+	/** Not copyable */
+	HullThreadPool &operator=(const HullThreadPool &);
+
+};
@@ -0,0 +1,63 @@
+/**
+ * \file InteriorPointFilter.h
+ * \author Douglas W. Paul
+ *
+ * Declares the InteriorPointFilter class
+ */
+
+#pragma once
+
+#include "HullPoint.h"
+#include "HullPointBuffer.h"
+
+/**
+ * Discards points that are certainly inside the hull before the solver
+ * sees them (the Akl-Toussaint heuristic)
+ *
+ * The filter finds the extreme points of the input in a fixed set of
+ * directions and takes the convex hull of those few points.  Since that
+ * polytope lies inside the true hull, any point strictly inside it cannot
+ * be a vertex of the hull.  For points spread evenly through a ball, this
+ * removes the great majority of the input in a single sweep.
+ *
+ * The directions are the 6 axis directions; those plus the 8 diagonals
+ * through the corners of a cube (14); or those plus the 12 diagonals
+ * through the midpoints of a cube's edges (26).  More directions cost more
+ * per point but give a larger polytope.
+ */
+class InteriorPointFilter {
+public:
+
+	/** Constructor */
+	InteriorPointFilter(unsigned int numDirections = 14, unsigned int numThreads = 0);
+
+	/** Finds the points that survive the filter */
+	template <typename T>
+	HullPointIndexList apply(const BasicHullPointBuffer<T> &points);
+
+	/** Gets the number of directions in which extreme points are found */
+	inline unsigned int getNumDirections() const { return this->numDirections; }
+
+	/** Gets the number of points discarded by the last call to apply() */
+	inline size_t getNumCulled() const { return this->numCulled; }
+
+	/** Gets the fraction of points discarded by the last call to apply() */
+	inline double getCulledFraction() const {
+		return (this->numPoints == 0) ? 0.0 : (double) this->numCulled / (double) this->numPoints;
+	}
+
+private:
+
+	/** The number of directions in which extreme points are found */
+	unsigned int numDirections;
+
+	/** The number of threads to sweep the points with */
+	unsigned int numThreads;
+
+	/** The number of points given to the last call to apply() */
+	size_t numPoints;
+
+	/** The number of points discarded by the last call to apply() */
+	size_t numCulled;
+
+};
@@ -0,0 +1,61 @@
+/**
+ * \file MappedFile.h
+ * \author Douglas W. Paul
+ *
+ * Declares the MappedFile class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+/**
+ * A whole file, mapped read-only into memory
+ *
+ * The kernel is told that the file will be read from front to back, so
+ * that it reads ahead.  An empty file has no mapping.
+ */
+class MappedFile {
+public:
+
+	/** Constructor */
+	MappedFile(const char *path);
+
+	/** Destructor */
+	~MappedFile();
+
+	/** Gets whether or not the file was mapped */
+	inline bool isOpen() const { return this->error.empty(); }
+
+	/** Gets why the file couldn't be mapped, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+	/** Provides access to the file's bytes (NULL if there are none) */
+	inline const char *getData() const { return this->data; }
+
+	/** Gets the size of the file, in bytes */
+	inline size_t getSize() const { return this->size; }
+
+	/** Lets go of the pages that lie wholly within a range of the file */
+	void release(size_t begin, size_t end) const;
+
+private:
+
+	/** The start of the mapping */
+	const char *data;
+
+	/** The size of the file, in bytes */
+	size_t size;
+
+	/** Why the file couldn't be mapped, or empty if it could */
+	string error;
+
+	/** Not copyable */
+	MappedFile(const MappedFile &);
+
+	/** Not copyable */
+	MappedFile &operator=(const MappedFile &);
+};
@@ -0,0 +1,138 @@
+/**
+ * \file MappedPointFile.h
+ * \author Douglas W. Paul
+ *
+ * Declares the MappedPointFile class
+ */
+
+#pragma once
+
+#include "HullPointBuffer.h"
+#include "HullPointSource.h"
+#include "MappedFile.h"
+#include <string>
+
+using namespace peek;
+
+/**
+ * A binary point cloud file, mapped into memory so that its points can be
+ * handed to a solver where they lie
+ *
+ * Binary little-endian PLY files are read from their vertex element, whose
+ * x, y and z properties must all be float or all be double; the vertices
+ * may have other properties as well.  Raw files are nothing but packed x,
+ * y, z triples of float or double.  The host is assumed to be
+ * little-endian.
+ *
+ * If the coordinates are of the type asked for and suitably aligned, the
+ * points are viewed in place, with no copy; otherwise they are copied out
+ * into a buffer of their own.  The file can also be read a block at a time
+ * as a HullPointSource, for StreamingHullSolver, in which case the pages
+ * already read are let go as it goes, so that files larger than memory
+ * don't crowd out everything else.
+ */
+class MappedPointFile : public HullPointSource {
+public:
+
+	/** The layout of a file */
+	enum Format {
+		/** PLY if the file starts with a PLY header, and unreadable otherwise */
+		AUTO,
+
+		/** Binary little-endian PLY */
+		PLY,
+
+		/** Packed single-precision triples, 12 bytes per point */
+		RAW_FLOAT,
+
+		/** Packed double-precision triples, 24 bytes per point */
+		RAW_DOUBLE
+	};
+
+	/** Constructor */
+	MappedPointFile(const char *path, Format format = AUTO);
+
+	/** Destructor */
+	virtual ~MappedPointFile() {}
+
+	/** Gets whether or not the file was mapped and understood */
+	inline bool isOpen() const { return this->error.empty(); }
+
+	/** Gets why the file couldn't be opened, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+	/** Gets the layout of the file */
+	inline Format getFormat() const { return this->format; }
+
+	/** Gets the number of points in the file */
+	inline size_t size() const { return this->numPoints; }
+
+	/** Gets whether the coordinates in the file are floats rather than doubles */
+	inline bool isFloat() const { return this->floatCoordinates; }
+
+	/** Gets the size of the file, in bytes */
+	inline size_t getFileSize() const { return this->fileSize; }
+
+	/** Points a buffer at the file's points, or copies them into it if it can't */
+	bool getPoints(HullPointBuffer &points) const;
+
+	/** Points a buffer at the file's points, or copies them into it if it can't */
+	bool getPoints(FloatHullPointBuffer &points) const;
+
+	/** Reads up to the given number of points, following on from the last read */
+	virtual size_t read(double *x, double *y, double *z, size_t maxPoints);
+
+	/** Starts reading from the first point again */
+	void rewind();
+
+private:
+
+	/** The file */
+	MappedFile file;
+
+	/** The start of the file */
+	const char *data;
+
+	/** The size of the file, in bytes */
+	size_t fileSize;
+
+	/** The layout of the file */
+	Format format;
+
+	/** Why the file couldn't be opened, or empty if it could */
+	string error;
+
+	/** The first point's record */
+	const char *records;
+
+	/** The number of points */
+	size_t numPoints;
+
+	/** The number of bytes from one point's record to the next */
+	size_t recordSize;
+
+	/** The offsets of the coordinates within a record, in bytes */
+	size_t offsets[3];
+
+	/** Whether the coordinates are floats rather than doubles */
+	bool floatCoordinates;
+
+	/** The next point to read */
+	size_t nextPoint;
+
+	/** The number of bytes at the start of the file that reading has let go of */
+	size_t releasedBytes;
+
+	/** Points a buffer of either type at the file's points, or copies them into it if it can't */
+	template <typename T>
+	bool getPointsAs(BasicHullPointBuffer<T> &points) const;
+
+	/** Finds the points in a PLY file from its header */
+	bool parsePlyHeader();
+
+	/** Not copyable */
+	MappedPointFile(const MappedPointFile &);
+
+	/** Not copyable */
+	MappedPointFile &operator=(const MappedPointFile &);
+};
@@ -0,0 +1,149 @@
+/**
+ * \file PlanarHullSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the PlanarHullSolver class
+ */
+
+#pragma once
+
+#include <Geometry.hpp>
+#include "HullFace.h"
+#include "HullMesh.h"
+#include "HullPointBuffer.h"
+#include "HullPredicates.h"
+#include "HullSolver.h"
+#include "HullThreadPool.h"
+#include <memory>
+
+using namespace peek;
+
+/**
+ * Solves the convex hull problem for points that lie in (or very nearly
+ * in) a plane, in two dimensions rather than three
+ *
+ * A plane is fitted to the points by least squares, and the points are
+ * projected onto it by dropping the coordinate along which its normal is
+ * largest.  Each thread drops the points of its share that are clearly
+ * inside, sorts the rest and finds their hull with Andrew's monotone chain,
+ * and a last chain over the vertices of those hulls gives the hull of all
+ * of them.  The result is a polygon, and the hull's faces are that polygon
+ * triangulated twice, once facing each way, so that they close up like
+ * the faces of a solid hull.
+ */
+class PlanarHullSolver : public HullSolver {
+public:
+
+	/**
+	 * How far from the fitted plane, relative to the size of the input,
+	 * points may be for the input to count as planar
+	 */
+	static const double DEFAULT_TOLERANCE;
+
+	/** Constructor */
+	PlanarHullSolver(const Point3dSet &inputPoints, unsigned int numThreads = 1);
+
+	/** Constructor */
+	PlanarHullSolver(const HullPointBuffer &inputPoints, unsigned int numThreads = 1);
+
+	/** Fits a plane to the points, and gets how far they stray from it */
+	static double fitPlane(const HullPointBuffer &points, double normal[3]);
+
+	/** Iterates once (which finds the whole hull) */
+	virtual void iterate();
+
+	/** Iterates until the hull is complete */
+	virtual void iterateToCompletion();
+
+	/** Sets the number of threads to solve with */
+	virtual void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to solve with */
+	virtual unsigned int getNumThreads() const { return (unsigned int) this->workers.size(); }
+
+	/** Gets the current hull */
+	virtual HullFaceList getHull() const { return this->hull.getFaces(); }
+
+	/** Gets the hull's outline, counter-clockwise as seen from the side the normal points to */
+	virtual HullPointIndexList getPolygon() const { return this->polygon; }
+
+	/** Provides access to the points that the hull's faces refer to */
+	inline const HullPointBuffer &getPoints() const { return this->points; }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const;
+
+	/**
+	 * Gets the number of dimensions the input spans within its plane (2 for
+	 * a polygon; less if the points are collinear or all the same, in which
+	 * case the hull has no faces).  Only meaningful once the hull is complete.
+	 */
+	virtual unsigned int getDimension() const { return this->dimension; }
+
+	/** Gets whether or not the hull is complete */
+	virtual bool isComplete() const { return this->complete; }
+
+	/** Gets the unit normal of the fitted plane */
+	inline const double *getNormal() const { return this->normal; }
+
+private:
+
+	/** The scratch space and counters that each thread works with */
+	struct Worker {
+		/** Counts of how often each stage of point classification was reached */
+		HullPredicateStatistics statistics;
+	};
+
+	typedef vector<Worker> WorkerList;
+
+	/** The input points */
+	HullPointBuffer points;
+
+	/** The unit normal of the fitted plane */
+	double normal[3];
+
+	/** The coordinate dropped to project the points onto the plane */
+	int dropAxis;
+
+	/** The points of each thread's share, which are replaced by their hull */
+	vector<HullPointIndexList> shares;
+
+	/** The hull's outline */
+	HullPointIndexList polygon;
+
+	/** The polygon, triangulated front and back */
+	HullMesh hull;
+
+	/** One worker per thread */
+	WorkerList workers;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** Whether or not the hull is complete */
+	bool complete;
+
+	/** The number of dimensions the input spans within its plane */
+	unsigned int dimension;
+
+	/** Fits the plane and picks the coordinate to drop */
+	void initialize();
+
+	/** Finds the hull of one thread's share of the points */
+	void solveShare(size_t share, unsigned int thread);
+
+	/** Replaces sorted points with their hull */
+	void chain(HullPointIndexList &sortedPoints, Worker &worker) const;
+
+	/** Covers the polygon with triangles facing either way */
+	void triangulate();
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (PlanarHullSolver::*task)(size_t, unsigned int));
+
+	/** Not copyable */
+	PlanarHullSolver(const PlanarHullSolver &);
+
+	/** Not copyable */
+	PlanarHullSolver &operator=(const PlanarHullSolver &);
+};
@@ -0,0 +1,87 @@
+/**
+ * \file PlyHeader.h
+ * \author Douglas W. Paul
+ *
+ * Declares the PlyHeader class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The header of a PLY file: its format, and the elements that follow it
+ * along with their properties
+ */
+class PlyHeader {
+public:
+
+	/** A property of an element */
+	struct Property {
+		/** The property's name */
+		string name;
+
+		/** The property's type (the type of its entries, for a list) */
+		string type;
+
+		/** Whether the property is a list */
+		bool list;
+	};
+
+	/** An element, which the file holds a number of instances of */
+	struct Element {
+		/** The element's name */
+		string name;
+
+		/** The number of instances */
+		size_t count;
+
+		/** The properties of each instance, in order */
+		vector<Property> properties;
+
+		/** Gets the position of the property with the given name, or -1 if there is none */
+		int findProperty(const string &name) const;
+	};
+
+	/** Constructor */
+	PlyHeader(const char *data, size_t size);
+
+	/** Gets whether or not the header could be read */
+	inline bool isValid() const { return this->error.empty(); }
+
+	/** Gets why the header couldn't be read, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+	/** Gets the format: "ascii", "binary_little_endian" or "binary_big_endian" */
+	inline const string &getFormat() const { return this->format; }
+
+	/** Gets the size of the header, in bytes, up to the first byte of the body */
+	inline size_t getSize() const { return this->size; }
+
+	/** Provides access to the elements, in the order they appear in the body */
+	inline const vector<Element> &getElements() const { return this->elements; }
+
+	/** Gets whether or not a file starts the way a PLY file does */
+	static bool matches(const char *data, size_t size);
+
+	/** Gets the size in bytes of a scalar type, or 0 if it isn't one */
+	static size_t getTypeSize(const string &type);
+
+private:
+
+	/** The format */
+	string format;
+
+	/** The size of the header, in bytes */
+	size_t size;
+
+	/** The elements */
+	vector<Element> elements;
+
+	/** Why the header couldn't be read, or empty if it could */
+	string error;
+};
@@ -0,0 +1,67 @@
+/**
+ * \file PointClassifier.h
+ * \author Douglas W. Paul
+ *
+ * Declares the PointClassifier class
+ */
+
+#pragma once
+
+#include "HullPoint.h"
+
+/**
+ * Container class for static methods that classify blocks of points against
+ * a plane
+ *
+ * Each method computes the signed distance of every point from the plane,
+ * and flags the points that might be in front of it.  The work is done by
+ * whichever kernel the processor supports best, chosen at run time.  The
+ * kernels for float points fit twice as many points in a register as those
+ * for double points, and read half as much memory.
+ */
+class PointClassifier {
+public:
+
+	/** The instruction sets that kernels exist for */
+	enum InstructionSet {
+		SCALAR,
+		SSE2,
+		AVX2,
+		AVX512
+	};
+
+	/** Gets the best instruction set that the processor supports */
+	static InstructionSet getSupportedInstructionSet();
+
+	/** Gets the instruction set currently in use */
+	static InstructionSet getInstructionSet();
+
+	/** Selects the instruction set to use */
+	static InstructionSet setInstructionSet(InstructionSet instructionSet);
+
+	/** Gets the name of an instruction set */
+	static const char *getName(InstructionSet instructionSet);
+
+	/** Classifies a block of consecutive points */
+	static size_t classify(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t count,
+		double *distances, unsigned char *mask);
+
+	/** Classifies the points at the given indices */
+	static size_t classifyIndexed(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		double *distances, unsigned char *mask);
+
+	/** Classifies a block of consecutive float points */
+	static size_t classify(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t count,
+		float *distances, unsigned char *mask);
+
+	/** Classifies the float points at the given indices */
+	static size_t classifyIndexed(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		float *distances, unsigned char *mask);
+
+};
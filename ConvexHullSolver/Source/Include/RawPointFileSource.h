@@ -0,0 +1,69 @@
+/**
+ * \file RawPointFileSource.h
+ * \author Douglas W. Paul
+ *
+ * Declares the RawPointFileSource class
+ */
+
+#pragma once
+
+#include "HullPointSource.h"
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Reads points from a file of packed little-endian x, y, z triples, of
+ * either float or double, one block at a time
+ *
+ * The file is read sequentially with buffered stdio, so it can be far
+ * larger than memory.  The host is assumed to be little-endian as well.
+ */
+class RawPointFileSource : public HullPointSource {
+public:
+
+	/** The type of the coordinates in the file */
+	enum Format {
+		/** Single precision, 12 bytes per point */
+		FLOAT,
+
+		/** Double precision, 24 bytes per point */
+		DOUBLE
+	};
+
+	/** Constructor */
+	RawPointFileSource(const char *path, Format format, size_t headerBytes = 0);
+
+	/** Destructor */
+	virtual ~RawPointFileSource();
+
+	/** Reads up to the given number of points */
+	virtual size_t read(double *x, double *y, double *z, size_t maxPoints);
+
+	/** Gets whether or not the file could be opened */
+	inline bool isOpen() const { return this->file != NULL; }
+
+	/** Gets the type of the coordinates in the file */
+	inline Format getFormat() const { return this->format; }
+
+private:
+
+	/** The points read at a time, at most */
+	static const size_t BLOCK_SIZE = 65536;
+
+	/** The file, or NULL if it couldn't be opened */
+	FILE *file;
+
+	/** The type of the coordinates in the file */
+	Format format;
+
+	/** The raw bytes of the block being read */
+	vector<char> block;
+
+	/** Not copyable */
+	RawPointFileSource(const RawPointFileSource &);
+
+	/** Not copyable */
+	RawPointFileSource &operator=(const RawPointFileSource &);
+};
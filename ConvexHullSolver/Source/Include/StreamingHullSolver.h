@@ -0,0 +1,190 @@
+/**
+ * \file StreamingHullSolver.h
+ * \author Douglas W. Paul
+ *
+ * Declares the StreamingHullSolver class
+ */
+
+#pragma once
+
+#include "ConvexHullSolver.h"
+#include "HullFace.h"
+#include "HullPointBuffer.h"
+#include "HullPointSource.h"
+#include "HullPredicates.h"
+#include "HullSolver.h"
+#include "PlanarHullSolver.h"
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+#include <memory>
+
+using namespace peek;
+
+/**
+ * Solves the 3D convex hull problem for more points than fit in memory,
+ * reading them from a HullPointSource a chunk at a time
+ *
+ * Only the hull of the chunks read so far is kept, along with whatever
+ * points of the latest chunk haven't been proven to be inside it.  Each
+ * chunk is taken in by a ConvexHullSolver, either by solving the hull's
+ * vertices and the chunk together from scratch, with the interior point
+ * filter culling most of the chunk, or, once the hull has grown large next
+ * to a chunk, by inserting the chunk into the hull.  The points inside the
+ * hull are then dropped.  While a chunk is being taken in, the next one is
+ * read into a second buffer on a thread of its own.
+ *
+ * The memory budget covers the two chunk buffers and the solver, whose
+ * memory use per point is estimated.  It can't cover a hull that by itself
+ * takes more than the budget; the chunks then shrink no further, and the
+ * solver goes over budget by as much as the hull does.
+ *
+ * Once every chunk is in, points that turn out to lie in (or very nearly
+ * in) a plane are handed to a PlanarHullSolver, as HullSolver::create()
+ * would hand them, so that they get the same two-sided polygon as they
+ * would from any other solver.
+ */
+class StreamingHullSolver : public HullSolver {
+public:
+
+	/** The memory budget unless another is given, in bytes */
+	static const size_t DEFAULT_MEMORY_BUDGET = 256 << 20;
+
+	/** The fewest points in a chunk, however small the budget */
+	static const size_t MIN_CHUNK_SIZE = 4096;
+
+	/** The number of directions in which the interior point filter looks for extreme points */
+	static const unsigned int FILTER_DIRECTIONS = 14;
+
+	/** Constructor */
+	StreamingHullSolver(HullPointSource &source, size_t memoryBudget = DEFAULT_MEMORY_BUDGET,
+		unsigned int numThreads = 1);
+
+	/** Destructor */
+	virtual ~StreamingHullSolver();
+
+	/** Iterates once (taking in one chunk) */
+	virtual void iterate();
+
+	/** Iterates until the hull is complete (every chunk has been taken in) */
+	virtual void iterateToCompletion();
+
+	/** Sets the number of threads to solve with */
+	virtual void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to solve with */
+	virtual unsigned int getNumThreads() const { return this->solver->getNumThreads(); }
+
+	/** Gets the hull of the chunks taken in so far */
+	virtual HullFaceList getHull() const {
+		return (this->planar.get() != NULL) ? this->planar->getHull() : this->solver->getHull();
+	}
+
+	/** Gets the outline of the hull, if it is planar, counter-clockwise about the plane's normal */
+	virtual HullPointIndexList getPolygon() const {
+		return (this->planar.get() != NULL) ? this->planar->getPolygon() : HullPointIndexList();
+	}
+
+	/** Provides access to the points that the hull's faces refer to, which are those kept so far */
+	inline const HullPointBuffer &getPoints() const { return this->solver->getPoints(); }
+
+	/** Gets counts of how often each stage of point classification was reached */
+	virtual HullPredicateStatistics getStatistics() const;
+
+	/**
+	 * Gets the number of dimensions the points read so far span (3 for a
+	 * solid hull; less if the points are coplanar, collinear or all the
+	 * same).  Until the hull is complete, coplanar points have no faces.
+	 */
+	virtual unsigned int getDimension() const {
+		return (this->planar.get() != NULL) ? this->planar->getDimension() : this->solver->getDimension();
+	}
+
+	/** Gets whether or not every chunk has been taken in */
+	virtual bool isComplete() const { return this->complete; }
+
+	/** Gets the memory budget, in bytes */
+	inline size_t getMemoryBudget() const { return this->memoryBudget; }
+
+	/** Gets the most points read at a time */
+	inline size_t getChunkSize() const { return this->chunkSize; }
+
+	/** Gets the number of points read so far */
+	inline boost::uint64_t getNumPointsRead() const { return this->numPointsRead; }
+
+	/** Gets the most points kept at once, besides the chunk buffers */
+	inline size_t getPeakPointsKept() const { return this->peakPointsKept; }
+
+private:
+
+	/** A buffer that a chunk is read into */
+	struct Chunk {
+		/** The coordinates of the chunk's points */
+		vector<double> x, y, z;
+
+		/** The number of points read into the buffer */
+		size_t size;
+	};
+
+	/** Where the points come from */
+	HullPointSource &source;
+
+	/** The memory budget, in bytes */
+	size_t memoryBudget;
+
+	/** The most points read at a time */
+	size_t chunkSize;
+
+	/** The most points that the solver may hold before they are cut down */
+	size_t maxPointsKept;
+
+	/** The buffers that chunks are read into, in turn */
+	Chunk chunks[2];
+
+	/** The buffer that holds (or is about to hold) the next chunk to take in */
+	int current;
+
+	/** The thread reading the next chunk, if any */
+	auto_ptr<boost::thread> reader;
+
+	/** Holds the hull, and the points not yet proven to be inside it */
+	auto_ptr<ConvexHullSolver> solver;
+
+	/** Holds the hull once every chunk is in, if the points are planar */
+	auto_ptr<PlanarHullSolver> planar;
+
+	/** The number of points read so far */
+	boost::uint64_t numPointsRead;
+
+	/** The most points kept at once */
+	size_t peakPointsKept;
+
+	/** Whether or not every chunk has been taken in */
+	bool complete;
+
+	/** Gets the number of vertices of the solver's hull */
+	size_t countVertices() const;
+
+	/** Starts reading a chunk into a buffer */
+	void startReading(int buffer);
+
+	/** Reads a chunk into a buffer, on the reader thread */
+	void readChunk(int buffer);
+
+	/** Waits for the chunk being read, if any */
+	void finishReading();
+
+	/** Finds the polygon of the points kept, if they lie in a plane */
+	void solvePlanar();
+
+	/** Takes in a chunk by solving it and the hull's vertices from scratch */
+	void merge(const Chunk &chunk);
+
+	/** Adds the points that the hull can't do without to a buffer */
+	void keepVertices(HullPointBuffer &kept) const;
+
+	/** Not copyable */
+	StreamingHullSolver(const StreamingHullSolver &);
+
+	/** Not copyable */
+	StreamingHullSolver &operator=(const StreamingHullSolver &);
+};
@@ -0,0 +1,177 @@
+/**
+ * \file TextPointFile.h
+ * \author Douglas W. Paul
+ *
+ * Declares the TextPointFile class
+ */
+
+#pragma once
+
+#include "HullPointBuffer.h"
+#include "HullPointSource.h"
+#include "HullThreadPool.h"
+#include "MappedFile.h"
+#include <memory>
+#include <string>
+
+using namespace peek;
+
+/**
+ * A text point cloud file, mapped into memory and parsed in parallel
+ *
+ * XYZ files have a point on each line whose first character (past any
+ * blanks) starts a number: the line's first three numbers are the point,
+ * and anything after them is ignored, as are all other lines.  OBJ files
+ * have a point on each "v" line.  ASCII PLY files have a point on each
+ * line of their vertex element, taken from its x, y and z properties.
+ * Numbers may be separated by blanks, commas or semicolons.
+ *
+ * load() splits the lines that hold the points into chunks that end at
+ * line breaks.  The threads count the points in each chunk, which gives
+ * each chunk's place in the coordinate arrays, and then parse the chunks
+ * straight into place, so that no point is allocated or copied on its
+ * own.  Numbers are parsed by hand wherever their digits and exponent are
+ * small enough for the result to be exact, and the rest (with more than
+ * 19 significant digits, or large exponents) go to strtod.
+ *
+ * The file can also be read a block at a time as a HullPointSource, for
+ * StreamingHullSolver, without loading it; that parses on the calling
+ * thread.
+ */
+class TextPointFile : public HullPointSource {
+public:
+
+	/** The layout of a file */
+	enum Format {
+		/** PLY if the file starts with a PLY header, OBJ if its name ends in ".obj", and XYZ otherwise */
+		AUTO,
+
+		/** Lines of x, y and z */
+		XYZ,
+
+		/** Wavefront OBJ, whose "v" lines are the points */
+		OBJ,
+
+		/** ASCII PLY */
+		PLY
+	};
+
+	/** The number of chunks the lines are split into per thread, so that the threads finish together */
+	static const size_t CHUNKS_PER_THREAD = 4;
+
+	/** The fewest bytes in a chunk, so that small files aren't split for nothing */
+	static const size_t MIN_CHUNK_SIZE = 1 << 16;
+
+	/** Constructor */
+	TextPointFile(const char *path, Format format = AUTO, unsigned int numThreads = 1);
+
+	/** Destructor */
+	virtual ~TextPointFile() {}
+
+	/** Gets whether or not the file was mapped and understood (and loaded, if it was) */
+	inline bool isOpen() const { return this->error.empty(); }
+
+	/** Gets why the file couldn't be opened or loaded, if it couldn't */
+	inline const string &getError() const { return this->error; }
+
+	/** Gets the layout of the file */
+	inline Format getFormat() const { return this->format; }
+
+	/** Gets the size of the file, in bytes */
+	inline size_t getFileSize() const { return this->file.getSize(); }
+
+	/** Parses every point in the file */
+	bool load();
+
+	/** Gets the number of points loaded */
+	inline size_t size() const { return this->x.size(); }
+
+	/** Points a buffer at the points loaded */
+	void getPoints(HullPointBuffer &points) const;
+
+	/** Copies the points loaded into a buffer, rounded to float */
+	void getPoints(FloatHullPointBuffer &points) const;
+
+	/** Reads up to the given number of points, following on from the last read */
+	virtual size_t read(double *x, double *y, double *z, size_t maxPoints);
+
+	/** Starts reading from the first point again */
+	void rewind();
+
+	/** Sets the number of threads to load with */
+	void setNumThreads(unsigned int numThreads);
+
+	/** Gets the number of threads to load with */
+	inline unsigned int getNumThreads() const { return this->numThreads; }
+
+private:
+
+	/** The file */
+	MappedFile file;
+
+	/** The layout of the file */
+	Format format;
+
+	/** Why the file couldn't be opened or loaded, or empty if it could */
+	string error;
+
+	/** The start of the lines that hold the points */
+	const char *begin;
+
+	/** The end of the lines that hold the points */
+	const char *end;
+
+	/** The positions among the numbers on a line of x, y and z */
+	int columns[3];
+
+	/** The coordinates of the points loaded */
+	vector<double> x, y, z;
+
+	/** Where each chunk starts, followed by where the last one ends */
+	vector<const char *> chunkBounds;
+
+	/** Where each chunk's points start in the coordinate arrays, followed by the total */
+	vector<size_t> chunkOffsets;
+
+	/** The first line of each chunk that couldn't be parsed, or NULL if there was none */
+	vector<const char *> chunkErrors;
+
+	/** The next line to read */
+	const char *cursor;
+
+	/** The number of bytes at the start of the file that reading has let go of */
+	size_t releasedBytes;
+
+	/** The number of threads to load with */
+	unsigned int numThreads;
+
+	/** The threads, if there is more than one */
+	auto_ptr<HullThreadPool> pool;
+
+	/** Finds the vertex lines of a PLY file from its header */
+	bool parsePlyHeader();
+
+	/** Notes that a line that should hold a point couldn't be parsed */
+	void setLineError(const char *line);
+
+	/** Gets whether or not a line holds a point */
+	bool isPointLine(const char *line, const char *lineEnd) const;
+
+	/** Parses the point on a line */
+	bool parsePoint(const char *line, const char *lineEnd, double &px, double &py, double &pz) const;
+
+	/** Counts the points in a chunk */
+	void countChunk(size_t chunk, unsigned int thread);
+
+	/** Parses the points in a chunk into place */
+	void parseChunk(size_t chunk, unsigned int thread);
+
+	/** Runs a batch of tasks, on the pool if there is one */
+	void run(size_t numTasks, void (TextPointFile::*task)(size_t, unsigned int));
+
+	/** Not copyable */
+	TextPointFile(const TextPointFile &);
+
+	/** Not copyable */
+	TextPointFile &operator=(const TextPointFile &);
+};
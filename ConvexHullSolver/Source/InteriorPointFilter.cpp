@@ -0,0 +1,274 @@
+/**
+ * \file InteriorPointFilter.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the InteriorPointFilter class
+ */
+
+#include "InteriorPointFilter.h"
+#include "ConvexHullSolver.h"
+#include "PointClassifier.h"
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+
+using namespace peek;
+
+
+namespace {
+
+	/**
+	 * One end of each direction in which extreme points are found: the 3
+	 * axes, then the 4 cube diagonals, then the 6 face diagonals.  The
+	 * minimum and maximum along each are both taken.
+	 */
+	const double DIRECTIONS[13][3] = {
+		{ 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+		{ 1, 1, 1 }, { 1, 1, -1 }, { 1, -1, 1 }, { -1, 1, 1 },
+		{ 1, 1, 0 }, { 1, -1, 0 }, { 1, 0, 1 }, { 1, 0, -1 }, { 0, 1, 1 }, { 0, 1, -1 }
+	};
+
+	/** The number of points classified at once */
+	const size_t BLOCK_SIZE = 1024;
+
+	/** Below this many points, the sweep isn't worth splitting across threads */
+	const size_t MIN_POINTS_PER_THREAD = 65536;
+
+	/**
+	 * Finds the points with the smallest and largest projections along each
+	 * direction, over a range of points
+	 *
+	 * \param points The points
+	 * \param begin The first point in the range
+	 * \param end One past the last point in the range
+	 * \param numAxes The number of entries of DIRECTIONS to use
+	 * \param extremes Receives the index of the minimum and maximum along
+	 *   each direction, in that order
+	 */
+	template <typename T>
+	void findExtremes(const BasicHullPointBuffer<T> *points, HullPointIndex begin, HullPointIndex end,
+		unsigned int numAxes, HullPointIndex *extremes) {
+
+		double minima[13], maxima[13];
+
+		for (unsigned int a = 0; a < numAxes; a++) {
+			minima[a] = maxima[a] = DIRECTIONS[a][0] * points->getX(begin)
+				+ DIRECTIONS[a][1] * points->getY(begin) + DIRECTIONS[a][2] * points->getZ(begin);
+			extremes[2 * a] = extremes[2 * a + 1] = begin;
+		}
+
+		for (HullPointIndex i = begin + 1; i < end; i++) {
+			double x = points->getX(i), y = points->getY(i), z = points->getZ(i);
+
+			for (unsigned int a = 0; a < numAxes; a++) {
+				double d = DIRECTIONS[a][0] * x + DIRECTIONS[a][1] * y + DIRECTIONS[a][2] * z;
+
+				if (d < minima[a]) {
+					minima[a] = d;
+					extremes[2 * a] = i;
+				}
+
+				if (d > maxima[a]) {
+					maxima[a] = d;
+					extremes[2 * a + 1] = i;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Collects the points in a range that are not strictly inside every one
+	 * of the given faces
+	 *
+	 * \param points The points
+	 * \param begin The first point in the range
+	 * \param end One past the last point in the range
+	 * \param faces The faces of the polytope, with their planes
+	 * \param survivors Receives the points that are kept
+	 */
+	template <typename T>
+	void sweep(const BasicHullPointBuffer<T> *points, HullPointIndex begin, HullPointIndex end,
+		const vector<BasicHullFace<T> > *faces, HullPointIndexList *survivors) {
+
+		vector<T> distances(BLOCK_SIZE);
+		vector<unsigned char> mask(BLOCK_SIZE);
+		vector<unsigned char> outside(BLOCK_SIZE);
+		HullPointIndexList indices;
+		size_t stride = points->getStride();
+
+		for (HullPointIndex start = begin; start < end; start += (HullPointIndex) BLOCK_SIZE) {
+			size_t count = end - start;
+			count = (count < BLOCK_SIZE) ? count : BLOCK_SIZE;
+			std::fill(outside.begin(), outside.begin() + count, 0);
+
+			// Points that aren't packed are read by index instead.
+			if (stride != 1) {
+				indices.resize(count);
+
+				for (size_t j = 0; j < count; j++) {
+					indices[j] = start + (HullPointIndex) j;
+				}
+			}
+
+			for (typename vector<BasicHullFace<T> >::const_iterator f = faces->begin(); f != faces->end(); f++) {
+				if (stride == 1) {
+					PointClassifier::classify((*f).getPlane(), (*f).getErrorBound(),
+						points->getXArray() + start, points->getYArray() + start, points->getZArray() + start,
+						count, &distances[0], &mask[0]);
+				} else {
+					PointClassifier::classifyIndexed((*f).getPlane(), (*f).getErrorBound(),
+						points->getXArray(), points->getYArray(), points->getZArray(), stride,
+						&indices[0], count, &distances[0], &mask[0]);
+				}
+
+				for (size_t j = 0; j < count; j++) {
+					outside[j] |= mask[j];
+				}
+			}
+
+			for (size_t j = 0; j < count; j++) {
+				if (outside[j]) {
+					survivors->push_back(start + (HullPointIndex) j);
+				}
+			}
+		}
+	}
+
+}
+
+/**
+ * \param numDirections The number of directions in which to find extreme
+ *   points: 6, 14 or 26.  Other values are rounded down to one of those
+ *   (but no lower than 6).
+ * \param numThreads The number of threads to sweep the points with, or 0 to
+ *   use one per processor
+ */
+InteriorPointFilter::InteriorPointFilter(unsigned int numDirections, unsigned int numThreads) {
+	this->numDirections = (numDirections >= 26) ? 26 : (numDirections >= 14) ? 14 : 6;
+	this->numThreads = (numThreads > 0) ? numThreads : boost::thread::hardware_concurrency();
+	this->numThreads = (this->numThreads > 0) ? this->numThreads : 1;
+	this->numPoints = 0;
+	this->numCulled = 0;
+}
+
+/**
+ * \param points The points to filter
+ * \return The indices of the points that might be on the hull, in
+ *   increasing order
+ */
+template <typename T>
+HullPointIndexList InteriorPointFilter::apply(const BasicHullPointBuffer<T> &points) {
+	this->numPoints = points.size();
+	this->numCulled = 0;
+
+	HullPointIndexList survivors;
+
+	if (points.size() == 0) {
+		return survivors;
+	}
+
+	// Split the points into one range per thread.
+	size_t numRanges = points.size() / MIN_POINTS_PER_THREAD;
+	numRanges = (numRanges < this->numThreads) ? numRanges : this->numThreads;
+	numRanges = (numRanges > 0) ? numRanges : 1;
+
+	vector<HullPointIndex> bounds(numRanges + 1);
+
+	for (size_t r = 0; r <= numRanges; r++) {
+		bounds[r] = (HullPointIndex) (points.size() * r / numRanges);
+	}
+
+	// Find the extreme points in each range, then the extremes among those.
+	unsigned int numAxes = this->numDirections / 2;
+	vector<HullPointIndex> rangeExtremes(numRanges * 2 * numAxes);
+
+	if (numRanges == 1) {
+		findExtremes<T>(&points, bounds[0], bounds[1], numAxes, &rangeExtremes[0]);
+	} else {
+		boost::thread_group threads;
+
+		for (size_t r = 0; r < numRanges; r++) {
+			threads.create_thread(boost::bind(&findExtremes<T>, &points, bounds[r], bounds[r + 1],
+				numAxes, &rangeExtremes[r * 2 * numAxes]));
+		}
+
+		threads.join_all();
+	}
+
+	Point3dSet extremePoints;
+	HullPointIndexList extremeIndices;
+
+	for (unsigned int a = 0; a < numAxes; a++) {
+		for (int side = 0; side < 2; side++) {
+			HullPointIndex best = rangeExtremes[2 * a + side];
+
+			for (size_t r = 1; r < numRanges; r++) {
+				HullPointIndex p = rangeExtremes[r * 2 * numAxes + 2 * a + side];
+				double dp = DIRECTIONS[a][0] * points.getX(p) + DIRECTIONS[a][1] * points.getY(p)
+					+ DIRECTIONS[a][2] * points.getZ(p);
+				double db = DIRECTIONS[a][0] * points.getX(best) + DIRECTIONS[a][1] * points.getY(best)
+					+ DIRECTIONS[a][2] * points.getZ(best);
+
+				if ((side == 0) ? (dp < db) : (dp > db)) {
+					best = p;
+				}
+			}
+
+			if (std::find(extremeIndices.begin(), extremeIndices.end(), best) == extremeIndices.end()) {
+				extremeIndices.push_back(best);
+				extremePoints.push_back(points.getPoint(best));
+			}
+		}
+	}
+
+	// The polytope is the hull of the extreme points.  If they don't span a
+	// volume, nothing can be strictly inside it.
+	ConvexHullSolver polytopeSolver(extremePoints);
+	polytopeSolver.iterateToCompletion();
+
+	if (polytopeSolver.getDimension() < 3) {
+		survivors.resize(points.size());
+
+		for (HullPointIndex i = 0; i < points.size(); i++) {
+			survivors[i] = i;
+		}
+
+		return survivors;
+	}
+
+	// Rebuild the polytope's faces against the full input, so that their
+	// error bounds hold for every point they will be tested against.
+	HullFaceList smallFaces = polytopeSolver.getHull();
+	vector<BasicHullFace<T> > faces;
+	double magnitude = points.getMagnitude();
+
+	for (HullFaceList::const_iterator i = smallFaces.begin(); i != smallFaces.end(); i++) {
+		faces.push_back(BasicHullFace<T>(extremeIndices[(*i).getP0()], extremeIndices[(*i).getP1()],
+			extremeIndices[(*i).getP2()], points, magnitude));
+	}
+
+	// Sweep each range against the polytope.
+	if (numRanges == 1) {
+		sweep<T>(&points, bounds[0], bounds[1], &faces, &survivors);
+	} else {
+		vector<HullPointIndexList> rangeSurvivors(numRanges);
+		boost::thread_group threads;
+
+		for (size_t r = 0; r < numRanges; r++) {
+			threads.create_thread(boost::bind(&sweep<T>, &points, bounds[r], bounds[r + 1],
+				&faces, &rangeSurvivors[r]));
+		}
+
+		threads.join_all();
+
+		for (size_t r = 0; r < numRanges; r++) {
+			survivors.insert(survivors.end(), rangeSurvivors[r].begin(), rangeSurvivors[r].end());
+		}
+	}
+
+	this->numCulled = points.size() - survivors.size();
+	return survivors;
+}
+
+template HullPointIndexList InteriorPointFilter::apply(const HullPointBuffer &);
+template HullPointIndexList InteriorPointFilter::apply(const FloatHullPointBuffer &);
@@ -0,0 +1,131 @@
+/**
+ * \file MappedFile.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the MappedFile class
+ */
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * The handles are closed right away, since the mapping keeps the file open
+ * by itself.
+ *
+ * \param path The file to map
+ */
+MappedFile::MappedFile(const char *path) {
+	this->data = NULL;
+	this->size = 0;
+
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	LARGE_INTEGER size;
+
+	if (file == INVALID_HANDLE_VALUE) {
+		this->error = "can't open the file";
+		return;
+	}
+
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		this->error = "can't get the file's size";
+		return;
+	}
+
+	if ((unsigned long long) size.QuadPart > (size_t) -1) {
+		CloseHandle(file);
+		this->error = "can't map a file that large";
+		return;
+	}
+
+	this->size = (size_t) size.QuadPart;
+
+	if (this->size > 0) {
+		HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+		if (mapping != NULL) {
+			this->data = (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+#else
+	int descriptor = open(path, O_RDONLY);
+	struct stat status;
+
+	if (descriptor < 0) {
+		this->error = "can't open the file";
+		return;
+	}
+
+	if (fstat(descriptor, &status) != 0) {
+		close(descriptor);
+		this->error = "can't get the file's size";
+		return;
+	}
+
+	if ((unsigned long long) status.st_size > (size_t) -1) {
+		close(descriptor);
+		this->error = "can't map a file that large";
+		return;
+	}
+
+	this->size = (size_t) status.st_size;
+
+	if (this->size > 0) {
+		void *mapping = mmap(NULL, this->size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+		if (mapping != MAP_FAILED) {
+			this->data = (const char *) mapping;
+			madvise(mapping, this->size, MADV_SEQUENTIAL);
+		}
+	}
+
+	close(descriptor);
+#endif
+
+	if (this->size > 0 && this->data == NULL) {
+		this->error = "can't map the file";
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (this->data != NULL) {
+#if defined(_WIN32)
+		UnmapViewOfFile(this->data);
+#else
+		munmap((void *) this->data, this->size);
+#endif
+	}
+}
+
+/**
+ * The pages are read back in from the file if they are used again, so
+ * this only trims what the file holds in memory once it has been read
+ * past.  It does nothing on Windows.
+ *
+ * \param begin The offset of the start of the range
+ * \param end The offset of the end of the range
+ */
+void MappedFile::release(size_t begin, size_t end) const {
+#if !defined(_WIN32)
+	size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+	begin = (begin + pageSize - 1) / pageSize * pageSize;
+	end = end / pageSize * pageSize;
+
+	if (this->data != NULL && begin < end) {
+		madvise((void *) (this->data + begin), end - begin, MADV_DONTNEED);
+	}
+#endif
+}
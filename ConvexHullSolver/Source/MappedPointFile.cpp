@@ -0,0 +1,268 @@
+/**
+ * \file MappedPointFile.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the MappedPointFile class
+ */
+
+#include "MappedPointFile.h"
+#include "PlyHeader.h"
+#include <cstring>
+
+using namespace peek;
+
+namespace {
+
+	/** The number of points copied out of the file at a time */
+	const size_t COPY_BLOCK_SIZE = 65536;
+
+	/** Copies the coordinates, of type S, out of consecutive records into packed arrays of type T */
+	template <typename S, typename T>
+	void unpack(const char *records, size_t recordSize, const size_t offsets[3], size_t count,
+		T *x, T *y, T *z) {
+
+		for (size_t i = 0; i < count; i++, records += recordSize) {
+			S coordinates[3];
+			memcpy(&coordinates[0], records + offsets[0], sizeof(S));
+			memcpy(&coordinates[1], records + offsets[1], sizeof(S));
+			memcpy(&coordinates[2], records + offsets[2], sizeof(S));
+			x[i] = (T) coordinates[0];
+			y[i] = (T) coordinates[1];
+			z[i] = (T) coordinates[2];
+		}
+	}
+
+}
+
+/**
+ * The file stays mapped until the object is destroyed, so buffers that
+ * getPoints() points at it must not outlive it.
+ *
+ * \param path The file to map
+ * \param format The file's layout
+ */
+MappedPointFile::MappedPointFile(const char *path, Format format)
+	: file(path) {
+
+	this->data = this->file.getData();
+	this->fileSize = this->file.getSize();
+	this->format = format;
+	this->records = NULL;
+	this->numPoints = 0;
+	this->recordSize = 0;
+	this->floatCoordinates = false;
+	this->nextPoint = 0;
+	this->releasedBytes = 0;
+
+	if (!this->file.isOpen()) {
+		this->error = this->file.getError();
+		return;
+	}
+
+	if (this->format == AUTO) {
+		if (PlyHeader::matches(this->data, this->fileSize)) {
+			this->format = PLY;
+		} else {
+			this->error = "not a PLY file, and no raw format was given";
+			return;
+		}
+	}
+
+	if (this->format == PLY) {
+		parsePlyHeader();
+	} else {
+		size_t scalarSize = (this->format == RAW_FLOAT) ? sizeof(float) : sizeof(double);
+		this->floatCoordinates = (this->format == RAW_FLOAT);
+		this->records = this->data;
+		this->recordSize = 3 * scalarSize;
+		this->numPoints = this->fileSize / this->recordSize;
+
+		for (int i = 0; i < 3; i++) {
+			this->offsets[i] = i * scalarSize;
+		}
+
+		if (this->numPoints > MAX_HULL_POINTS) {
+			this->error = "the file has more points than can be indexed";
+			this->numPoints = 0;
+		}
+	}
+}
+
+/**
+ * Only the vertex element is used.  Any elements before it must have no
+ * list properties, so that they can be skipped over.  Each element's count
+ * is checked against what is left of the file before it is multiplied out,
+ * so that a header can't claim more than the file holds by overflowing.
+ *
+ * \return Whether or not the header describes points that can be read
+ */
+bool MappedPointFile::parsePlyHeader() {
+	PlyHeader header(this->data, this->fileSize);
+	const vector<PlyHeader::Element> &elements = header.getElements();
+	size_t offset = header.getSize();
+
+	if (!header.isValid()) {
+		this->error = header.getError();
+		return false;
+	}
+
+	if (header.getFormat() != "binary_little_endian") {
+		this->error = "only binary little-endian PLY files can be mapped";
+		return false;
+	}
+
+	for (size_t i = 0; i < elements.size(); i++) {
+		const PlyHeader::Element &element = elements[i];
+		size_t elementSize = 0;
+		size_t coordinateSizes[3] = { 0, 0, 0 };
+
+		for (size_t j = 0; j < element.properties.size(); j++) {
+			const PlyHeader::Property &property = element.properties[j];
+
+			if (property.list) {
+				this->error = (element.name == "vertex") ? "the vertices have a list property"
+					: "an element before the vertices has a list property";
+				return false;
+			}
+
+			if (property.name.size() == 1 && property.name[0] >= 'x' && property.name[0] <= 'z') {
+				int axis = property.name[0] - 'x';
+				this->offsets[axis] = elementSize;
+				coordinateSizes[axis] = (property.type == "float" || property.type == "float32") ? sizeof(float)
+					: (property.type == "double" || property.type == "float64") ? sizeof(double) : 0;
+			}
+
+			elementSize += PlyHeader::getTypeSize(property.type);
+		}
+
+		if (elementSize > 0 && element.count > (this->fileSize - offset) / elementSize) {
+			this->error = "the PLY file is shorter than its header says";
+			return false;
+		}
+
+		if (element.name != "vertex") {
+			offset += element.count * elementSize;
+			continue;
+		}
+
+		if (coordinateSizes[0] == 0 || coordinateSizes[1] != coordinateSizes[0]
+			|| coordinateSizes[2] != coordinateSizes[0]) {
+
+			this->error = "the vertices' x, y and z must all be float or all be double";
+			return false;
+		}
+
+		if (element.count > MAX_HULL_POINTS) {
+			this->error = "the PLY file has more vertices than can be indexed";
+			return false;
+		}
+
+		this->floatCoordinates = (coordinateSizes[0] == sizeof(float));
+		this->records = this->data + offset;
+		this->recordSize = elementSize;
+		this->numPoints = element.count;
+		return true;
+	}
+
+	this->error = "the PLY file has no vertex element";
+	return false;
+}
+
+/**
+ * The buffer refers to the mapping if the file's coordinates are of type T
+ * and the records and coordinates are aligned for T, as they are in raw
+ * files and in PLY files whose headers and vertex records happen to fit.
+ *
+ * \param points Receives the points
+ * \return Whether the buffer refers to the mapping, rather than a copy
+ */
+template <typename T>
+bool MappedPointFile::getPointsAs(BasicHullPointBuffer<T> &points) const {
+	bool aligned = ((size_t) this->records % sizeof(T) == 0) && (this->recordSize % sizeof(T) == 0)
+		&& (this->offsets[0] % sizeof(T) == 0) && (this->offsets[1] % sizeof(T) == 0)
+		&& (this->offsets[2] % sizeof(T) == 0);
+
+	if (this->floatCoordinates == (sizeof(T) == sizeof(float)) && aligned && this->numPoints > 0) {
+		points = BasicHullPointBuffer<T>(this->records, this->numPoints, this->recordSize,
+			this->offsets[0], this->offsets[1], this->offsets[2]);
+		return true;
+	}
+
+	vector<T> x(COPY_BLOCK_SIZE), y(COPY_BLOCK_SIZE), z(COPY_BLOCK_SIZE);
+	points = BasicHullPointBuffer<T>();
+	points.reserve(this->numPoints);
+
+	for (size_t i = 0; i < this->numPoints; i += COPY_BLOCK_SIZE) {
+		size_t count = (this->numPoints - i < COPY_BLOCK_SIZE) ? this->numPoints - i : COPY_BLOCK_SIZE;
+		const char *block = this->records + i * this->recordSize;
+
+		if (this->floatCoordinates) {
+			unpack<float>(block, this->recordSize, this->offsets, count, &x[0], &y[0], &z[0]);
+		} else {
+			unpack<double>(block, this->recordSize, this->offsets, count, &x[0], &y[0], &z[0]);
+		}
+
+		points.append(BasicHullPointBuffer<T>(&x[0], &y[0], &z[0], count));
+	}
+
+	return false;
+}
+
+/**
+ * Float coordinates are widened exactly.  Must only be called if the file
+ * is open.
+ *
+ * \param points Receives the points, which refer to the mapping if they can
+ * \return Whether the buffer refers to the mapping, rather than a copy
+ */
+bool MappedPointFile::getPoints(HullPointBuffer &points) const {
+	return getPointsAs(points);
+}
+
+/**
+ * Double coordinates are rounded to the nearest float.  Must only be
+ * called if the file is open.
+ *
+ * \param points Receives the points, which refer to the mapping if they can
+ * \return Whether the buffer refers to the mapping, rather than a copy
+ */
+bool MappedPointFile::getPoints(FloatHullPointBuffer &points) const {
+	return getPointsAs(points);
+}
+
+/**
+ * The pages behind the points read so far are let go of, so that reading
+ * the whole of a large file doesn't keep it all resident.
+ *
+ * \param x Receives the x-coordinates of the points read
+ * \param y Receives the y-coordinates of the points read
+ * \param z Receives the z-coordinates of the points read
+ * \param maxPoints The most points to read
+ * \return The number of points read, which is less than maxPoints only once
+ *   every point has been read
+ */
+size_t MappedPointFile::read(double *x, double *y, double *z, size_t maxPoints) {
+	size_t numRead = (this->numPoints - this->nextPoint < maxPoints) ? this->numPoints - this->nextPoint : maxPoints;
+	const char *block = this->records + this->nextPoint * this->recordSize;
+
+	if (this->floatCoordinates) {
+		unpack<float>(block, this->recordSize, this->offsets, numRead, x, y, z);
+	} else {
+		unpack<double>(block, this->recordSize, this->offsets, numRead, x, y, z);
+	}
+
+	this->nextPoint += numRead;
+
+	if (numRead > 0) {
+		size_t consumed = (size_t) (this->records - this->data) + this->nextPoint * this->recordSize;
+		this->file.release(this->releasedBytes, consumed);
+		this->releasedBytes = consumed;
+	}
+
+	return numRead;
+}
+
+void MappedPointFile::rewind() {
+	this->nextPoint = 0;
+	this->releasedBytes = 0;
+}
@@ -0,0 +1,514 @@
+/**
+ * \file PlanarHullSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the PlanarHullSolver class
+ */
+
+#include "PlanarHullSolver.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace peek;
+
+const double PlanarHullSolver::DEFAULT_TOLERANCE = 1e-9;
+
+namespace {
+
+	/** Below this many points per thread, the hull isn't worth splitting up */
+	const size_t MIN_POINTS_PER_SHARE = 65536;
+
+	/** The most Jacobi sweeps made to find the plane's normal */
+	const int MAX_SWEEPS = 32;
+
+	/** The directions in which the interior point filter finds extreme points */
+	const int NUM_DIRECTIONS = 16;
+
+	/**
+	 * How far inside the filter's polygon, relative to the sizes of the
+	 * terms, a point must be to be sure of it in floating-point arithmetic
+	 */
+	const double INSIDE_TOLERANCE = 1e-12;
+
+	/** Those directions, counter-clockwise, in the projected coordinates */
+	const double DIRECTIONS[NUM_DIRECTIONS][2] = {
+		{ 1, 0 }, { 2, 1 }, { 1, 1 }, { 1, 2 }, { 0, 1 }, { -1, 2 }, { -1, 1 }, { -2, 1 },
+		{ -1, 0 }, { -2, -1 }, { -1, -1 }, { -1, -2 }, { 0, -1 }, { 1, -2 }, { 1, -1 }, { 2, -1 }
+	};
+
+	/** Orders points by their projected coordinates */
+	struct ProjectedOrder {
+		const HullPointBuffer *points;
+		int s, t;
+
+		double coordinate(HullPointIndex i, int axis) const {
+			return (axis == 0) ? this->points->getX(i) : ((axis == 1) ? this->points->getY(i) : this->points->getZ(i));
+		}
+
+		bool operator()(HullPointIndex i, HullPointIndex j) const {
+			if (coordinate(i, this->s) != coordinate(j, this->s)) {
+				return coordinate(i, this->s) < coordinate(j, this->s);
+			}
+
+			return coordinate(i, this->t) < coordinate(j, this->t);
+		}
+
+		bool same(HullPointIndex i, HullPointIndex j) const {
+			return coordinate(i, this->s) == coordinate(j, this->s) && coordinate(i, this->t) == coordinate(j, this->t);
+		}
+	};
+
+	/**
+	 * Finds the eigenvector of a symmetric 3x3 matrix with the smallest
+	 * eigenvalue, by Jacobi rotations
+	 */
+	void findSmallestEigenvector(double a[3][3], double v[3]) {
+		double e[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+		for (int sweep = 0; sweep < MAX_SWEEPS; sweep++) {
+			if (a[0][1] == 0.0 && a[0][2] == 0.0 && a[1][2] == 0.0) {
+				break;
+			}
+
+			for (int p = 0; p < 2; p++) {
+				for (int q = p + 1; q < 3; q++) {
+					if (a[p][q] == 0.0) {
+						continue;
+					}
+
+					// Rotate in the pq plane so that a[p][q] becomes zero.
+					double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+					double t = ((theta >= 0.0) ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+					double c = 1.0 / sqrt(t * t + 1.0);
+					double s = t * c;
+
+					for (int k = 0; k < 3; k++) {
+						double akp = a[k][p], akq = a[k][q];
+						a[k][p] = c * akp - s * akq;
+						a[k][q] = s * akp + c * akq;
+					}
+
+					for (int k = 0; k < 3; k++) {
+						double apk = a[p][k], aqk = a[q][k];
+						a[p][k] = c * apk - s * aqk;
+						a[q][k] = s * apk + c * aqk;
+					}
+
+					for (int k = 0; k < 3; k++) {
+						double ekp = e[k][p], ekq = e[k][q];
+						e[k][p] = c * ekp - s * ekq;
+						e[k][q] = s * ekp + c * ekq;
+					}
+				}
+			}
+		}
+
+		int smallest = 0;
+
+		for (int k = 1; k < 3; k++) {
+			if (a[k][k] < a[smallest][smallest]) {
+				smallest = k;
+			}
+		}
+
+		for (int k = 0; k < 3; k++) {
+			v[k] = e[k][smallest];
+		}
+	}
+
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+PlanarHullSolver::PlanarHullSolver(const Point3dSet &inputPoints, unsigned int numThreads) : points(inputPoints) {
+	setNumThreads(numThreads);
+	initialize();
+}
+
+/**
+ * \param inputPoints The points whose convex hull to find.  If the buffer
+ *   refers to arrays owned by the caller, the arrays must outlive the solver.
+ * \param numThreads The number of threads to solve with (see setNumThreads)
+ */
+PlanarHullSolver::PlanarHullSolver(const HullPointBuffer &inputPoints, unsigned int numThreads) : points(inputPoints) {
+	setNumThreads(numThreads);
+	initialize();
+}
+
+/**
+ * The plane passes through the points' centroid, and its normal is the
+ * direction in which they vary least.  This makes two passes over the
+ * points, so HullSolver::create() can afford it before picking a solver.
+ *
+ * \param points The points
+ * \param normal Receives the plane's unit normal
+ * \return The greatest distance of any point from the plane, relative to
+ *   the diagonal of the points' bounding box (0 if there are no points, or
+ *   they are all the same)
+ */
+double PlanarHullSolver::fitPlane(const HullPointBuffer &points, double normal[3]) {
+	size_t n = points.size();
+	normal[0] = 0.0;
+	normal[1] = 0.0;
+	normal[2] = 1.0;
+
+	if (n == 0) {
+		return 0.0;
+	}
+
+	const double *coordinates[3] = { points.getXArray(), points.getYArray(), points.getZArray() };
+	size_t stride = points.getStride();
+	double centroid[3] = { 0.0, 0.0, 0.0 };
+	double lower[3], upper[3];
+
+	for (int j = 0; j < 3; j++) {
+		lower[j] = upper[j] = coordinates[j][0];
+
+		for (size_t i = 0; i < n; i++) {
+			double c = coordinates[j][i * stride];
+			centroid[j] += c;
+			lower[j] = (c < lower[j]) ? c : lower[j];
+			upper[j] = (c > upper[j]) ? c : upper[j];
+		}
+
+		centroid[j] /= n;
+	}
+
+	double covariance[3][3] = { { 0, 0, 0 }, { 0, 0, 0 }, { 0, 0, 0 } };
+
+	for (size_t i = 0; i < n; i++) {
+		double d[3] = { coordinates[0][i * stride] - centroid[0], coordinates[1][i * stride] - centroid[1],
+			coordinates[2][i * stride] - centroid[2] };
+
+		for (int j = 0; j < 3; j++) {
+			for (int k = j; k < 3; k++) {
+				covariance[j][k] += d[j] * d[k];
+			}
+		}
+	}
+
+	for (int j = 0; j < 3; j++) {
+		for (int k = 0; k < j; k++) {
+			covariance[j][k] = covariance[k][j];
+		}
+	}
+
+	findSmallestEigenvector(covariance, normal);
+
+	double diagonal = sqrt((upper[0] - lower[0]) * (upper[0] - lower[0])
+		+ (upper[1] - lower[1]) * (upper[1] - lower[1])
+		+ (upper[2] - lower[2]) * (upper[2] - lower[2]));
+	double thickness = 0.0;
+
+	for (size_t i = 0; i < n; i++) {
+		double d = fabs(normal[0] * (coordinates[0][i * stride] - centroid[0])
+			+ normal[1] * (coordinates[1][i * stride] - centroid[1])
+			+ normal[2] * (coordinates[2][i * stride] - centroid[2]));
+		thickness = (d > thickness) ? d : thickness;
+	}
+
+	return (diagonal > 0.0) ? thickness / diagonal : 0.0;
+}
+
+/**
+ * The normal is turned so that the dropped coordinate is positive along it.
+ * The projection then keeps the plane's orientation, so a polygon that is
+ * counter-clockwise in the projection is counter-clockwise as seen from the
+ * side the normal points to.
+ */
+void PlanarHullSolver::initialize() {
+	this->complete = false;
+	this->dimension = 0;
+
+	fitPlane(this->points, this->normal);
+	this->dropAxis = 0;
+
+	for (int j = 1; j < 3; j++) {
+		if (fabs(this->normal[j]) > fabs(this->normal[this->dropAxis])) {
+			this->dropAxis = j;
+		}
+	}
+
+	if (this->normal[this->dropAxis] < 0.0) {
+		for (int j = 0; j < 3; j++) {
+			this->normal[j] = -this->normal[j];
+		}
+	}
+}
+
+void PlanarHullSolver::iterate() {
+	if (isComplete()) {
+		return;
+	}
+
+	size_t n = this->points.size();
+	size_t numShares = (n + MIN_POINTS_PER_SHARE - 1) / MIN_POINTS_PER_SHARE;
+	numShares = std::max((size_t) 1, std::min(numShares, (size_t) getNumThreads()));
+
+	this->shares.assign(numShares, HullPointIndexList());
+	run(numShares, &PlanarHullSolver::solveShare);
+
+	// The hull of the shares' hulls is the hull of all the points.
+	this->polygon.clear();
+
+	for (size_t i = 0; i < this->shares.size(); i++) {
+		this->polygon.insert(this->polygon.end(), this->shares[i].begin(), this->shares[i].end());
+	}
+
+	this->shares.clear();
+
+	if (numShares > 1) {
+		ProjectedOrder order = { &this->points, (this->dropAxis + 1) % 3, (this->dropAxis + 2) % 3 };
+		std::sort(this->polygon.begin(), this->polygon.end(), order);
+		chain(this->polygon, this->workers[0]);
+	}
+
+	this->dimension = (this->polygon.size() >= 3) ? 2 : ((this->polygon.size() == 2) ? 1 : 0);
+	triangulate();
+	this->complete = true;
+}
+
+void PlanarHullSolver::iterateToCompletion() {
+	iterate();
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+void PlanarHullSolver::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	// Keep the first worker, so that its counters carry over.
+	this->workers.resize(numThreads);
+	this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over all threads
+ */
+HullPredicateStatistics PlanarHullSolver::getStatistics() const {
+	HullPredicateStatistics statistics;
+
+	for (WorkerList::const_iterator i = this->workers.begin(); i != this->workers.end(); i++) {
+		statistics += (*i).statistics;
+	}
+
+	return statistics;
+}
+
+/**
+ * Before sorting, the points strictly inside the polygon of the share's
+ * extreme points in sixteen directions are dropped (after Akl and
+ * Toussaint), which for most inputs leaves few to sort.  The polygon's
+ * corners are input points, and a point is only dropped if it is inside
+ * by more than rounding error could account for, so no hull vertex is ever
+ * dropped; points too close to call are left for the exact chain.
+ *
+ * \param share The share to solve
+ * \param thread The thread doing the work
+ */
+void PlanarHullSolver::solveShare(size_t share, unsigned int thread) {
+	Worker &worker = this->workers[thread];
+	size_t n = this->points.size();
+	HullPointIndex begin = (HullPointIndex) (n * share / this->shares.size());
+	HullPointIndex end = (HullPointIndex) (n * (share + 1) / this->shares.size());
+	HullPointIndexList &sharePoints = this->shares[share];
+	ProjectedOrder order = { &this->points, (this->dropAxis + 1) % 3, (this->dropAxis + 2) % 3 };
+
+	if (begin == end) {
+		return;
+	}
+
+	const double *coordinates[3] = { this->points.getXArray(), this->points.getYArray(), this->points.getZArray() };
+	const double *s = coordinates[order.s];
+	const double *t = coordinates[order.t];
+	size_t stride = this->points.getStride();
+	HullPointIndex extremes[NUM_DIRECTIONS];
+	double best[NUM_DIRECTIONS];
+
+	for (int k = 0; k < NUM_DIRECTIONS; k++) {
+		extremes[k] = begin;
+		best[k] = DIRECTIONS[k][0] * s[begin * stride] + DIRECTIONS[k][1] * t[begin * stride];
+	}
+
+	for (HullPointIndex i = begin + 1; i < end; i++) {
+		for (int k = 0; k < NUM_DIRECTIONS; k++) {
+			double d = DIRECTIONS[k][0] * s[i * stride] + DIRECTIONS[k][1] * t[i * stride];
+
+			if (d > best[k]) {
+				extremes[k] = i;
+				best[k] = d;
+			}
+		}
+	}
+
+	// A point extreme in two directions is extreme in those between them,
+	// so any repeats among the corners are next to each other.
+	HullPointIndexList corners;
+
+	for (int k = 0; k < NUM_DIRECTIONS; k++) {
+		if (corners.empty() || !order.same(corners.back(), extremes[k])) {
+			corners.push_back(extremes[k]);
+		}
+	}
+
+	while (corners.size() > 1 && order.same(corners.back(), corners.front())) {
+		corners.pop_back();
+	}
+
+	size_t numCorners = corners.size();
+	double cornerS[NUM_DIRECTIONS], cornerT[NUM_DIRECTIONS], edgeS[NUM_DIRECTIONS], edgeT[NUM_DIRECTIONS];
+
+	for (size_t k = 0; k < numCorners; k++) {
+		cornerS[k] = s[corners[k] * stride];
+		cornerT[k] = t[corners[k] * stride];
+		edgeS[k] = s[corners[(k + 1) % numCorners] * stride] - cornerS[k];
+		edgeT[k] = t[corners[(k + 1) % numCorners] * stride] - cornerT[k];
+	}
+
+	sharePoints.clear();
+
+	for (HullPointIndex i = begin; i < end; i++) {
+		bool inside = (numCorners >= 3);
+
+		for (size_t k = 0; k < numCorners && inside; k++) {
+			double left = edgeS[k] * (t[i * stride] - cornerT[k]);
+			double right = edgeT[k] * (s[i * stride] - cornerS[k]);
+			inside = left - right > INSIDE_TOLERANCE * (fabs(left) + fabs(right));
+		}
+
+		if (!inside) {
+			sharePoints.push_back(i);
+		}
+	}
+
+	std::sort(sharePoints.begin(), sharePoints.end(), order);
+	chain(sharePoints, worker);
+}
+
+/**
+ * Andrew's monotone chain: the lower hull is built left to right and the
+ * upper hull right to left, each popping the points that would make a turn
+ * that isn't strictly counter-clockwise.  Points along the hull's edges
+ * are left out, as are all but one of any points that project to the same
+ * place.
+ *
+ * \param sortedPoints The points, sorted by their projected coordinates,
+ *   which are replaced by the vertices of their hull in counter-clockwise
+ *   order
+ * \param worker The worker doing the work
+ */
+void PlanarHullSolver::chain(HullPointIndexList &sortedPoints, Worker &worker) const {
+	ProjectedOrder order = { &this->points, (this->dropAxis + 1) % 3, (this->dropAxis + 2) % 3 };
+	size_t numUnique = 0;
+
+	for (size_t i = 0; i < sortedPoints.size(); i++) {
+		if (numUnique == 0 || !order.same(sortedPoints[numUnique - 1], sortedPoints[i])) {
+			sortedPoints[numUnique++] = sortedPoints[i];
+		}
+	}
+
+	sortedPoints.resize(numUnique);
+
+	if (sortedPoints.size() < 3) {
+		return;
+	}
+
+	HullPointIndexList hull;
+	hull.reserve(2 * sortedPoints.size());
+
+	for (size_t i = 0; i < sortedPoints.size(); i++) {
+		while (hull.size() >= 2 && HullPredicates::orientation2d(this->points, hull[hull.size() - 2],
+			hull.back(), sortedPoints[i], this->dropAxis, &worker.statistics) <= 0) {
+
+			hull.pop_back();
+		}
+
+		hull.push_back(sortedPoints[i]);
+	}
+
+	size_t lowerSize = hull.size();
+
+	for (size_t i = sortedPoints.size() - 1; i > 0; i--) {
+		while (hull.size() > lowerSize && HullPredicates::orientation2d(this->points, hull[hull.size() - 2],
+			hull.back(), sortedPoints[i - 1], this->dropAxis, &worker.statistics) <= 0) {
+
+			hull.pop_back();
+		}
+
+		hull.push_back(sortedPoints[i - 1]);
+	}
+
+	// The last point is the first one again.
+	hull.pop_back();
+	sortedPoints.swap(hull);
+}
+
+/**
+ * The front faces fan out from the polygon's first vertex, and the back
+ * faces from its second, so that no diagonal is used on both sides and
+ * every edge joins exactly two faces, as on a solid hull.
+ */
+void PlanarHullSolver::triangulate() {
+	this->hull.clear();
+
+	if (this->dimension < 2) {
+		return;
+	}
+
+	const HullPointIndexList &v = this->polygon;
+	size_t k = v.size();
+	HullFaceIndexList faces;
+
+	for (size_t i = 1; i + 1 < k; i++) {
+		faces.push_back(this->hull.addFace(HullFace(v[0], v[i], v[i + 1])));
+	}
+
+	for (size_t i = 2; i < k; i++) {
+		faces.push_back(this->hull.addFace(HullFace(v[1], v[(i + 1) % k], v[i])));
+	}
+
+	// Link each edge to the one running the other way.
+	typedef std::map<std::pair<HullPointIndex, HullPointIndex>, std::pair<HullFaceIndex, int> > EdgeMap;
+	EdgeMap edges;
+
+	for (HullFaceIndexList::const_iterator i = faces.begin(); i != faces.end(); i++) {
+		const HullFace &face = this->hull.getFace(*i);
+
+		for (int j = 0; j < 3; j++) {
+			HullPointIndex p0 = face.getPoint(j);
+			HullPointIndex p1 = face.getPoint((j + 1) % 3);
+			EdgeMap::iterator twin = edges.find(std::make_pair(p1, p0));
+
+			if (twin != edges.end()) {
+				this->hull.link(*i, j, twin->second.first, twin->second.second);
+				edges.erase(twin);
+			} else {
+				edges[std::make_pair(p0, p1)] = std::make_pair(*i, j);
+			}
+		}
+	}
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+void PlanarHullSolver::run(size_t numTasks, void (PlanarHullSolver::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
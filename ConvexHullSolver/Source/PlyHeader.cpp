@@ -0,0 +1,143 @@
+/**
+ * \file PlyHeader.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the PlyHeader class
+ */
+
+#include "PlyHeader.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+	/** The longest header that is looked for */
+	const size_t MAX_HEADER_SIZE = 1 << 20;
+
+}
+
+/**
+ * \param name The name of the property
+ * \return The position of the property within the element, or -1 if the
+ *   element has no such property
+ */
+int PlyHeader::Element::findProperty(const string &name) const {
+	for (size_t i = 0; i < this->properties.size(); i++) {
+		if (this->properties[i].name == name) {
+			return (int) i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * \param data The start of the file
+ * \param size The size of the file, in bytes
+ */
+PlyHeader::PlyHeader(const char *data, size_t size) {
+	const char *marker = "end_header";
+	size_t markerLength = strlen(marker);
+	size_t searchEnd = (size < MAX_HEADER_SIZE) ? size : MAX_HEADER_SIZE;
+
+	this->size = 0;
+
+	if (!matches(data, size)) {
+		this->error = "not a PLY file";
+		return;
+	}
+
+	// The header ends with the line "end_header".
+	for (size_t i = 1; i + markerLength < searchEnd && this->size == 0; i++) {
+		if (data[i - 1] == '\n' && memcmp(data + i, marker, markerLength) == 0) {
+			size_t end = i + markerLength;
+
+			if (end < searchEnd && data[end] == '\r') {
+				end++;
+			}
+
+			if (end < searchEnd && data[end] == '\n') {
+				this->size = end + 1;
+			}
+		}
+	}
+
+	if (this->size == 0) {
+		this->error = "the PLY header has no end";
+		return;
+	}
+
+	istringstream header(string(data, this->size));
+	string line;
+
+	while (getline(header, line)) {
+		istringstream words(line);
+		string keyword;
+		words >> keyword;
+
+		if (keyword == "format") {
+			words >> this->format;
+		} else if (keyword == "element") {
+			Element element;
+			element.count = 0;
+			words >> element.name >> element.count;
+			this->elements.push_back(element);
+		} else if (keyword == "property") {
+			Property property;
+			words >> property.type;
+			property.list = (property.type == "list");
+
+			if (property.list) {
+				string countType;
+				words >> countType >> property.type;
+			}
+
+			words >> property.name;
+
+			if (getTypeSize(property.type) == 0) {
+				this->error = "the PLY header has a property of unknown type";
+				return;
+			}
+
+			if (this->elements.empty()) {
+				this->error = "the PLY header has a property outside of any element";
+				return;
+			}
+
+			this->elements.back().properties.push_back(property);
+		}
+	}
+
+	if (this->format.empty()) {
+		this->error = "the PLY header has no format";
+	}
+}
+
+/**
+ * \param data The start of the file
+ * \param size The size of the file, in bytes
+ * \return Whether or not the file starts with the line "ply"
+ */
+bool PlyHeader::matches(const char *data, size_t size) {
+	return size >= 4 && memcmp(data, "ply", 3) == 0 && (data[3] == '\n' || data[3] == '\r');
+}
+
+/**
+ * \param type The name of the type
+ * \return The size of the type in bytes, or 0 if it isn't a scalar type
+ */
+size_t PlyHeader::getTypeSize(const string &type) {
+	if (type == "char" || type == "uchar" || type == "int8" || type == "uint8") {
+		return 1;
+	} else if (type == "short" || type == "ushort" || type == "int16" || type == "uint16") {
+		return 2;
+	} else if (type == "int" || type == "uint" || type == "int32" || type == "uint32"
+		|| type == "float" || type == "float32") {
+
+		return 4;
+	} else if (type == "double" || type == "float64") {
+		return 8;
+	}
+
+	return 0;
+}
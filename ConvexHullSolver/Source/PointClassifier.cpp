@@ -0,0 +1,680 @@
+/**
+ * \file PointClassifier.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the PointClassifier class
+ */
+
+#include "PointClassifier.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CHS_X86
+#endif
+
+// Visual C++ has the AVX2 and FMA intrinsics, and _xgetbv(), from 2012, and
+// the AVX-512 intrinsics from 2017 15.3.  Older versions are left with the
+// SSE2 kernels.
+#if defined(CHS_X86) && (!defined(_MSC_VER) || _MSC_VER >= 1700)
+#define CHS_AVX2
+#include <immintrin.h>
+#elif defined(CHS_X86)
+#include <emmintrin.h>
+#endif
+
+#if defined(CHS_AVX2) && (!defined(_MSC_VER) || _MSC_VER >= 1911)
+#define CHS_AVX512
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CHS_TARGET(isa)
+#else
+#define CHS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace {
+
+	/** Gets the instruction set in use, detecting it on first use */
+	PointClassifier::InstructionSet &currentInstructionSet() {
+		static PointClassifier::InstructionSet instructionSet = PointClassifier::getSupportedInstructionSet();
+		return instructionSet;
+	}
+
+	template <typename T>
+	size_t classifyScalar(const T plane[4], T threshold,
+		const T *x, const T *y, const T *z, size_t count,
+		T *distances, unsigned char *mask) {
+
+		size_t numFlagged = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			T d = plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] - plane[3];
+			distances[i] = d;
+			mask[i] = (d > -threshold) ? 1 : 0;
+			numFlagged += mask[i];
+		}
+
+		return numFlagged;
+	}
+
+	template <typename T>
+	size_t classifyIndexedScalar(const T plane[4], T threshold,
+		const T *x, const T *y, const T *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		T *distances, unsigned char *mask) {
+
+		size_t numFlagged = 0;
+
+		for (size_t i = 0; i < count; i++) {
+			size_t p = indices[i] * stride;
+			T d = plane[0] * x[p] + plane[1] * y[p] + plane[2] * z[p] - plane[3];
+			distances[i] = d;
+			mask[i] = (d > -threshold) ? 1 : 0;
+			numFlagged += mask[i];
+		}
+
+		return numFlagged;
+	}
+
+	/** Expands the low bits of a comparison result into mask bytes */
+	inline size_t expandBits(unsigned int bits, int numBits, unsigned char *mask) {
+		size_t numFlagged = 0;
+
+		for (int j = 0; j < numBits; j++) {
+			mask[j] = (unsigned char) ((bits >> j) & 1);
+			numFlagged += mask[j];
+		}
+
+		return numFlagged;
+	}
+
+#ifdef CHS_X86
+
+	CHS_TARGET("sse2")
+	size_t classifySse2(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m128d nx = _mm_set1_pd(plane[0]);
+		__m128d ny = _mm_set1_pd(plane[1]);
+		__m128d nz = _mm_set1_pd(plane[2]);
+		__m128d offset = _mm_set1_pd(plane[3]);
+		__m128d limit = _mm_set1_pd(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 2 <= count; i += 2) {
+			__m128d d = _mm_mul_pd(nx, _mm_loadu_pd(x + i));
+			d = _mm_add_pd(d, _mm_mul_pd(ny, _mm_loadu_pd(y + i)));
+			d = _mm_add_pd(d, _mm_mul_pd(nz, _mm_loadu_pd(z + i)));
+			d = _mm_sub_pd(d, offset);
+			_mm_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm_movemask_pd(_mm_cmpgt_pd(d, limit)), 2, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	CHS_TARGET("sse2")
+	size_t classifyIndexedSse2(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m128d nx = _mm_set1_pd(plane[0]);
+		__m128d ny = _mm_set1_pd(plane[1]);
+		__m128d nz = _mm_set1_pd(plane[2]);
+		__m128d offset = _mm_set1_pd(plane[3]);
+		__m128d limit = _mm_set1_pd(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 2 <= count; i += 2) {
+			size_t p0 = indices[i] * stride;
+			size_t p1 = indices[i + 1] * stride;
+			__m128d d = _mm_mul_pd(nx, _mm_set_pd(x[p1], x[p0]));
+			d = _mm_add_pd(d, _mm_mul_pd(ny, _mm_set_pd(y[p1], y[p0])));
+			d = _mm_add_pd(d, _mm_mul_pd(nz, _mm_set_pd(z[p1], z[p0])));
+			d = _mm_sub_pd(d, offset);
+			_mm_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm_movemask_pd(_mm_cmpgt_pd(d, limit)), 2, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#ifdef CHS_AVX2
+
+	CHS_TARGET("avx2,fma")
+	size_t classifyAvx2(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m256d nx = _mm256_set1_pd(plane[0]);
+		__m256d ny = _mm256_set1_pd(plane[1]);
+		__m256d nz = _mm256_set1_pd(plane[2]);
+		__m256d offset = _mm256_set1_pd(plane[3]);
+		__m256d limit = _mm256_set1_pd(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+			__m256d d = _mm256_fmsub_pd(nx, _mm256_loadu_pd(x + i), offset);
+			d = _mm256_fmadd_pd(ny, _mm256_loadu_pd(y + i), d);
+			d = _mm256_fmadd_pd(nz, _mm256_loadu_pd(z + i), d);
+			_mm256_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm256_movemask_pd(_mm256_cmp_pd(d, limit, _CMP_GT_OQ)), 4, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	CHS_TARGET("avx2,fma")
+	size_t classifyIndexedAvx2(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m256d nx = _mm256_set1_pd(plane[0]);
+		__m256d ny = _mm256_set1_pd(plane[1]);
+		__m256d nz = _mm256_set1_pd(plane[2]);
+		__m256d offset = _mm256_set1_pd(plane[3]);
+		__m256d limit = _mm256_set1_pd(-threshold);
+		__m256i scale = _mm256_set1_epi64x((long long) stride);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		// The indices are widened before they are scaled, since the gathers
+		// treat them as signed and the product may not fit in 32 bits.
+		for (; i + 4 <= count; i += 4) {
+			__m256i p = _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (indices + i))), scale);
+			__m256d d = _mm256_fmsub_pd(nx, _mm256_i64gather_pd(x, p, 8), offset);
+			d = _mm256_fmadd_pd(ny, _mm256_i64gather_pd(y, p, 8), d);
+			d = _mm256_fmadd_pd(nz, _mm256_i64gather_pd(z, p, 8), d);
+			_mm256_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm256_movemask_pd(_mm256_cmp_pd(d, limit, _CMP_GT_OQ)), 4, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#endif
+
+#ifdef CHS_AVX512
+
+	CHS_TARGET("avx512f")
+	size_t classifyAvx512(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m512d nx = _mm512_set1_pd(plane[0]);
+		__m512d ny = _mm512_set1_pd(plane[1]);
+		__m512d nz = _mm512_set1_pd(plane[2]);
+		__m512d offset = _mm512_set1_pd(plane[3]);
+		__m512d limit = _mm512_set1_pd(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+			__m512d d = _mm512_fmsub_pd(nx, _mm512_loadu_pd(x + i), offset);
+			d = _mm512_fmadd_pd(ny, _mm512_loadu_pd(y + i), d);
+			d = _mm512_fmadd_pd(nz, _mm512_loadu_pd(z + i), d);
+			_mm512_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm512_cmp_pd_mask(d, limit, _CMP_GT_OQ), 8, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	CHS_TARGET("avx512f")
+	size_t classifyIndexedAvx512(const double plane[4], double threshold,
+		const double *x, const double *y, const double *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		double *distances, unsigned char *mask) {
+
+		__m512d nx = _mm512_set1_pd(plane[0]);
+		__m512d ny = _mm512_set1_pd(plane[1]);
+		__m512d nz = _mm512_set1_pd(plane[2]);
+		__m512d offset = _mm512_set1_pd(plane[3]);
+		__m512d limit = _mm512_set1_pd(-threshold);
+		__m512i scale = _mm512_set1_epi64((long long) stride);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+			__m512i p = _mm512_mul_epu32(_mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *) (indices + i))), scale);
+			__m512d d = _mm512_fmsub_pd(nx, _mm512_i64gather_pd(p, x, 8), offset);
+			d = _mm512_fmadd_pd(ny, _mm512_i64gather_pd(p, y, 8), d);
+			d = _mm512_fmadd_pd(nz, _mm512_i64gather_pd(p, z, 8), d);
+			_mm512_storeu_pd(distances + i, d);
+			numFlagged += expandBits(_mm512_cmp_pd_mask(d, limit, _CMP_GT_OQ), 8, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#endif
+
+	CHS_TARGET("sse2")
+	size_t classifySse2(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m128 nx = _mm_set1_ps(plane[0]);
+		__m128 ny = _mm_set1_ps(plane[1]);
+		__m128 nz = _mm_set1_ps(plane[2]);
+		__m128 offset = _mm_set1_ps(plane[3]);
+		__m128 limit = _mm_set1_ps(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+			__m128 d = _mm_mul_ps(nx, _mm_loadu_ps(x + i));
+			d = _mm_add_ps(d, _mm_mul_ps(ny, _mm_loadu_ps(y + i)));
+			d = _mm_add_ps(d, _mm_mul_ps(nz, _mm_loadu_ps(z + i)));
+			d = _mm_sub_ps(d, offset);
+			_mm_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm_movemask_ps(_mm_cmpgt_ps(d, limit)), 4, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	CHS_TARGET("sse2")
+	size_t classifyIndexedSse2(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m128 nx = _mm_set1_ps(plane[0]);
+		__m128 ny = _mm_set1_ps(plane[1]);
+		__m128 nz = _mm_set1_ps(plane[2]);
+		__m128 offset = _mm_set1_ps(plane[3]);
+		__m128 limit = _mm_set1_ps(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4) {
+			size_t p0 = indices[i] * stride;
+			size_t p1 = indices[i + 1] * stride;
+			size_t p2 = indices[i + 2] * stride;
+			size_t p3 = indices[i + 3] * stride;
+			__m128 d = _mm_mul_ps(nx, _mm_set_ps(x[p3], x[p2], x[p1], x[p0]));
+			d = _mm_add_ps(d, _mm_mul_ps(ny, _mm_set_ps(y[p3], y[p2], y[p1], y[p0])));
+			d = _mm_add_ps(d, _mm_mul_ps(nz, _mm_set_ps(z[p3], z[p2], z[p1], z[p0])));
+			d = _mm_sub_ps(d, offset);
+			_mm_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm_movemask_ps(_mm_cmpgt_ps(d, limit)), 4, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#ifdef CHS_AVX2
+
+	CHS_TARGET("avx2,fma")
+	size_t classifyAvx2(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m256 nx = _mm256_set1_ps(plane[0]);
+		__m256 ny = _mm256_set1_ps(plane[1]);
+		__m256 nz = _mm256_set1_ps(plane[2]);
+		__m256 offset = _mm256_set1_ps(plane[3]);
+		__m256 limit = _mm256_set1_ps(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 8 <= count; i += 8) {
+			__m256 d = _mm256_fmsub_ps(nx, _mm256_loadu_ps(x + i), offset);
+			d = _mm256_fmadd_ps(ny, _mm256_loadu_ps(y + i), d);
+			d = _mm256_fmadd_ps(nz, _mm256_loadu_ps(z + i), d);
+			_mm256_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm256_movemask_ps(_mm256_cmp_ps(d, limit, _CMP_GT_OQ)), 8, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	/** Gathers eight floats at two registers of 64-bit offsets */
+	CHS_TARGET("avx2,fma")
+	inline __m256 gatherAvx2(const float *base, __m256i p0, __m256i p1) {
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_i64gather_ps(base, p0, 4)),
+			_mm256_i64gather_ps(base, p1, 4), 1);
+	}
+
+	CHS_TARGET("avx2,fma")
+	size_t classifyIndexedAvx2(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m256 nx = _mm256_set1_ps(plane[0]);
+		__m256 ny = _mm256_set1_ps(plane[1]);
+		__m256 nz = _mm256_set1_ps(plane[2]);
+		__m256 offset = _mm256_set1_ps(plane[3]);
+		__m256 limit = _mm256_set1_ps(-threshold);
+		__m256i scale = _mm256_set1_epi64x((long long) stride);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		// The widened indices only fill half a register each, so each half of
+		// the points is gathered separately.
+		for (; i + 8 <= count; i += 8) {
+			__m256i p0 = _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (indices + i))), scale);
+			__m256i p1 = _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *) (indices + i + 4))), scale);
+			__m256 d = _mm256_fmsub_ps(nx, gatherAvx2(x, p0, p1), offset);
+			d = _mm256_fmadd_ps(ny, gatherAvx2(y, p0, p1), d);
+			d = _mm256_fmadd_ps(nz, gatherAvx2(z, p0, p1), d);
+			_mm256_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm256_movemask_ps(_mm256_cmp_ps(d, limit, _CMP_GT_OQ)), 8, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#endif
+
+#ifdef CHS_AVX512
+
+	CHS_TARGET("avx512f")
+	size_t classifyAvx512(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m512 nx = _mm512_set1_ps(plane[0]);
+		__m512 ny = _mm512_set1_ps(plane[1]);
+		__m512 nz = _mm512_set1_ps(plane[2]);
+		__m512 offset = _mm512_set1_ps(plane[3]);
+		__m512 limit = _mm512_set1_ps(-threshold);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 16 <= count; i += 16) {
+			__m512 d = _mm512_fmsub_ps(nx, _mm512_loadu_ps(x + i), offset);
+			d = _mm512_fmadd_ps(ny, _mm512_loadu_ps(y + i), d);
+			d = _mm512_fmadd_ps(nz, _mm512_loadu_ps(z + i), d);
+			_mm512_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm512_cmp_ps_mask(d, limit, _CMP_GT_OQ), 16, mask + i);
+		}
+
+		return numFlagged + classifyScalar(plane, threshold, x + i, y + i, z + i, count - i,
+			distances + i, mask + i);
+	}
+
+	/** Gathers sixteen floats at two registers of 64-bit offsets */
+	CHS_TARGET("avx512f")
+	inline __m512 gatherAvx512(const float *base, __m512i p0, __m512i p1) {
+		__m512d low = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_i64gather_ps(p0, base, 4)));
+		return _mm512_castpd_ps(_mm512_insertf64x4(low, _mm256_castps_pd(_mm512_i64gather_ps(p1, base, 4)), 1));
+	}
+
+	CHS_TARGET("avx512f")
+	size_t classifyIndexedAvx512(const float plane[4], float threshold,
+		const float *x, const float *y, const float *z, size_t stride,
+		const HullPointIndex *indices, size_t count,
+		float *distances, unsigned char *mask) {
+
+		__m512 nx = _mm512_set1_ps(plane[0]);
+		__m512 ny = _mm512_set1_ps(plane[1]);
+		__m512 nz = _mm512_set1_ps(plane[2]);
+		__m512 offset = _mm512_set1_ps(plane[3]);
+		__m512 limit = _mm512_set1_ps(-threshold);
+		__m512i scale = _mm512_set1_epi64((long long) stride);
+		size_t numFlagged = 0;
+		size_t i = 0;
+
+		for (; i + 16 <= count; i += 16) {
+			__m512i p0 = _mm512_mul_epu32(_mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *) (indices + i))), scale);
+			__m512i p1 = _mm512_mul_epu32(_mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i *) (indices + i + 8))),
+				scale);
+			__m512 d = _mm512_fmsub_ps(nx, gatherAvx512(x, p0, p1), offset);
+			d = _mm512_fmadd_ps(ny, gatherAvx512(y, p0, p1), d);
+			d = _mm512_fmadd_ps(nz, gatherAvx512(z, p0, p1), d);
+			_mm512_storeu_ps(distances + i, d);
+			numFlagged += expandBits(_mm512_cmp_ps_mask(d, limit, _CMP_GT_OQ), 16, mask + i);
+		}
+
+		return numFlagged + classifyIndexedScalar(plane, threshold, x, y, z, stride, indices + i, count - i,
+			distances + i, mask + i);
+	}
+
+#endif
+
+#endif
+
+}
+
+/**
+ * \return The instruction set
+ */
+PointClassifier::InstructionSet PointClassifier::getSupportedInstructionSet() {
+#if defined(CHS_X86) && defined(_MSC_VER) && defined(CHS_AVX2)
+	int info[4];
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	bool fma = (info[2] & (1 << 12)) != 0;
+	unsigned __int64 xcr0 = osxsave ? _xgetbv(0) : 0;
+
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+
+	// The operating system must also save the wider registers on a context
+	// switch.
+#ifdef CHS_AVX512
+	bool avx512f = (info[1] & (1 << 16)) != 0;
+
+	if (avx512f && (xcr0 & 0xe6) == 0xe6) {
+		return AVX512;
+	}
+#endif
+
+	if (avx && avx2 && fma && (xcr0 & 0x06) == 0x06) {
+		return AVX2;
+	}
+
+	return SSE2;
+#elif defined(CHS_X86) && defined(_MSC_VER)
+	return SSE2;
+#elif defined(CHS_X86)
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f")) {
+		return AVX512;
+	}
+
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		return AVX2;
+	}
+
+	if (__builtin_cpu_supports("sse2")) {
+		return SSE2;
+	}
+
+	return SCALAR;
+#else
+	return SCALAR;
+#endif
+}
+
+/**
+ * \return The instruction set
+ */
+PointClassifier::InstructionSet PointClassifier::getInstructionSet() {
+	return currentInstructionSet();
+}
+
+/**
+ * This is meant for measuring and comparing the kernels.  It is not safe to
+ * call while points are being classified on another thread.
+ *
+ * \param instructionSet The instruction set to use
+ * \return The instruction set actually selected, which is the requested one
+ *   or the best supported one, whichever is lesser
+ */
+PointClassifier::InstructionSet PointClassifier::setInstructionSet(InstructionSet instructionSet) {
+	InstructionSet supported = getSupportedInstructionSet();
+	currentInstructionSet() = (instructionSet < supported) ? instructionSet : supported;
+	return currentInstructionSet();
+}
+
+/**
+ * \param instructionSet The instruction set
+ * \return The instruction set's name
+ */
+const char *PointClassifier::getName(InstructionSet instructionSet) {
+	switch (instructionSet) {
+		case SSE2: return "SSE2";
+		case AVX2: return "AVX2";
+		case AVX512: return "AVX-512";
+		default: return "scalar";
+	}
+}
+
+/**
+ * A point is flagged if its distance is greater than -threshold.  Points that
+ * aren't flagged are certainly behind the plane; those that are flagged with
+ * a distance no greater than threshold are too close to call, and should be
+ * checked more carefully by the caller.
+ *
+ * \param plane The plane's unit normal (x, y and z) and offset
+ * \param threshold The bound on the error of the computed distances
+ * \param x The points' x-coordinates
+ * \param y The points' y-coordinates
+ * \param z The points' z-coordinates
+ * \param count The number of points
+ * \param distances Receives the signed distance of each point
+ * \param mask Receives 1 for each flagged point and 0 for the others
+ * \return The number of flagged points
+ */
+size_t PointClassifier::classify(const double plane[4], double threshold,
+	const double *x, const double *y, const double *z, size_t count,
+	double *distances, unsigned char *mask) {
+
+	switch (currentInstructionSet()) {
+#ifdef CHS_X86
+#ifdef CHS_AVX512
+		case AVX512: return classifyAvx512(plane, threshold, x, y, z, count, distances, mask);
+#endif
+#ifdef CHS_AVX2
+		case AVX2: return classifyAvx2(plane, threshold, x, y, z, count, distances, mask);
+#endif
+		case SSE2: return classifySse2(plane, threshold, x, y, z, count, distances, mask);
+#endif
+		default: return classifyScalar(plane, threshold, x, y, z, count, distances, mask);
+	}
+}
+
+/**
+ * Works like classify(), but reads the points at the given indices rather
+ * than consecutive points.  The stride must be less than 2^32.
+ *
+ * \param plane The plane's unit normal (x, y and z) and offset
+ * \param threshold The bound on the error of the computed distances
+ * \param x The x-coordinates of all points
+ * \param y The y-coordinates of all points
+ * \param z The z-coordinates of all points
+ * \param stride The number of doubles from one point to the next in each array
+ * \param indices The indices of the points to classify
+ * \param count The number of indices
+ * \param distances Receives the signed distance of each point
+ * \param mask Receives 1 for each flagged point and 0 for the others
+ * \return The number of flagged points
+ */
+size_t PointClassifier::classifyIndexed(const double plane[4], double threshold,
+	const double *x, const double *y, const double *z, size_t stride,
+	const HullPointIndex *indices, size_t count,
+	double *distances, unsigned char *mask) {
+
+	switch (currentInstructionSet()) {
+#ifdef CHS_X86
+#ifdef CHS_AVX512
+		case AVX512: return classifyIndexedAvx512(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+#ifdef CHS_AVX2
+		case AVX2: return classifyIndexedAvx2(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+		case SSE2: return classifyIndexedSse2(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+		default: return classifyIndexedScalar(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+	}
+}
+
+/**
+ * Works like the double version of classify(), eight points at a time with
+ * AVX2 and sixteen with AVX-512.  The distances are computed in float, so
+ * the threshold must bound the error of float arithmetic.
+ *
+ * \param plane The plane's unit normal (x, y and z) and offset
+ * \param threshold The bound on the error of the computed distances
+ * \param x The points' x-coordinates
+ * \param y The points' y-coordinates
+ * \param z The points' z-coordinates
+ * \param count The number of points
+ * \param distances Receives the signed distance of each point
+ * \param mask Receives 1 for each flagged point and 0 for the others
+ * \return The number of flagged points
+ */
+size_t PointClassifier::classify(const float plane[4], float threshold,
+	const float *x, const float *y, const float *z, size_t count,
+	float *distances, unsigned char *mask) {
+
+	switch (currentInstructionSet()) {
+#ifdef CHS_X86
+#ifdef CHS_AVX512
+		case AVX512: return classifyAvx512(plane, threshold, x, y, z, count, distances, mask);
+#endif
+#ifdef CHS_AVX2
+		case AVX2: return classifyAvx2(plane, threshold, x, y, z, count, distances, mask);
+#endif
+		case SSE2: return classifySse2(plane, threshold, x, y, z, count, distances, mask);
+#endif
+		default: return classifyScalar(plane, threshold, x, y, z, count, distances, mask);
+	}
+}
+
+/**
+ * Works like the double version of classifyIndexed(), with the same limit
+ * on the stride.
+ *
+ * \param plane The plane's unit normal (x, y and z) and offset
+ * \param threshold The bound on the error of the computed distances
+ * \param x The x-coordinates of all points
+ * \param y The y-coordinates of all points
+ * \param z The z-coordinates of all points
+ * \param stride The number of floats from one point to the next in each array
+ * \param indices The indices of the points to classify
+ * \param count The number of indices
+ * \param distances Receives the signed distance of each point
+ * \param mask Receives 1 for each flagged point and 0 for the others
+ * \return The number of flagged points
+ */
+size_t PointClassifier::classifyIndexed(const float plane[4], float threshold,
+	const float *x, const float *y, const float *z, size_t stride,
+	const HullPointIndex *indices, size_t count,
+	float *distances, unsigned char *mask) {
+
+	switch (currentInstructionSet()) {
+#ifdef CHS_X86
+#ifdef CHS_AVX512
+		case AVX512: return classifyIndexedAvx512(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+#ifdef CHS_AVX2
+		case AVX2: return classifyIndexedAvx2(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+		case SSE2: return classifyIndexedSse2(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+#endif
+		default: return classifyIndexedScalar(plane, threshold, x, y, z, stride, indices, count, distances, mask);
+	}
+}
@@ -0,0 +1,83 @@
+/**
+ * \file RawPointFileSource.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the RawPointFileSource class
+ */
+
+#include "RawPointFileSource.h"
+#include <cstring>
+
+const size_t RawPointFileSource::BLOCK_SIZE;
+
+/**
+ * \param path The file to read
+ * \param format The type of the coordinates in the file
+ * \param headerBytes The number of bytes to skip at the start of the file
+ */
+RawPointFileSource::RawPointFileSource(const char *path, Format format, size_t headerBytes) {
+	this->file = fopen(path, "rb");
+	this->format = format;
+
+	if (this->file != NULL && headerBytes > 0 && fseek(this->file, (long) headerBytes, SEEK_SET) != 0) {
+		fclose(this->file);
+		this->file = NULL;
+	}
+}
+
+RawPointFileSource::~RawPointFileSource() {
+	if (this->file != NULL) {
+		fclose(this->file);
+	}
+}
+
+/**
+ * The points are read in blocks of raw bytes and spread out into the three
+ * arrays.  A partial point at the end of the file is ignored.
+ *
+ * \param x Receives the x-coordinates of the points read
+ * \param y Receives the y-coordinates of the points read
+ * \param z Receives the z-coordinates of the points read
+ * \param maxPoints The most points to read
+ * \return The number of points read, which is less than maxPoints only at
+ *   the end of the file (or if it couldn't be read)
+ */
+size_t RawPointFileSource::read(double *x, double *y, double *z, size_t maxPoints) {
+	size_t scalarBytes = (this->format == FLOAT) ? sizeof(float) : sizeof(double);
+	size_t pointBytes = 3 * scalarBytes;
+	size_t numRead = 0;
+
+	if (this->file == NULL) {
+		return 0;
+	}
+
+	this->block.resize(BLOCK_SIZE * pointBytes);
+
+	while (numRead < maxPoints) {
+		size_t numWanted = (maxPoints - numRead < BLOCK_SIZE) ? maxPoints - numRead : BLOCK_SIZE;
+		size_t numBlockPoints = fread(&this->block[0], pointBytes, numWanted, this->file);
+		const char *bytes = &this->block[0];
+
+		for (size_t i = 0; i < numBlockPoints; i++, numRead++, bytes += pointBytes) {
+			if (this->format == FLOAT) {
+				float coordinates[3];
+				memcpy(coordinates, bytes, sizeof(coordinates));
+				x[numRead] = coordinates[0];
+				y[numRead] = coordinates[1];
+				z[numRead] = coordinates[2];
+			} else {
+				double coordinates[3];
+				memcpy(coordinates, bytes, sizeof(coordinates));
+				x[numRead] = coordinates[0];
+				y[numRead] = coordinates[1];
+				z[numRead] = coordinates[2];
+			}
+		}
+
+		if (numBlockPoints < numWanted) {
+			break;
+		}
+	}
+
+	return numRead;
+}
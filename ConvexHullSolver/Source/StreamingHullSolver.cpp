@@ -0,0 +1,300 @@
+/**
+ * \file StreamingHullSolver.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the StreamingHullSolver class
+ */
+
+#include "StreamingHullSolver.h"
+#include "PlanarHullSolver.h"
+#include <boost/bind.hpp>
+#include <algorithm>
+
+using namespace peek;
+
+const size_t StreamingHullSolver::DEFAULT_MEMORY_BUDGET;
+const size_t StreamingHullSolver::MIN_CHUNK_SIZE;
+const unsigned int StreamingHullSolver::FILTER_DIRECTIONS;
+
+namespace {
+
+	/**
+	 * About how many bytes the solver takes for each point it holds: the
+	 * coordinates twice over (since the points are copied whenever they are
+	 * cut down), an entry in the conflict graph, and some two faces for each
+	 * vertex of the hull
+	 */
+	const size_t BYTES_PER_POINT = 6 * sizeof(double) + sizeof(HullFaceIndex) + 2 * sizeof(ConvexHullSolver::Face);
+
+	/** Gets whether p comes before q by x, then y, then z */
+	bool isLower(const HullPointBuffer &points, HullPointIndex p, HullPointIndex q) {
+		if (points.getX(p) != points.getX(q)) {
+			return points.getX(p) < points.getX(q);
+		}
+
+		if (points.getY(p) != points.getY(q)) {
+			return points.getY(p) < points.getY(q);
+		}
+
+		return points.getZ(p) < points.getZ(q);
+	}
+
+}
+
+/**
+ * A quarter of the budget goes to the two chunk buffers, and the rest to
+ * the solver.  The first chunk starts being read right away.
+ *
+ * \param source Where the points come from, which must outlive the solver
+ * \param memoryBudget About how many bytes the solver may use
+ * \param numThreads The number of threads to solve with (0 for one per
+ *   processor).  The chunks are read on a thread of their own besides.
+ */
+StreamingHullSolver::StreamingHullSolver(HullPointSource &source, size_t memoryBudget, unsigned int numThreads)
+	: source(source),
+	solver(new ConvexHullSolver(HullPointBuffer(), HullFaceScheduler::FURTHEST_FIRST, FILTER_DIRECTIONS, numThreads)) {
+
+	size_t chunkBytes = 3 * sizeof(double);
+	size_t solverBudget = memoryBudget - memoryBudget / 4;
+
+	this->memoryBudget = memoryBudget;
+	this->chunkSize = std::max(MIN_CHUNK_SIZE, memoryBudget / 4 / (2 * chunkBytes));
+	this->maxPointsKept = std::max(2 * this->chunkSize, solverBudget / BYTES_PER_POINT);
+	this->current = 0;
+	this->numPointsRead = 0;
+	this->peakPointsKept = 0;
+	this->complete = false;
+
+	for (int i = 0; i < 2; i++) {
+		this->chunks[i].x.resize(this->chunkSize);
+		this->chunks[i].y.resize(this->chunkSize);
+		this->chunks[i].z.resize(this->chunkSize);
+		this->chunks[i].size = 0;
+	}
+
+	startReading(this->current);
+}
+
+StreamingHullSolver::~StreamingHullSolver() {
+	finishReading();
+}
+
+/**
+ * The next chunk starts being read before this one is taken in, unless
+ * this one came up short, which means the source has run dry.  A chunk is
+ * inserted into the hull if the hull has at least a quarter as many
+ * vertices as the chunk has points (by then, solving the two from scratch
+ * would spend most of its time rebuilding the hull), and merged with it
+ * otherwise.  Before a chunk is inserted, the points are cut down to the
+ * hull's vertices if they would go over budget, but only if at least half
+ * of them would go, so that a hull too large for the budget isn't rebuilt
+ * for every chunk.  Once the last chunk is in, the points are cut down the
+ * same way one last time, and if they lie in a plane, their polygon is
+ * found.
+ */
+void StreamingHullSolver::iterate() {
+	if (this->complete) {
+		return;
+	}
+
+	finishReading();
+
+	const Chunk &chunk = this->chunks[this->current];
+	bool last = chunk.size < this->chunkSize;
+
+	if (!last) {
+		startReading(1 - this->current);
+	}
+
+	if (chunk.size > 0) {
+		this->numPointsRead += chunk.size;
+
+		if (4 * countVertices() >= chunk.size) {
+			size_t numPoints = this->solver->getPoints().size();
+
+			if (numPoints + chunk.size > this->maxPointsKept && numPoints >= 2 * countVertices()) {
+				HullPointBuffer kept;
+				keepVertices(kept);
+				this->solver->reset(kept);
+				this->solver->iterateToCompletion();
+			}
+
+			this->solver->insert(HullPointBuffer(&chunk.x[0], &chunk.y[0], &chunk.z[0], chunk.size));
+			this->solver->iterateToCompletion();
+		} else {
+			merge(chunk);
+		}
+
+		this->peakPointsKept = std::max(this->peakPointsKept, this->solver->getPoints().size());
+	}
+
+	this->current = 1 - this->current;
+
+	if (last) {
+		if (this->solver->getPoints().size() >= 2 * countVertices()) {
+			HullPointBuffer kept;
+			keepVertices(kept);
+			this->solver->reset(kept);
+			this->solver->iterateToCompletion();
+		}
+
+		solvePlanar();
+		this->complete = true;
+	}
+}
+
+void StreamingHullSolver::iterateToCompletion() {
+	while (!this->complete) {
+		iterate();
+	}
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+void StreamingHullSolver::setNumThreads(unsigned int numThreads) {
+	this->solver->setNumThreads(numThreads);
+
+	if (this->planar.get() != NULL) {
+		this->planar->setNumThreads(numThreads);
+	}
+}
+
+/**
+ * \return Counts of how often each stage of point classification was
+ *   reached, over every chunk
+ */
+HullPredicateStatistics StreamingHullSolver::getStatistics() const {
+	return this->solver->getStatistics();
+}
+
+/**
+ * Each face has three edges and each edge two faces, so by Euler's
+ * formula, a hull with f triangular faces has f / 2 + 2 vertices.
+ *
+ * \return The number of vertices of the solver's hull (0 if it isn't solid)
+ */
+size_t StreamingHullSolver::countVertices() const {
+	return (this->solver->getDimension() == 3) ? this->solver->getMesh().getNumFaces() / 2 + 2 : 0;
+}
+
+/**
+ * The test is the one HullSolver::create() makes, but over the points
+ * kept rather than all of the points read, since only those are left.
+ * They take in every point of the polygon, so the two can only differ
+ * for points that are nearly planar.
+ */
+void StreamingHullSolver::solvePlanar() {
+	const HullPointBuffer &points = this->solver->getPoints();
+	double normal[3];
+
+	if (points.size() > 0 && (this->solver->getDimension() < 3
+		|| PlanarHullSolver::fitPlane(points, normal) <= PlanarHullSolver::DEFAULT_TOLERANCE)) {
+
+		this->planar.reset(new PlanarHullSolver(points, this->solver->getNumThreads()));
+		this->planar->iterateToCompletion();
+	}
+}
+
+/**
+ * \param buffer The buffer to read into
+ */
+void StreamingHullSolver::startReading(int buffer) {
+	this->reader.reset(new boost::thread(boost::bind(&StreamingHullSolver::readChunk, this, buffer)));
+}
+
+/**
+ * \param buffer The buffer to read into
+ */
+void StreamingHullSolver::readChunk(int buffer) {
+	Chunk &chunk = this->chunks[buffer];
+	chunk.size = this->source.read(&chunk.x[0], &chunk.y[0], &chunk.z[0], this->chunkSize);
+}
+
+void StreamingHullSolver::finishReading() {
+	if (this->reader.get() != NULL) {
+		this->reader->join();
+		this->reader.reset();
+	}
+}
+
+/**
+ * \param chunk The chunk to take in
+ */
+void StreamingHullSolver::merge(const Chunk &chunk) {
+	HullPointBuffer merged;
+	keepVertices(merged);
+	merged.append(HullPointBuffer(&chunk.x[0], &chunk.y[0], &chunk.z[0], chunk.size));
+
+	this->solver->reset(merged);
+	this->solver->iterateToCompletion();
+}
+
+/**
+ * A solid hull needs only its vertices.  If the points so far are coplanar,
+ * the vertices of their polygon are kept instead, and if they are
+ * collinear (or all the same), the two ends of their line.  Must only be
+ * called once the solver's hull is complete.
+ *
+ * \param kept The buffer to add the points to
+ */
+void StreamingHullSolver::keepVertices(HullPointBuffer &kept) const {
+	const HullPointBuffer &points = this->solver->getPoints();
+	HullPointIndexList vertices;
+
+	if (points.size() == 0) {
+		return;
+	}
+
+	if (this->solver->getDimension() == 3) {
+		const ConvexHullSolver::Mesh &mesh = this->solver->getMesh();
+		vector<char> isVertex(points.size(), 0);
+
+		for (HullFaceIndex f = 0; f < mesh.getCapacity(); f++) {
+			if (mesh.isLive(f)) {
+				for (int i = 0; i < 3; i++) {
+					HullPointIndex p = mesh.getFace(f).getPoint(i);
+
+					if (!isVertex[p]) {
+						isVertex[p] = 1;
+						vertices.push_back(p);
+					}
+				}
+			}
+		}
+	} else if (this->solver->getDimension() == 2) {
+		PlanarHullSolver planar(points);
+		planar.iterateToCompletion();
+
+		if (planar.getDimension() == 2) {
+			vertices = planar.getPolygon();
+		}
+	}
+
+	if (vertices.empty()) {
+		HullPointIndex lowest = 0;
+		HullPointIndex highest = 0;
+
+		for (HullPointIndex p = 1; p < points.size(); p++) {
+			if (isLower(points, p, lowest)) {
+				lowest = p;
+			}
+
+			if (isLower(points, highest, p)) {
+				highest = p;
+			}
+		}
+
+		vertices.push_back(lowest);
+
+		if (highest != lowest) {
+			vertices.push_back(highest);
+		}
+	}
+
+	kept.reserve(kept.size() + vertices.size());
+
+	for (HullPointIndexList::const_iterator i = vertices.begin(); i != vertices.end(); i++) {
+		kept.add(points.getX(*i), points.getY(*i), points.getZ(*i));
+	}
+}
@@ -0,0 +1,577 @@
+/**
+ * \file TextPointFile.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the behavior of the TextPointFile class
+ */
+
+#include "TextPointFile.h"
+#include "PlyHeader.h"
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+using namespace peek;
+
+namespace {
+
+	/** The powers of ten that a double holds exactly */
+	const double EXACT_POWERS_OF_TEN[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	/** The largest exponent in EXACT_POWERS_OF_TEN */
+	const int MAX_EXACT_EXPONENT = 22;
+
+	/** The most significant digits that are gathered into the mantissa */
+	const int MAX_MANTISSA_DIGITS = 19;
+
+	/** Gets whether or not a character is a digit */
+	inline bool isDigit(char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	/** Gets whether or not a character separates numbers */
+	inline bool isSeparator(char c) {
+		return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+	}
+
+	/** Gets the end of the line that starts at the given position */
+	inline const char *findLineEnd(const char *line, const char *end) {
+		const char *newline = (const char *) memchr(line, '\n', end - line);
+		return (newline != NULL) ? newline : end;
+	}
+
+	/** Gets the start of the line after the one that ends at the given position */
+	inline const char *nextLine(const char *lineEnd, const char *end) {
+		return (lineEnd < end) ? lineEnd + 1 : end;
+	}
+
+	/**
+	 * Skips over a number of lines
+	 *
+	 * \param line The start of the first line
+	 * \param end The end of the file
+	 * \param count The number of lines
+	 * \return The start of the line after them, or NULL if the file ends first
+	 */
+	const char *skipLines(const char *line, const char *end, size_t count) {
+		for (size_t i = 0; i < count; i++) {
+			if (line == end) {
+				return NULL;
+			}
+
+			line = nextLine(findLineEnd(line, end), end);
+		}
+
+		return line;
+	}
+
+	/**
+	 * Parses a decimal number
+	 *
+	 * Up to 19 significant digits are gathered into an integer.  If that
+	 * holds every digit and is no more than 2^53, and the exponent is
+	 * within 22 of zero, then both the integer and the power of ten are
+	 * exact doubles, and one multiplication or division rounds the result
+	 * correctly.  Anything else is handed to strtod.
+	 *
+	 * \param p The start of the number, which is moved past it
+	 * \param end The end of the line
+	 * \param value Receives the number
+	 * \return Whether or not there was a number
+	 */
+	bool parseNumber(const char *&p, const char *end, double &value) {
+		const char *start = p;
+		boost::uint64_t mantissa = 0;
+		int numDigits = 0;
+		int exponent = 0;
+		bool exact = true;
+		bool anyDigits = false;
+		bool negative = false;
+
+		if (p < end && (*p == '+' || *p == '-')) {
+			negative = (*p == '-');
+			p++;
+		}
+
+		for (; p < end && isDigit(*p); p++) {
+			anyDigits = true;
+
+			if (numDigits < MAX_MANTISSA_DIGITS) {
+				mantissa = 10 * mantissa + (*p - '0');
+				numDigits += (mantissa != 0) ? 1 : 0;
+			} else {
+				exponent++;
+				exact = exact && (*p == '0');
+			}
+		}
+
+		if (p < end && *p == '.') {
+			for (p++; p < end && isDigit(*p); p++) {
+				anyDigits = true;
+
+				if (numDigits < MAX_MANTISSA_DIGITS) {
+					mantissa = 10 * mantissa + (*p - '0');
+					numDigits += (mantissa != 0) ? 1 : 0;
+					exponent--;
+				} else {
+					exact = exact && (*p == '0');
+				}
+			}
+		}
+
+		if (!anyDigits) {
+			p = start;
+			return false;
+		}
+
+		if (p + 1 < end && (*p == 'e' || *p == 'E')) {
+			const char *q = p + 1;
+			bool negativeExponent = false;
+			int written = 0;
+
+			if (*q == '+' || *q == '-') {
+				negativeExponent = (*q == '-');
+				q++;
+			}
+
+			if (q < end && isDigit(*q)) {
+				for (; q < end && isDigit(*q); q++) {
+					written = (written < 100000) ? 10 * written + (*q - '0') : written;
+				}
+
+				exponent += negativeExponent ? -written : written;
+				p = q;
+			}
+		}
+
+		if (mantissa == 0) {
+			value = 0;
+		} else if (exact && mantissa <= ((boost::uint64_t) 1 << 53)
+			&& exponent >= -MAX_EXACT_EXPONENT && exponent <= MAX_EXACT_EXPONENT) {
+
+			value = (double) mantissa;
+			value = (exponent < 0) ? value / EXACT_POWERS_OF_TEN[-exponent] : value * EXACT_POWERS_OF_TEN[exponent];
+		} else {
+			string token(start, p);
+			value = strtod(token.c_str(), NULL);
+			return true;
+		}
+
+		value = negative ? -value : value;
+		return true;
+	}
+
+}
+
+const size_t TextPointFile::CHUNKS_PER_THREAD;
+const size_t TextPointFile::MIN_CHUNK_SIZE;
+
+/**
+ * The file is mapped and its header read, but no points are parsed until
+ * load() or read() is called.
+ *
+ * \param path The file to map
+ * \param format The file's layout
+ * \param numThreads The number of threads to load with (see setNumThreads)
+ */
+TextPointFile::TextPointFile(const char *path, Format format, unsigned int numThreads)
+	: file(path) {
+
+	size_t pathLength = strlen(path);
+
+	this->format = format;
+	this->begin = this->file.getData();
+	this->end = this->begin + this->file.getSize();
+	this->cursor = this->begin;
+	this->releasedBytes = 0;
+	this->numThreads = 0;
+
+	for (int i = 0; i < 3; i++) {
+		this->columns[i] = i;
+	}
+
+	setNumThreads(numThreads);
+
+	if (!this->file.isOpen()) {
+		this->error = this->file.getError();
+		return;
+	}
+
+	if (this->format == AUTO) {
+		if (PlyHeader::matches(this->file.getData(), this->file.getSize())) {
+			this->format = PLY;
+		} else if (pathLength >= 4 && path[pathLength - 4] == '.'
+			&& tolower(path[pathLength - 3]) == 'o' && tolower(path[pathLength - 2]) == 'b'
+			&& tolower(path[pathLength - 1]) == 'j') {
+
+			this->format = OBJ;
+		} else {
+			this->format = XYZ;
+		}
+	}
+
+	if (this->format == PLY) {
+		parsePlyHeader();
+		this->cursor = this->begin;
+	}
+}
+
+/**
+ * Each instance of an element is a line of its own in an ASCII PLY file,
+ * so the elements before the vertices are skipped a line at a time,
+ * whatever their properties.
+ *
+ * \return Whether or not the header describes points that can be read
+ */
+bool TextPointFile::parsePlyHeader() {
+	PlyHeader header(this->file.getData(), this->file.getSize());
+	const vector<PlyHeader::Element> &elements = header.getElements();
+	const char *line = this->file.getData() + header.getSize();
+	const char *fileEnd = this->end;
+
+	if (!header.isValid()) {
+		this->error = header.getError();
+		return false;
+	}
+
+	if (header.getFormat() != "ascii") {
+		this->error = "only ASCII PLY files can be parsed as text";
+		return false;
+	}
+
+	for (size_t i = 0; i < elements.size(); i++) {
+		const PlyHeader::Element &element = elements[i];
+		const char *elementEnd = skipLines(line, fileEnd, element.count);
+
+		if (elementEnd == NULL) {
+			this->error = "the PLY file is shorter than its header says";
+			return false;
+		}
+
+		if (element.name != "vertex") {
+			line = elementEnd;
+			continue;
+		}
+
+		for (size_t j = 0; j < element.properties.size(); j++) {
+			if (element.properties[j].list) {
+				this->error = "the vertices have a list property";
+				return false;
+			}
+		}
+
+		this->columns[0] = element.findProperty("x");
+		this->columns[1] = element.findProperty("y");
+		this->columns[2] = element.findProperty("z");
+
+		if (this->columns[0] < 0 || this->columns[1] < 0 || this->columns[2] < 0) {
+			this->error = "the vertices have no x, y or z";
+			return false;
+		}
+
+		this->begin = line;
+		this->end = elementEnd;
+		return true;
+	}
+
+	this->error = "the PLY file has no vertex element";
+	return false;
+}
+
+/**
+ * The lines that hold the points are split into chunks for the threads,
+ * each of which ends at a line break.  The first pass counts the points
+ * in each chunk, and the second parses each chunk's points into the
+ * arrays from where the chunks before it leave off.
+ *
+ * \return Whether or not every point was parsed.  If not, the reason is
+ *   given by getError(), and no points are kept.
+ */
+bool TextPointFile::load() {
+	size_t numBytes = this->end - this->begin;
+	size_t numChunks = std::min((size_t) this->numThreads * CHUNKS_PER_THREAD, numBytes / MIN_CHUNK_SIZE + 1);
+
+	this->x.clear();
+	this->y.clear();
+	this->z.clear();
+
+	if (!isOpen()) {
+		return false;
+	}
+
+	this->chunkBounds.resize(numChunks + 1);
+	this->chunkBounds[0] = this->begin;
+	this->chunkBounds[numChunks] = this->end;
+
+	for (size_t i = 1; i < numChunks; i++) {
+		const char *split = std::max(this->begin + numBytes / numChunks * i, this->chunkBounds[i - 1]);
+		this->chunkBounds[i] = (split < this->end) ? nextLine(findLineEnd(split, this->end), this->end) : this->end;
+	}
+
+	this->chunkOffsets.assign(numChunks + 1, 0);
+	this->chunkErrors.assign(numChunks, (const char *) NULL);
+
+	run(numChunks, &TextPointFile::countChunk);
+
+	for (size_t i = 0; i < numChunks; i++) {
+		this->chunkOffsets[i + 1] += this->chunkOffsets[i];
+	}
+
+	if (this->chunkOffsets[numChunks] > MAX_HULL_POINTS) {
+		this->error = "the file has more points than can be indexed";
+		return false;
+	}
+
+	this->x.resize(this->chunkOffsets[numChunks]);
+	this->y.resize(this->chunkOffsets[numChunks]);
+	this->z.resize(this->chunkOffsets[numChunks]);
+
+	run(numChunks, &TextPointFile::parseChunk);
+
+	for (size_t i = 0; i < numChunks; i++) {
+		if (this->chunkErrors[i] != NULL) {
+			setLineError(this->chunkErrors[i]);
+			this->x.clear();
+			this->y.clear();
+			this->z.clear();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * The buffer refers to the object's own arrays, so it must not outlive the
+ * object, or the next call to load().
+ *
+ * \param points Receives the points
+ */
+void TextPointFile::getPoints(HullPointBuffer &points) const {
+	if (this->x.empty()) {
+		points = HullPointBuffer();
+	} else {
+		points = HullPointBuffer(&this->x[0], &this->y[0], &this->z[0], this->x.size());
+	}
+}
+
+/**
+ * \param points Receives the points
+ */
+void TextPointFile::getPoints(FloatHullPointBuffer &points) const {
+	points = FloatHullPointBuffer();
+	points.reserve(this->x.size());
+
+	for (size_t i = 0; i < this->x.size(); i++) {
+		points.add((float) this->x[i], (float) this->y[i], (float) this->z[i]);
+	}
+}
+
+/**
+ * Reading doesn't need load() to have been called, and doesn't use the
+ * threads.  The pages behind the lines read so far are let go of, so that
+ * reading the whole of a large file doesn't keep it all resident.  A line
+ * that can't be parsed ends the reading, and getError() then says which.
+ *
+ * \param x Receives the x-coordinates of the points read
+ * \param y Receives the y-coordinates of the points read
+ * \param z Receives the z-coordinates of the points read
+ * \param maxPoints The most points to read
+ * \return The number of points read, which is less than maxPoints only once
+ *   every point has been read
+ */
+size_t TextPointFile::read(double *x, double *y, double *z, size_t maxPoints) {
+	size_t numRead = 0;
+
+	if (!isOpen()) {
+		return 0;
+	}
+
+	while (numRead < maxPoints && this->cursor < this->end) {
+		const char *lineEnd = findLineEnd(this->cursor, this->end);
+
+		if (isPointLine(this->cursor, lineEnd)) {
+			if (!parsePoint(this->cursor, lineEnd, x[numRead], y[numRead], z[numRead])) {
+				setLineError(this->cursor);
+				this->cursor = this->end;
+				break;
+			}
+
+			numRead++;
+		}
+
+		this->cursor = nextLine(lineEnd, this->end);
+	}
+
+	size_t consumed = this->cursor - this->file.getData();
+	this->file.release(this->releasedBytes, consumed);
+	this->releasedBytes = consumed;
+
+	return numRead;
+}
+
+void TextPointFile::rewind() {
+	this->cursor = this->begin;
+	this->releasedBytes = 0;
+}
+
+/**
+ * \param numThreads The number of threads, or 0 to use one per processor
+ */
+void TextPointFile::setNumThreads(unsigned int numThreads) {
+	if (numThreads == 0) {
+		numThreads = boost::thread::hardware_concurrency();
+		numThreads = (numThreads > 0) ? numThreads : 1;
+	}
+
+	if (numThreads != this->numThreads) {
+		this->numThreads = numThreads;
+		this->pool.reset((numThreads > 1) ? new HullThreadPool(numThreads) : 0);
+	}
+}
+
+/**
+ * \param line The start of the line
+ */
+void TextPointFile::setLineError(const char *line) {
+	ostringstream message;
+	message << "line " << (std::count(this->file.getData(), line, '\n') + 1) << " doesn't hold a point";
+	this->error = message.str();
+}
+
+/**
+ * In an XYZ file, a line holds a point if it starts with a number, so that
+ * headings and comments are passed over.  In an OBJ file, only "v" lines
+ * do.  In a PLY file, every vertex line does.
+ *
+ * \param line The start of the line
+ * \param lineEnd The end of the line
+ * \return Whether or not the line holds a point
+ */
+bool TextPointFile::isPointLine(const char *line, const char *lineEnd) const {
+	while (line < lineEnd && (*line == ' ' || *line == '\t')) {
+		line++;
+	}
+
+	if (this->format == PLY) {
+		return true;
+	} else if (this->format == OBJ) {
+		return lineEnd - line >= 2 && line[0] == 'v' && (line[1] == ' ' || line[1] == '\t');
+	}
+
+	if (line < lineEnd && (*line == '+' || *line == '-')) {
+		line++;
+	}
+
+	if (line < lineEnd && *line == '.') {
+		line++;
+	}
+
+	return line < lineEnd && isDigit(*line);
+}
+
+/**
+ * \param line The start of the line
+ * \param lineEnd The end of the line
+ * \param px Receives the x-coordinate
+ * \param py Receives the y-coordinate
+ * \param pz Receives the z-coordinate
+ * \return Whether or not the line had a number in each of the point's
+ *   columns
+ */
+bool TextPointFile::parsePoint(const char *line, const char *lineEnd, double &px, double &py, double &pz) const {
+	int lastColumn = std::max(std::max(this->columns[0], this->columns[1]), this->columns[2]);
+	double *coordinates[3] = { &px, &py, &pz };
+	const char *p = line;
+
+	if (this->format == OBJ) {
+		while (*p != 'v') {
+			p++;
+		}
+
+		p++;
+	}
+
+	for (int column = 0; column <= lastColumn; column++) {
+		while (p < lineEnd && isSeparator(*p)) {
+			p++;
+		}
+
+		if (p == lineEnd) {
+			return false;
+		}
+
+		int axis = (column == this->columns[0]) ? 0 : (column == this->columns[1]) ? 1
+			: (column == this->columns[2]) ? 2 : -1;
+
+		if (axis < 0) {
+			while (p < lineEnd && !isSeparator(*p)) {
+				p++;
+			}
+		} else if (!parseNumber(p, lineEnd, *coordinates[axis]) || (p < lineEnd && !isSeparator(*p))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \param chunk The chunk to count the points of
+ */
+void TextPointFile::countChunk(size_t chunk, unsigned int /*thread*/) {
+	const char *chunkEnd = this->chunkBounds[chunk + 1];
+	size_t count = 0;
+
+	for (const char *line = this->chunkBounds[chunk]; line < chunkEnd; ) {
+		const char *lineEnd = findLineEnd(line, chunkEnd);
+		count += isPointLine(line, lineEnd) ? 1 : 0;
+		line = nextLine(lineEnd, chunkEnd);
+	}
+
+	this->chunkOffsets[chunk + 1] = count;
+}
+
+/**
+ * \param chunk The chunk to parse the points of
+ */
+void TextPointFile::parseChunk(size_t chunk, unsigned int /*thread*/) {
+	const char *chunkEnd = this->chunkBounds[chunk + 1];
+	size_t i = this->chunkOffsets[chunk];
+
+	for (const char *line = this->chunkBounds[chunk]; line < chunkEnd; ) {
+		const char *lineEnd = findLineEnd(line, chunkEnd);
+
+		if (isPointLine(line, lineEnd)) {
+			if (!parsePoint(line, lineEnd, this->x[i], this->y[i], this->z[i])) {
+				this->chunkErrors[chunk] = line;
+				return;
+			}
+
+			i++;
+		}
+
+		line = nextLine(lineEnd, chunkEnd);
+	}
+}
+
+/**
+ * \param numTasks The number of tasks
+ * \param task The method to call with each task's number and the thread
+ *   running it
+ */
+void TextPointFile::run(size_t numTasks, void (TextPointFile::*task)(size_t, unsigned int)) {
+	if (this->pool.get() != 0) {
+		this->pool->run(numTasks, boost::bind(task, this, _1, _2));
+	} else {
+		for (size_t i = 0; i < numTasks; i++) {
+			(this->*task)(i, 0);
+		}
+	}
+}
@@ -40,6 +40,8 @@ void UiHandler::bindKeys() {
 	engine->bindKey(SDLK_r, CHSE_RESET);
 	engine->bindKey(SDLK_i, CHSE_ITERATE);
 	engine->bindKey(SDLK_c, CHSE_ITERATE_TO_COMPLETION);
+	engine->bindKey(SDLK_a, CHSE_NEXT_ALGORITHM);
+	engine->bindKey(SDLK_w, CHSE_EXPORT_HULL);
 }
 
 /**
@@ -77,6 +79,14 @@ void UiHandler::handleCustomEvent(int customEvent) {
 			this->app->iterateToCompletion();
 			this->app->getEngine()->invalidate();
 			break;
+		case CHSE_NEXT_ALGORITHM:   // Switch to the next solver algorithm
+			this->app->nextAlgorithm();
+			this->app->getEngine()->invalidate();
+			break;
+		case CHSE_EXPORT_HULL:   // Write the current hull to hull.ply
+			this->app->exportHull("hull.ply");
+			break;
+
 		default: break;
 	}
 }
@@ -5,11 +5,19 @@
  * Defines the entry point for the program
  */
 #include "Application.h"
+#include <cstdio>
 
 /** Entry point for the program */
 int main(int argc, char **argv) {
 	Application app;
 
+	// A point cloud file named on the command line takes the place of the
+	// random points.
+	if (argc > 1 && !app.load(argv[1])) {
+		fprintf(stderr, "%s: %s\n", argv[1], app.getLoadError().c_str());
+		return 1;
+	}
+
 	app.run();
 
 	return 0;
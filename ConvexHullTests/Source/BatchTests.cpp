@@ -0,0 +1,137 @@
+/**
+ * \file BatchTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of HullBatchSolver
+ */
+
+#include "HullTests.h"
+#include "HullBatchSolver.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cstdio>
+#include <memory>
+
+namespace {
+
+	/** The number of ranges in the batch, which spans several blocks */
+	const size_t NUM_RANGES = 300;
+
+	/**
+	 * Makes a batch of small ranges of every kind: solid, planar, on a line,
+	 * all at one point, a single point, and empty.  The coordinates are
+	 * whole numbers, so that they are exact in float, and so that the
+	 * planar and collinear ranges are exactly so.
+	 *
+	 * \param points Receives the points of every range
+	 * \param rangeOffsets Receives where each range starts, and where the
+	 *   last one ends
+	 */
+	void makeBatch(HullPointBuffer &points, vector<size_t> &rangeOffsets) {
+		boost::mt19937 engine(HullSolver::DEFAULT_SEED);
+		boost::variate_generator<boost::mt19937 &, boost::uniform_int<> > whole(engine, boost::uniform_int<>(-1000, 1000));
+
+		rangeOffsets.push_back(0);
+
+		for (size_t r = 0; r < NUM_RANGES; r++) {
+			int kind = (int) (r % 6);
+			int size = (kind == 4) ? 1 : (kind == 5) ? 0 : 4 + (int) (r / 6) % 40;
+
+			for (int i = 0; i < size; i++) {
+				int a = whole();
+				int b = whole();
+				int c = whole();
+
+				switch (kind) {
+					case 1: points.add(a, b, -2 * a - 3 * b); break;
+					case 2: points.add(a, -a, 2 * a); break;
+					case 3: points.add(7, -3, 5); break;
+					default: points.add(a, b, c); break;
+				}
+			}
+
+			rangeOffsets.push_back(points.size());
+		}
+	}
+
+	/**
+	 * Solves the batch in one precision, and checks each range's faces
+	 * against the hull that HullSolver::create() finds for it alone
+	 *
+	 * \param log Where to report
+	 * \param points The points of every range, in the precision to solve in
+	 * \param exact The same points in double
+	 * \param rangeOffsets Where each range starts, and where the last one ends
+	 * \param precision The name of the precision
+	 */
+	template <typename T>
+	void testBatch(TestLog &log, const BasicHullPointBuffer<T> &points, const HullPointBuffer &exact,
+		const vector<size_t> &rangeOffsets, const char *precision) {
+
+		for (int t = 0; t < 2; t++) {
+			BasicHullBatchSolver<T> batch(HullTests::THREAD_COUNTS[t]);
+			char name[256];
+			string problem;
+
+			// The batch is solved twice, so that the second solve reuses the
+			// first one's solvers and output.
+			batch.solve(points, rangeOffsets);
+			batch.solve(points, rangeOffsets);
+
+			if (batch.getNumHulls() != NUM_RANGES) {
+				problem = "the wrong number of hulls";
+			}
+
+			for (size_t r = 0; problem.empty() && r < batch.getNumHulls(); r++) {
+				size_t begin = rangeOffsets[r];
+				TestInput range;
+				HullFaceList faces;
+
+				for (size_t i = begin; i < rangeOffsets[r + 1]; i++) {
+					HullPointIndex p = (HullPointIndex) i;
+					range.points.add(exact.getX(p), exact.getY(p), exact.getZ(p));
+				}
+
+				auto_ptr<HullSolver> solver(HullSolver::create(HullSolver::INCREMENTAL, range.points));
+				solver->iterateToCompletion();
+				range.dimension = solver->getDimension();
+
+				for (size_t f = batch.getFaceOffsets()[r]; f < batch.getFaceOffsets()[r + 1]; f++) {
+					faces.push_back(HullFace((HullPointIndex) (batch.getTriangles()[3 * f] - begin),
+						(HullPointIndex) (batch.getTriangles()[3 * f + 1] - begin),
+						(HullPointIndex) (batch.getTriangles()[3 * f + 2] - begin)));
+				}
+
+				if (!HullTests::checkFaces(faces, batch.getDimension(r), range.points, range, problem)) {
+					sprintf(name, "range %lu: ", (unsigned long) r);
+					problem = name + problem;
+				}
+			}
+
+			sprintf(name, "batch, %s, %u thread%s", precision, HullTests::THREAD_COUNTS[t],
+				(HullTests::THREAD_COUNTS[t] == 1) ? "" : "s");
+			log.report(problem.empty(), name, problem);
+		}
+	}
+
+}
+
+/**
+ * \param log Where to report
+ */
+void HullTests::testBatch(TestLog &log) {
+	HullPointBuffer points;
+	FloatHullPointBuffer floatPoints;
+	vector<size_t> rangeOffsets;
+
+	makeBatch(points, rangeOffsets);
+
+	for (size_t i = 0; i < points.size(); i++) {
+		HullPointIndex p = (HullPointIndex) i;
+		floatPoints.add((float) points.getX(p), (float) points.getY(p), (float) points.getZ(p));
+	}
+
+	::testBatch(log, points, points, rangeOffsets, "double");
+	::testBatch(log, floatPoints, points, rangeOffsets, "float");
+}
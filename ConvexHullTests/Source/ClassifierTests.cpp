@@ -0,0 +1,124 @@
+/**
+ * \file ClassifierTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of PointClassifier
+ */
+
+#include "HullTests.h"
+#include "PointClassifier.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+
+namespace {
+
+	/** The number of points classified, which isn't a multiple of any kernel's width */
+	const size_t NUM_POINTS = 1001;
+
+	/** The number of Ts from one point to the next in the interleaved arrays */
+	const size_t STRIDE = 4;
+
+	/**
+	 * Checks the distances and mask from one instruction set against those
+	 * from scalar code
+	 *
+	 * The kernels may round differently, so the distances need only be
+	 * close, and each point need only be flagged according to its own
+	 * distance.
+	 *
+	 * \param expected The distances from scalar code
+	 * \param distances The distances to check
+	 * \param mask The mask to check
+	 * \param numFlagged The number of flagged points returned
+	 * \param threshold The threshold the points were classified with
+	 * \param tolerance How far apart the distances may be
+	 * \return Whether or not they agree
+	 */
+	template <typename T>
+	bool agrees(const vector<T> &expected, const vector<T> &distances, const vector<unsigned char> &mask,
+		size_t numFlagged, T threshold, T tolerance) {
+
+		size_t count = 0;
+
+		for (size_t i = 0; i < expected.size(); i++) {
+			if (std::fabs(expected[i] - distances[i]) > tolerance || mask[i] != ((distances[i] > -threshold) ? 1 : 0)) {
+				return false;
+			}
+
+			count += mask[i];
+		}
+
+		return count == numFlagged;
+	}
+
+	/**
+	 * Classifies the same points with every supported instruction set, both
+	 * consecutively and through shuffled indices into interleaved arrays
+	 *
+	 * \param log Where to report
+	 * \param type The name of T
+	 * \param tolerance How far apart the distances may be
+	 */
+	template <typename T>
+	void testType(TestLog &log, const char *type, T tolerance) {
+		boost::mt19937 engine(HullSolver::DEFAULT_SEED);
+		boost::variate_generator<boost::mt19937 &, boost::uniform_real<> > uniform(engine, boost::uniform_real<>(-1, 1));
+		boost::variate_generator<boost::mt19937 &, boost::uniform_int<> > index(engine,
+			boost::uniform_int<>(0, (int) NUM_POINTS - 1));
+
+		const T plane[4] = { (T) 0.48, (T) -0.6, (T) 0.64, (T) 0.1 };
+		const T threshold = (T) 0.05;
+		vector<T> x(NUM_POINTS), y(NUM_POINTS), z(NUM_POINTS), records(STRIDE * NUM_POINTS);
+		vector<HullPointIndex> indices(NUM_POINTS);
+		vector<T> expected(NUM_POINTS), expectedIndexed(NUM_POINTS), distances(NUM_POINTS);
+		vector<unsigned char> mask(NUM_POINTS);
+		PointClassifier::InstructionSet original = PointClassifier::getInstructionSet();
+
+		for (size_t i = 0; i < NUM_POINTS; i++) {
+			x[i] = records[STRIDE * i] = (T) uniform();
+			y[i] = records[STRIDE * i + 1] = (T) uniform();
+			z[i] = records[STRIDE * i + 2] = (T) uniform();
+			indices[i] = (HullPointIndex) index();
+		}
+
+		PointClassifier::setInstructionSet(PointClassifier::SCALAR);
+		PointClassifier::classify(plane, threshold, &x[0], &y[0], &z[0], NUM_POINTS, &expected[0], &mask[0]);
+		PointClassifier::classifyIndexed(plane, threshold, &records[0], &records[1], &records[2], STRIDE,
+			&indices[0], NUM_POINTS, &expectedIndexed[0], &mask[0]);
+
+		for (int s = PointClassifier::SSE2; s <= PointClassifier::getSupportedInstructionSet(); s++) {
+			PointClassifier::InstructionSet instructionSet = (PointClassifier::InstructionSet) s;
+			string name = string("classifier, ") + type + ", " + PointClassifier::getName(instructionSet);
+			size_t numFlagged;
+
+			PointClassifier::setInstructionSet(instructionSet);
+
+			numFlagged = PointClassifier::classify(plane, threshold, &x[0], &y[0], &z[0], NUM_POINTS,
+				&distances[0], &mask[0]);
+			log.report(agrees(expected, distances, mask, numFlagged, threshold, tolerance), name,
+				"the points were misclassified");
+
+			numFlagged = PointClassifier::classifyIndexed(plane, threshold, &records[0], &records[1], &records[2],
+				STRIDE, &indices[0], NUM_POINTS, &distances[0], &mask[0]);
+			log.report(agrees(expectedIndexed, distances, mask, numFlagged, threshold, tolerance), name + ", indexed",
+				"the points were misclassified");
+		}
+
+		PointClassifier::setInstructionSet(original);
+	}
+
+}
+
+/**
+ * Every instruction set that the processor supports must classify points
+ * the same as scalar code does.
+ *
+ * \param log Where to report
+ */
+void HullTests::testClassifier(TestLog &log) {
+	testType<double>(log, "double", 1e-12);
+	testType<float>(log, "float", 1e-5f);
+}
@@ -0,0 +1,163 @@
+/**
+ * \file DynamicTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of changing the points of a finished hull
+ */
+
+#include "HullTests.h"
+#include "ConvexHullSolver.h"
+#include <algorithm>
+
+namespace {
+
+	/** The number of batches the new points are inserted in */
+	const size_t NUM_BATCHES = 4;
+
+	/**
+	 * Finds the hull of some points, inserts others into it a batch at a
+	 * time, and checks the hull against all of them
+	 *
+	 * \param log Where to report
+	 * \param name What the points are
+	 * \param first The points to start with
+	 * \param rest The points to insert
+	 * \param dimension The number of dimensions all of the points span
+	 */
+	void testInsertion(TestLog &log, const string &name, const HullPointBuffer &first, const HullPointBuffer &rest,
+		unsigned int dimension) {
+
+		TestInput all;
+		size_t batchSize = (rest.size() + NUM_BATCHES - 1) / NUM_BATCHES;
+
+		all.name = name;
+		all.dimension = dimension;
+		all.points = first;
+		all.points.append(rest);
+
+		for (int t = 0; t < 2; t++) {
+			for (int randomized = 0; randomized < 2; randomized++) {
+				ConvexHullSolver solver(first, HullFaceScheduler::FURTHEST_FIRST, 0, HullTests::THREAD_COUNTS[t]);
+				string problem;
+
+				if (randomized) {
+					solver.setRandomOrder();
+				}
+
+				solver.iterateToCompletion();
+
+				for (size_t begin = 0; begin < rest.size(); begin += batchSize) {
+					size_t count = std::min(batchSize, rest.size() - begin);
+					solver.insert(HullPointBuffer(rest.getXArray() + begin, rest.getYArray() + begin,
+						rest.getZArray() + begin, count));
+					solver.iterateToCompletion();
+				}
+
+				if (solver.getPoints().size() != all.points.size()) {
+					problem = "the points weren't all added";
+				}
+
+				log.report(problem.empty() && HullTests::checkHull(solver, solver.getPoints(), all, problem),
+					HullTests::getTestName(all, randomized ? "randomized, inserted" : "incremental, inserted",
+					HullTests::THREAD_COUNTS[t]), problem);
+			}
+		}
+	}
+
+}
+
+/**
+ * The new points are inserted in batches into the hull of the points
+ * before them: the rest of the cube, some of which lie outside the hull
+ * of the first points; a larger cube around the first, so that the whole
+ * hull is replaced; and a cube around collinear and coincident points,
+ * whose hull has no faces to grow from.
+ *
+ * \param log Where to report
+ */
+void HullTests::testInsert(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+	const HullPointBuffer &cube = inputs[0].points;
+	HullPointBuffer firstHalf, secondHalf, larger;
+
+	for (size_t i = 0; i < cube.size(); i++) {
+		HullPointIndex p = (HullPointIndex) i;
+		((i < cube.size() / 2) ? firstHalf : secondHalf).add(cube.getX(p), cube.getY(p), cube.getZ(p));
+		larger.add(2 * cube.getX(p), 2 * cube.getY(p), 2 * cube.getZ(p));
+	}
+
+	testInsertion(log, "cube halves", firstHalf, secondHalf, 3);
+	testInsertion(log, "cube and a larger cube", cube, larger, 3);
+	testInsertion(log, "collinear and cube", inputs[2].points, cube, 3);
+	testInsertion(log, "coincident and cube", inputs[4].points, cube, 3);
+	testInsertion(log, "coincident and more", inputs[4].points, inputs[4].points, 0);
+}
+
+/**
+ * Points are removed from the finished hull of the cube: its corners and
+ * edge midpoints, so that the holes are filled from the points beneath
+ * them; every third point, vertices and inside points alike; and the
+ * corners again, followed by inserting them back.  From the duplicates,
+ * the first copy of each point is removed, which must leave the hull the
+ * same shape.
+ *
+ * \param log Where to report
+ */
+void HullTests::testRemove(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+	const char *cases[4] = { "corners removed", "every third removed", "corners removed and put back",
+		"first copies removed" };
+
+	for (int c = 0; c < 4; c++) {
+		const TestInput &input = inputs[(c == 3) ? 3 : 0];
+		size_t numRandom = input.points.size() - 16;
+
+		for (int t = 0; t < 2; t++) {
+			ConvexHullSolver solver(input.points, HullFaceScheduler::FURTHEST_FIRST, 0, THREAD_COUNTS[t]);
+			TestInput remaining;
+			string problem;
+
+			solver.iterateToCompletion();
+
+			for (size_t i = 0; i < input.points.size(); i++) {
+				bool corner = (i >= numRandom);
+
+				if ((c == 0 || c == 2) ? corner : (c == 1) ? (i % 3 == 0) : (i < 50)) {
+					solver.remove((HullPointIndex) i);
+				}
+			}
+
+			solver.iterateToCompletion();
+
+			if (c == 2) {
+				solver.insert(HullPointBuffer(input.points.getXArray() + numRandom, input.points.getYArray() + numRandom,
+					input.points.getZArray() + numRandom, 16));
+				solver.iterateToCompletion();
+			}
+
+			for (size_t i = 0; i < solver.getPoints().size(); i++) {
+				HullPointIndex p = (HullPointIndex) i;
+
+				if (!solver.isRemoved(p)) {
+					remaining.points.add(solver.getPoints().getX(p), solver.getPoints().getY(p),
+						solver.getPoints().getZ(p));
+				}
+			}
+
+			HullFaceList faces = solver.getHull();
+
+			for (size_t f = 0; f < faces.size(); f++) {
+				for (int k = 0; k < 3; k++) {
+					if (solver.isRemoved(faces[f].getPoint(k))) {
+						problem = "a face has a removed corner";
+					}
+				}
+			}
+
+			remaining.name = input.name + ", " + cases[c];
+			remaining.dimension = 3;
+			log.report(problem.empty() && checkHull(solver, solver.getPoints(), remaining, problem),
+				getTestName(remaining, "incremental", THREAD_COUNTS[t]), problem);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/**
+ * \file EngineTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of the solvers that HullSolver::create() picks from
+ */
+
+#include "HullTests.h"
+#include "PlanarHullSolver.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <memory>
+
+namespace {
+
+	/**
+	 * Solves every input with an algorithm on each number of threads, and
+	 * checks each hull
+	 *
+	 * \param log Where to report
+	 * \param algorithm The algorithm
+	 * \param name The name of the algorithm
+	 */
+	void testAlgorithm(TestLog &log, HullSolver::Algorithm algorithm, const char *name) {
+		vector<TestInput> inputs = HullTests::makeInputs();
+
+		for (size_t i = 0; i < inputs.size(); i++) {
+			for (int t = 0; t < 2; t++) {
+				auto_ptr<HullSolver> solver(HullSolver::create(algorithm, inputs[i].points, HullTests::THREAD_COUNTS[t]));
+				string problem;
+
+				solver->iterateToCompletion();
+				log.report(HullTests::checkHull(*solver, inputs[i].points, inputs[i], problem),
+					HullTests::getTestName(inputs[i], name, HullTests::THREAD_COUNTS[t]), problem);
+			}
+		}
+	}
+
+}
+
+/**
+ * \param log Where to report
+ */
+void HullTests::testIncremental(TestLog &log) {
+	testAlgorithm(log, HullSolver::INCREMENTAL, "incremental");
+}
+
+/**
+ * \param log Where to report
+ */
+void HullTests::testDivideAndConquer(TestLog &log) {
+	testAlgorithm(log, HullSolver::DIVIDE_AND_CONQUER, "divide");
+}
+
+/**
+ * \param log Where to report
+ */
+void HullTests::testChan(TestLog &log) {
+	testAlgorithm(log, HullSolver::OUTPUT_SENSITIVE, "chan");
+}
+
+/**
+ * \param log Where to report
+ */
+void HullTests::testRandomized(TestLog &log) {
+	testAlgorithm(log, HullSolver::RANDOMIZED_INCREMENTAL, "randomized");
+}
+
+/**
+ * Besides the test inputs, PlanarHullSolver is given a disk in a tilted
+ * plane and a rectangle in an upright one, whose sides hold many points.  The
+ * coordinates are whole numbers, so that the points are exactly coplanar.
+ *
+ * \param log Where to report
+ */
+void HullTests::testPlanar(TestLog &log) {
+	boost::mt19937 engine(HullSolver::DEFAULT_SEED);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_int<> > whole(engine, boost::uniform_int<>(-1000, 1000));
+	vector<TestInput> inputs = makeInputs();
+	size_t numInputs = inputs.size();
+
+	inputs.resize(numInputs + 2);
+	inputs[numInputs].name = "tilted disk";
+	inputs[numInputs].dimension = 2;
+	inputs[numInputs + 1].name = "upright rectangle";
+	inputs[numInputs + 1].dimension = 2;
+
+	while (inputs[numInputs].points.size() < 2000) {
+		int a = whole();
+		int b = whole();
+
+		if (a * a + b * b <= 1000 * 1000) {
+			inputs[numInputs].points.add(a, b, -2 * a - 3 * b);
+		}
+	}
+
+	for (int i = 0; i < 2000; i++) {
+		int a = whole();
+		int b = whole();
+		inputs[numInputs + 1].points.add(3, a, (i % 2) ? b : ((i % 4) ? 1000 : -1000));
+	}
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		if (inputs[i].dimension != 2) {
+			continue;
+		}
+
+		for (int t = 0; t < 2; t++) {
+			PlanarHullSolver solver(inputs[i].points, THREAD_COUNTS[t]);
+			string problem;
+
+			solver.iterateToCompletion();
+			log.report(checkHull(solver, inputs[i].points, inputs[i], problem),
+				getTestName(inputs[i], "planar", THREAD_COUNTS[t]), problem);
+		}
+	}
+}
@@ -0,0 +1,243 @@
+/**
+ * \file ExporterTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of writing hulls out to files
+ */
+
+#include "HullTests.h"
+#include "HullExporter.h"
+#include "MappedPointFile.h"
+#include "TextPointFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+	/** The files that the tests write, read back and then delete */
+	const char *TEST_PATHS[3] = { "hulltests-hull.ply", "hulltests-hull.stl", "hulltests-hull.obj" };
+
+	/** Reads a whole file into a string */
+	bool readFile(const char *path, string &contents) {
+		FILE *file = fopen(path, "rb");
+		char block[4096];
+		size_t count;
+
+		if (file == NULL) {
+			return false;
+		}
+
+		contents.clear();
+
+		while ((count = fread(block, 1, sizeof(block), file)) > 0) {
+			contents.append(block, count);
+		}
+
+		fclose(file);
+		return true;
+	}
+
+	/** Reads a little-endian 32-bit integer out of a file's bytes */
+	unsigned long readUint32(const string &contents, size_t offset) {
+		const unsigned char *bytes = (const unsigned char *) contents.data() + offset;
+		return bytes[0] | ((unsigned long) bytes[1] << 8) | ((unsigned long) bytes[2] << 16)
+			| ((unsigned long) bytes[3] << 24);
+	}
+
+	/** Gets whether points read back from a file are exactly the exporter's vertices */
+	template <typename T>
+	bool matchesVertices(const HullPointBuffer &points, const BasicHullPointBuffer<T> &vertices) {
+		if (points.size() != vertices.size()) {
+			return false;
+		}
+
+		for (size_t v = 0; v < vertices.size(); v++) {
+			HullPointIndex p = (HullPointIndex) v;
+
+			if ((T) points.getX(p) != vertices.getX(p) || (T) points.getY(p) != vertices.getY(p)
+				|| (T) points.getZ(p) != vertices.getZ(p)) {
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Exports a hull of points of type T, checks that the exporter's
+	 * vertices, input indices and triangles agree with the hull, and then
+	 * writes each format and reads it back
+	 *
+	 * \param faces The hull
+	 * \param points The points that were solved
+	 * \param problem Receives what went wrong, if anything did
+	 * \return Whether or not the hull was exported faithfully
+	 */
+	template <typename T>
+	bool checkExport(const HullFaceList &faces, const BasicHullPointBuffer<T> &points, string &problem) {
+		BasicHullExporter<T> exporter;
+		exporter.setHull(faces, points);
+
+		const BasicHullPointBuffer<T> &vertices = exporter.getVertices();
+		const HullPointIndexList &inputIndices = exporter.getInputIndices();
+		const HullPointIndexList &triangles = exporter.getTriangles();
+		vector<bool> used(vertices.size(), false);
+
+		if (inputIndices.size() != vertices.size() || exporter.getNumFaces() != faces.size()
+			|| triangles.size() != 3 * faces.size()) {
+
+			problem = "the exporter has the wrong number of vertices or faces";
+			return false;
+		}
+
+		for (size_t v = 0; v < vertices.size(); v++) {
+			HullPointIndex vertex = (HullPointIndex) v;
+			HullPointIndex p = inputIndices[v];
+
+			if ((v > 0 && p <= inputIndices[v - 1]) || p >= points.size()) {
+				problem = "the input indices aren't in order, or are out of range";
+				return false;
+			}
+
+			if (vertices.getX(vertex) != points.getX(p) || vertices.getY(vertex) != points.getY(p)
+				|| vertices.getZ(vertex) != points.getZ(p)) {
+
+				problem = "a vertex differs from the input point behind it";
+				return false;
+			}
+		}
+
+		for (size_t f = 0; f < faces.size(); f++) {
+			HullPointIndex corners[3] = { faces[f].getP0(), faces[f].getP1(), faces[f].getP2() };
+
+			for (int c = 0; c < 3; c++) {
+				HullPointIndex v = triangles[3 * f + c];
+
+				if (v >= vertices.size() || inputIndices[v] != corners[c]) {
+					problem = "a triangle's corner isn't the face's";
+					return false;
+				}
+
+				used[v] = true;
+			}
+		}
+
+		if (std::find(used.begin(), used.end(), false) != used.end()) {
+			problem = "a vertex isn't the corner of any face";
+			return false;
+		}
+
+		for (int f = 0; f < 3; f++) {
+			if (!exporter.write(TEST_PATHS[f])) {
+				problem = exporter.getError();
+				return false;
+			}
+		}
+
+		// The PLY file's vertices are mapped back, and its faces are read
+		// from the bytes after them.
+		MappedPointFile ply(TEST_PATHS[0]);
+		HullPointBuffer plyPoints;
+		string contents;
+		ply.getPoints(plyPoints);
+
+		if (!ply.isOpen() || ply.isFloat() != (sizeof(T) == sizeof(float)) || !matchesVertices(plyPoints, vertices)) {
+			problem = "the PLY file's vertices don't read back";
+			return false;
+		}
+
+		readFile(TEST_PATHS[0], contents);
+		size_t faceOffset = contents.find("end_header\n") + strlen("end_header\n") + 3 * sizeof(T) * vertices.size();
+
+		if (contents.size() != faceOffset + 13 * faces.size()) {
+			problem = "the PLY file is the wrong size";
+			return false;
+		}
+
+		for (size_t f = 0; f < faces.size(); f++) {
+			size_t offset = faceOffset + 13 * f;
+
+			if (contents[offset] != 3 || readUint32(contents, offset + 1) != triangles[3 * f]
+				|| readUint32(contents, offset + 5) != triangles[3 * f + 1]
+				|| readUint32(contents, offset + 9) != triangles[3 * f + 2]) {
+
+				problem = "the PLY file's faces don't read back";
+				return false;
+			}
+		}
+
+		// STL files have a header of 80 bytes and a count, and then 50 bytes
+		// to a triangle.
+		readFile(TEST_PATHS[1], contents);
+
+		if (contents.size() != 84 + 50 * faces.size() || readUint32(contents, 80) != faces.size()) {
+			problem = "the STL file is the wrong size";
+			return false;
+		}
+
+		TextPointFile obj(TEST_PATHS[2]);
+		HullPointBuffer objPoints;
+		size_t numFaceLines = 0;
+
+		if (!obj.load()) {
+			problem = obj.getError();
+			return false;
+		}
+
+		obj.getPoints(objPoints);
+		readFile(TEST_PATHS[2], contents);
+
+		for (size_t i = contents.find("\nf "); i != string::npos; i = contents.find("\nf ", i + 1)) {
+			numFaceLines++;
+		}
+
+		if (!matchesVertices(objPoints, vertices) || numFaceLines != faces.size()) {
+			problem = "the OBJ file doesn't read back";
+			return false;
+		}
+
+		return true;
+	}
+
+}
+
+/**
+ * Each input's hull is exported from double points and from the points
+ * rounded to float.  Its vertices must each be the input point that their
+ * index names, in order and used by some face, and its triangles must be
+ * the hull's faces.  The PLY and OBJ files must read back to exactly the
+ * same vertices, the PLY file's faces must be the triangles, and the STL
+ * file must have its size.
+ *
+ * \param log Where to report
+ */
+void HullTests::testExporter(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		auto_ptr<HullSolver> solver(HullSolver::create(HullSolver::INCREMENTAL, inputs[i].points));
+		FloatHullPointBuffer floatPoints;
+		string problem;
+
+		solver->iterateToCompletion();
+		HullFaceList faces = solver->getHull();
+
+		for (size_t j = 0; j < inputs[i].points.size(); j++) {
+			HullPointIndex p = (HullPointIndex) j;
+			floatPoints.add((float) inputs[i].points.getX(p), (float) inputs[i].points.getY(p),
+				(float) inputs[i].points.getZ(p));
+		}
+
+		log.report(checkExport(faces, inputs[i].points, problem), getTestName(inputs[i], "exporter, double", 1),
+			problem);
+		problem.clear();
+		log.report(checkExport(faces, floatPoints, problem), getTestName(inputs[i], "exporter, float", 1), problem);
+	}
+
+	for (int f = 0; f < 3; f++) {
+		remove(TEST_PATHS[f]);
+	}
+}
@@ -0,0 +1,176 @@
+/**
+ * \file FileTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of mapping binary point files
+ */
+
+#include "HullTests.h"
+#include "MappedPointFile.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+	/** The file that each test writes, maps and then deletes */
+	const char *TEST_PATH = "hulltests-mapped.tmp";
+
+	/** Appends the bytes of a value to a string, in the machine's order */
+	template <typename T>
+	void appendBytes(string &contents, T value) {
+		char bytes[sizeof(T)];
+		memcpy(bytes, &value, sizeof(T));
+		contents.append(bytes, sizeof(T));
+	}
+
+	/** Gets whether a file's points, as a buffer and read a few at a time, are exactly the given ones */
+	bool matches(MappedPointFile &file, const HullPointBuffer &expected, string &problem) {
+		HullPointBuffer points;
+		double x[3], y[3], z[3];
+		size_t numRead = 0;
+		size_t count;
+
+		file.getPoints(points);
+
+		if (points.size() != expected.size()) {
+			problem = "the file has the wrong number of points";
+			return false;
+		}
+
+		for (size_t i = 0; i < expected.size(); i++) {
+			HullPointIndex p = (HullPointIndex) i;
+
+			if (points.getX(p) != expected.getX(p) || points.getY(p) != expected.getY(p)
+				|| points.getZ(p) != expected.getZ(p)) {
+
+				problem = "a point in the buffer differs from the one written";
+				return false;
+			}
+		}
+
+		file.rewind();
+
+		do {
+			count = file.read(x, y, z, 3);
+
+			for (size_t i = 0; i < count; i++) {
+				HullPointIndex p = (HullPointIndex) (numRead + i);
+
+				if (x[i] != expected.getX(p) || y[i] != expected.getY(p) || z[i] != expected.getZ(p)) {
+					problem = "a point read differs from the one written";
+					return false;
+				}
+			}
+
+			numRead += count;
+		} while (count == 3);
+
+		if (numRead != expected.size()) {
+			problem = "the wrong number of points were read";
+			return false;
+		}
+
+		return true;
+	}
+
+	/** Gets the header of a binary PLY file, with the given vertex count and properties */
+	string makePlyHeader(const char *count, const char *properties) {
+		return string("ply\nformat binary_little_endian 1.0\nelement vertex ") + count + "\n" + properties
+			+ "end_header\n";
+	}
+
+}
+
+/**
+ * Raw files of either precision, and a PLY file whose vertices have other
+ * properties around their coordinates and follow an element of another
+ * kind, must read back exactly as they were written, whole and a few
+ * points at a time.  Truncated files, and headers whose counts would
+ * overflow when multiplied out, must be refused rather than mapped past
+ * their ends, as must the text files that only TextPointFile reads.
+ *
+ * \param log Where to report
+ */
+void HullTests::testMappedFile(TestLog &log) {
+	HullPointBuffer expected;
+	string raw[2], ply;
+	string problem;
+
+	for (int i = 0; i < 10; i++) {
+		expected.add(i * 0.25f, -i * 1.5f, (i % 3) + 0.125f);
+		appendBytes(raw[0], (double) expected.getX((HullPointIndex) i));
+		appendBytes(raw[0], (double) expected.getY((HullPointIndex) i));
+		appendBytes(raw[0], (double) expected.getZ((HullPointIndex) i));
+		appendBytes(raw[1], (float) expected.getX((HullPointIndex) i));
+		appendBytes(raw[1], (float) expected.getY((HullPointIndex) i));
+		appendBytes(raw[1], (float) expected.getZ((HullPointIndex) i));
+	}
+
+	for (int f = 0; f < 2; f++) {
+		const char *name = (f == 0) ? "raw double file" : "raw float file";
+		bool succeeded = writeFile(TEST_PATH, raw[f]);
+		MappedPointFile file(TEST_PATH, (f == 0) ? MappedPointFile::RAW_DOUBLE : MappedPointFile::RAW_FLOAT);
+
+		problem = succeeded ? file.getError() : "the file couldn't be written";
+		succeeded = succeeded && file.isOpen() && (file.isFloat() == (f == 1)) && matches(file, expected, problem);
+		log.report(succeeded, name, problem);
+	}
+
+	ply = "ply\nformat binary_little_endian 1.0\nelement camera 1\nproperty double focal\n"
+		"element vertex 10\nproperty uchar red\nproperty float x\nproperty float y\nproperty short flags\n"
+		"property float z\nproperty float confidence\nelement face 0\nproperty list uchar int vertex_indices\n"
+		"end_header\n";
+	appendBytes(ply, 35.0);
+
+	for (int i = 0; i < 10; i++) {
+		HullPointIndex p = (HullPointIndex) i;
+		appendBytes(ply, (unsigned char) 255);
+		appendBytes(ply, (float) expected.getX(p));
+		appendBytes(ply, (float) expected.getY(p));
+		appendBytes(ply, (short) -1);
+		appendBytes(ply, (float) expected.getZ(p));
+		appendBytes(ply, 0.5f);
+	}
+
+	{
+		bool succeeded = writeFile(TEST_PATH, ply);
+		MappedPointFile file(TEST_PATH);
+
+		problem = succeeded ? file.getError() : "the file couldn't be written";
+		succeeded = succeeded && file.isOpen() && file.isFloat() && matches(file, expected, problem);
+		log.report(succeeded, "PLY file with other properties", problem);
+	}
+
+	const char *badNames[4] = {
+		"truncated PLY file", "PLY file with an overflowing count", "truncated raw file", "ASCII PLY file"
+	};
+	string badFiles[4];
+	MappedPointFile::Format badFormats[4] = {
+		MappedPointFile::AUTO, MappedPointFile::PLY, MappedPointFile::RAW_DOUBLE, MappedPointFile::AUTO
+	};
+
+	badFiles[0] = makePlyHeader("11", "property float x\nproperty float y\nproperty float z\n")
+		+ raw[1];
+	badFiles[1] = makePlyHeader("1537228672809129302", "property float x\nproperty float y\nproperty float z\n")
+		+ raw[1];
+	badFiles[2] = raw[0].substr(0, raw[0].size() - 1);
+	badFiles[3] = "ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\n"
+		"property float z\nend_header\n0 0 0\n";
+
+	for (int f = 0; f < 4; f++) {
+		bool succeeded = writeFile(TEST_PATH, badFiles[f]);
+		MappedPointFile file(TEST_PATH, badFormats[f]);
+
+		// A raw file with a partial point at its end is read up to that
+		// point, which must be left out.
+		if (f == 2) {
+			succeeded = succeeded && file.isOpen() && file.size() == expected.size() - 1;
+		} else {
+			succeeded = succeeded && !file.isOpen() && file.size() == 0;
+		}
+
+		log.report(succeeded, badNames[f], (f == 2) ? "the partial point was read" : "the file was mapped");
+	}
+
+	remove(TEST_PATH);
+}
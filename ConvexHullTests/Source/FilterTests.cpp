@@ -0,0 +1,89 @@
+/**
+ * \file FilterTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of InteriorPointFilter
+ */
+
+#include "HullTests.h"
+#include "ConvexHullSolver.h"
+#include "InteriorPointFilter.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+	/** The numbers of directions the filter is tested with */
+	const unsigned int FILTER_DIRECTIONS[3] = { 6, 14, 26 };
+
+}
+
+/**
+ * Every vertex of the hull found without the filter must survive it, and
+ * the hull found with the filter must be right.  Only solid inputs are
+ * used, since planar ones go to PlanarHullSolver, which doesn't filter,
+ * along with points on a sphere, nearly all of which are vertices.
+ *
+ * \param log Where to report
+ */
+void HullTests::testFilter(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+	boost::mt19937 engine(HullSolver::DEFAULT_SEED);
+	boost::variate_generator<boost::mt19937 &, boost::normal_distribution<> > normal(engine,
+		boost::normal_distribution<>());
+
+	inputs.resize(inputs.size() + 1);
+	inputs.back().name = "sphere";
+	inputs.back().dimension = 3;
+
+	for (int i = 0; i < 5000; i++) {
+		double x = normal();
+		double y = normal();
+		double z = normal();
+		double r = sqrt(x * x + y * y + z * z);
+		inputs.back().points.add(x / r, y / r, z / r);
+	}
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		if (inputs[i].dimension != 3) {
+			continue;
+		}
+
+		ConvexHullSolver unfiltered(inputs[i].points);
+		unfiltered.iterateToCompletion();
+		HullFaceList faces = unfiltered.getHull();
+
+		for (int d = 0; d < 3; d++) {
+			for (int t = 0; t < 2; t++) {
+				InteriorPointFilter filter(FILTER_DIRECTIONS[d], THREAD_COUNTS[t]);
+				HullPointIndexList survivors = filter.apply(inputs[i].points);
+				bool kept = true;
+				char algorithm[64];
+
+				std::sort(survivors.begin(), survivors.end());
+
+				for (size_t f = 0; kept && f < faces.size(); f++) {
+					for (int k = 0; k < 3; k++) {
+						kept = kept && std::binary_search(survivors.begin(), survivors.end(), faces[f].getPoint(k));
+					}
+				}
+
+				sprintf(algorithm, "filter, %u directions", FILTER_DIRECTIONS[d]);
+				log.report(kept, getTestName(inputs[i], algorithm, THREAD_COUNTS[t]), "a vertex of the hull was culled");
+
+				ConvexHullSolver filtered(inputs[i].points, HullFaceScheduler::FURTHEST_FIRST, FILTER_DIRECTIONS[d],
+					THREAD_COUNTS[t]);
+				string problem;
+
+				filtered.iterateToCompletion();
+				sprintf(algorithm, "incremental, filtered in %u directions", FILTER_DIRECTIONS[d]);
+				log.report(checkHull(filtered, filtered.getPoints(), inputs[i], problem),
+					getTestName(inputs[i], algorithm, THREAD_COUNTS[t]), problem);
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+/**
+ * \file FloatTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of FloatConvexHullSolver
+ */
+
+#include "HullTests.h"
+#include "ConvexHullSolver.h"
+
+/**
+ * Each input is rounded to float and solved in float, and the hull is
+ * checked against the rounded points widened back to double, which are
+ * exactly the points the solver saw.  Planar inputs are left out, since
+ * HullSolver::create() sends them to PlanarHullSolver in double.
+ *
+ * \param log Where to report
+ */
+void HullTests::testFloat(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		if (inputs[i].dimension == 2) {
+			continue;
+		}
+
+		FloatHullPointBuffer floatPoints;
+		TestInput rounded;
+
+		rounded.name = inputs[i].name;
+		rounded.dimension = inputs[i].dimension;
+
+		for (size_t j = 0; j < inputs[i].points.size(); j++) {
+			HullPointIndex p = (HullPointIndex) j;
+			floatPoints.add((float) inputs[i].points.getX(p), (float) inputs[i].points.getY(p),
+				(float) inputs[i].points.getZ(p));
+			rounded.points.add(floatPoints.getX(p), floatPoints.getY(p), floatPoints.getZ(p));
+		}
+
+		for (int t = 0; t < 2; t++) {
+			for (int randomized = 0; randomized < 2; randomized++) {
+				FloatConvexHullSolver solver(floatPoints, HullFaceScheduler::FURTHEST_FIRST, 0, THREAD_COUNTS[t]);
+				string problem;
+
+				if (randomized) {
+					solver.setRandomOrder();
+				}
+
+				solver.iterateToCompletion();
+				log.report(checkHull(solver, rounded.points, rounded, problem),
+					getTestName(rounded, randomized ? "randomized, float" : "incremental, float", THREAD_COUNTS[t]),
+					problem);
+			}
+		}
+	}
+}
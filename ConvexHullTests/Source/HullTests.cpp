@@ -0,0 +1,297 @@
+/**
+ * \file HullTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines what the tests share
+ */
+
+#include "HullTests.h"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <utility>
+
+const unsigned int HullTests::THREAD_COUNTS[2] = { 1, 4 };
+
+/**
+ * \param passed Whether or not the test passed
+ * \param name What was tested
+ * \param problem What went wrong, if the test failed
+ */
+void TestLog::report(bool passed, const string &name, const string &problem) {
+	printf("%s\t%s%s%s\n", passed ? "ok" : "FAILED", name.c_str(), passed ? "" : ": ", passed ? "" : problem.c_str());
+	fflush(stdout);
+	this->numTests++;
+	this->numFailed += passed ? 0 : 1;
+}
+
+/**
+ * \param x Receives the x-coordinates of the points read
+ * \param y Receives the y-coordinates of the points read
+ * \param z Receives the z-coordinates of the points read
+ * \param maxPoints The most points to read
+ * \return The number of points read
+ */
+size_t BufferPointSource::read(double *x, double *y, double *z, size_t maxPoints) {
+	size_t count = std::min(maxPoints, this->points.size() - this->next);
+
+	for (size_t i = 0; i < count; i++) {
+		HullPointIndex p = (HullPointIndex) (this->next + i);
+		x[i] = this->points.getX(p);
+		y[i] = this->points.getY(p);
+		z[i] = this->points.getZ(p);
+	}
+
+	this->next += count;
+	return count;
+}
+
+/**
+ * The inputs are a cube, with its corners and the midpoints of four of its
+ * edges, so that its faces are coplanar and some of its edges hold three
+ * points; a disk, whose hull is a polygon; points on a line; a few points
+ * each repeated many times; and one point repeated.  The coordinates are
+ * whole numbers where the points need to be exactly coplanar or collinear.
+ *
+ * \return The inputs
+ */
+vector<TestInput> HullTests::makeInputs() {
+	boost::mt19937 engine(HullSolver::DEFAULT_SEED);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_real<> > uniform(engine, boost::uniform_real<>(-1, 1));
+	boost::variate_generator<boost::mt19937 &, boost::uniform_int<> > whole(engine, boost::uniform_int<>(-1000, 1000));
+	vector<TestInput> inputs(5);
+
+	inputs[0].name = "cube";
+	inputs[0].dimension = 3;
+
+	for (int i = 0; i < 20000; i++) {
+		inputs[0].points.add(uniform(), uniform(), uniform());
+	}
+
+	for (int i = 0; i < 8; i++) {
+		inputs[0].points.add((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1);
+		inputs[0].points.add(0, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1);
+	}
+
+	inputs[1].name = "disk";
+	inputs[1].dimension = 2;
+
+	while (inputs[1].points.size() < 2000) {
+		double x = uniform();
+		double y = uniform();
+
+		if (x * x + y * y <= 1) {
+			inputs[1].points.add(x, y, 0);
+		}
+	}
+
+	inputs[2].name = "collinear";
+	inputs[2].dimension = 1;
+
+	for (int i = 0; i < 1000; i++) {
+		int t = whole();
+		inputs[2].points.add(t, 2 * t, -3 * t);
+	}
+
+	inputs[3].name = "duplicates";
+	inputs[3].dimension = 3;
+
+	for (int i = 0; i < 50; i++) {
+		inputs[3].points.add(uniform(), uniform(), uniform());
+	}
+
+	for (int k = 0; k < 100; k++) {
+		for (HullPointIndex i = 0; i < 50; i++) {
+			inputs[3].points.add(inputs[3].points.getX(i), inputs[3].points.getY(i), inputs[3].points.getZ(i));
+		}
+	}
+
+	inputs[4].name = "coincident";
+	inputs[4].dimension = 0;
+
+	for (int i = 0; i < 1000; i++) {
+		inputs[4].points.add(0.25, -0.5, 0.75);
+	}
+
+	return inputs;
+}
+
+/**
+ * A planar hull must also have every point inside or on its polygon.
+ *
+ * \param solver The solver, which has finished
+ * \param hullPoints The points that the hull's faces refer to
+ * \param input The points that were solved
+ * \param problem Receives what is wrong with the hull, if anything is
+ * \return Whether or not the hull is right
+ */
+bool HullTests::checkHull(const HullSolver &solver, const HullPointBuffer &hullPoints, const TestInput &input,
+	string &problem) {
+
+	HullFaceList faces = solver.getHull();
+
+	if (!checkFaces(faces, solver.getDimension(), hullPoints, input, problem)) {
+		return false;
+	}
+
+	if (input.dimension != 2) {
+		return true;
+	}
+
+	HullPointIndexList polygon = solver.getPolygon();
+	HullPointBuffer points = hullPoints;
+	size_t base = points.size();
+	const HullFace &f = faces[0];
+	double u[3] = { points.getX(f.getP1()) - points.getX(f.getP0()), points.getY(f.getP1()) - points.getY(f.getP0()),
+		points.getZ(f.getP1()) - points.getZ(f.getP0()) };
+	double v[3] = { points.getX(f.getP2()) - points.getX(f.getP0()), points.getY(f.getP2()) - points.getY(f.getP0()),
+		points.getZ(f.getP2()) - points.getZ(f.getP0()) };
+	double normal[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+	int dropAxis = 0;
+	int side = 0;
+
+	points.append(input.points);
+
+	if (polygon.size() < 3) {
+		problem = "the polygon has too few vertices";
+		return false;
+	}
+
+	// The polygon is checked in the coordinate plane it is least
+	// foreshortened in, which a vertical polygon needs.
+	for (int j = 1; j < 3; j++) {
+		dropAxis = (fabs(normal[j]) > fabs(normal[dropAxis])) ? j : dropAxis;
+	}
+
+	// The polygon winds about the plane's normal, which may point either
+	// way, so every point must be on the same side of every edge, whichever
+	// side that is.
+	for (size_t i = 0; i < polygon.size(); i++) {
+		HullPointIndex p0 = polygon[i];
+		HullPointIndex p1 = polygon[(i + 1) % polygon.size()];
+
+		for (size_t q = 0; q < input.points.size(); q++) {
+			int o = HullPredicates::orientation2d(points, p0, p1, (HullPointIndex) (base + q), dropAxis);
+
+			if (o != 0 && side != 0 && o != side) {
+				problem = "a point is outside the polygon";
+				return false;
+			}
+
+			side = (o != 0) ? o : side;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * A solid hull must be closed, with every edge in one face each way, and
+ * have every point behind or on each of its faces.  A planar hull must be a
+ * closed, two-sided fan with every point in its plane.  Anything less has
+ * no faces.
+ *
+ * \param faces The hull's faces
+ * \param dimension The number of dimensions the solver found the points to span
+ * \param hullPoints The points that the faces refer to
+ * \param input The points that were solved
+ * \param problem Receives what is wrong with the faces, if anything is
+ * \return Whether or not the faces are right
+ */
+bool HullTests::checkFaces(const HullFaceList &faces, unsigned int dimension, const HullPointBuffer &hullPoints,
+	const TestInput &input, string &problem) {
+
+	HullPointBuffer points = hullPoints;
+	size_t base = points.size();
+	std::map<std::pair<HullPointIndex, HullPointIndex>, int> edges;
+
+	points.append(input.points);
+
+	if (dimension != input.dimension) {
+		problem = "the hull has the wrong dimension";
+		return false;
+	}
+
+	if (input.dimension < 2 && !faces.empty()) {
+		problem = "the hull has faces";
+		return false;
+	}
+
+	if (input.dimension < 2) {
+		return true;
+	}
+
+	if (faces.size() < 2) {
+		problem = "the hull has too few faces";
+		return false;
+	}
+
+	for (size_t i = 0; i < faces.size(); i++) {
+		const HullFace &f = faces[i];
+
+		if (HullPredicates::collinear(points, f.getP0(), f.getP1(), f.getP2())) {
+			problem = "a face is degenerate";
+			return false;
+		}
+
+		for (int k = 0; k < 3; k++) {
+			edges[std::make_pair(f.getPoint(k), f.getPoint((k + 1) % 3))]++;
+		}
+
+		for (size_t q = 0; q < input.points.size(); q++) {
+			int o = HullPredicates::orientation(points, f.getP0(), f.getP1(), f.getP2(), (HullPointIndex) (base + q));
+
+			if ((input.dimension == 3) ? (o > 0) : (o != 0)) {
+				problem = "a point is outside the hull";
+				return false;
+			}
+		}
+	}
+
+	for (std::map<std::pair<HullPointIndex, HullPointIndex>, int>::const_iterator i = edges.begin();
+		i != edges.end(); i++) {
+
+		std::map<std::pair<HullPointIndex, HullPointIndex>, int>::const_iterator reverse
+			= edges.find(std::make_pair(i->first.second, i->first.first));
+
+		if (i->second != 1 || reverse == edges.end() || reverse->second != 1) {
+			problem = "the hull isn't closed";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * \param input The input
+ * \param algorithm The name of the algorithm
+ * \param numThreads The number of threads
+ * \return The name, as "input, algorithm, n threads"
+ */
+string HullTests::getTestName(const TestInput &input, const char *algorithm, unsigned int numThreads) {
+	char name[256];
+	sprintf(name, "%s, %s, %u thread%s", input.name.c_str(), algorithm, numThreads, (numThreads == 1) ? "" : "s");
+	return name;
+}
+
+/**
+ * \param path The file
+ * \param contents The bytes to write, which are written as they are
+ * \return Whether or not the whole file was written
+ */
+bool HullTests::writeFile(const char *path, const string &contents) {
+	FILE *file = fopen(path, "wb");
+
+	if (file == NULL) {
+		return false;
+	}
+
+	bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	return (fclose(file) == 0) && written;
+}
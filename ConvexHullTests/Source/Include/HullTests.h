@@ -0,0 +1,156 @@
+/**
+ * \file HullTests.h
+ * \author Douglas W. Paul
+ *
+ * Declares the HullTests class, and what the tests share
+ */
+
+#pragma once
+
+#include "HullPointBuffer.h"
+#include "HullPointSource.h"
+#include "HullSolver.h"
+#include <string>
+#include <vector>
+
+using namespace peek;
+
+/** A set of points, and the dimension their hull should have */
+struct TestInput {
+	/** What the points are */
+	string name;
+
+	/** The points */
+	HullPointBuffer points;
+
+	/** The number of dimensions the points span */
+	unsigned int dimension;
+};
+
+/** Counts the tests run and failed, and reports each on standard output */
+class TestLog {
+public:
+
+	/** Constructor */
+	TestLog() : numTests(0), numFailed(0) {}
+
+	/** Reports the result of a test */
+	void report(bool passed, const string &name, const string &problem);
+
+	/** Gets the number of tests run */
+	inline int getNumTests() const { return this->numTests; }
+
+	/** Gets the number of tests that failed */
+	inline int getNumFailed() const { return this->numFailed; }
+
+private:
+
+	/** The number of tests run */
+	int numTests;
+
+	/** The number of tests that failed */
+	int numFailed;
+};
+
+/** Reads points out of a buffer, so that the streaming solver can be tested on them */
+class BufferPointSource : public HullPointSource {
+public:
+
+	/** Constructor */
+	BufferPointSource(const HullPointBuffer &points) : points(points), next(0) {}
+
+	/** Reads up to the given number of points, following on from the last read */
+	virtual size_t read(double *x, double *y, double *z, size_t maxPoints);
+
+private:
+
+	/** The points */
+	const HullPointBuffer &points;
+
+	/** The next point to read */
+	size_t next;
+};
+
+/**
+ * Container class for the tests, which are static methods that each report
+ * to a TestLog, and for what they share
+ *
+ * Hulls are checked by brute force against every point, with the exact
+ * predicates, rather than against known answers, so that any correct hull
+ * passes whatever its triangulation of coplanar faces.
+ */
+class HullTests {
+public:
+
+	/** The numbers of threads that the solvers are tested with */
+	static const unsigned int THREAD_COUNTS[2];
+
+	/** Makes the point sets that the solvers are tested on */
+	static vector<TestInput> makeInputs();
+
+	/** Checks a finished solver's hull against the points it was given */
+	static bool checkHull(const HullSolver &solver, const HullPointBuffer &hullPoints, const TestInput &input,
+		string &problem);
+
+	/** Checks the faces of a hull, found by any means, against the points that were solved */
+	static bool checkFaces(const HullFaceList &faces, unsigned int dimension, const HullPointBuffer &hullPoints,
+		const TestInput &input, string &problem);
+
+	/** Names a test of a solver on an input with a number of threads */
+	static string getTestName(const TestInput &input, const char *algorithm, unsigned int numThreads);
+
+	/** Writes a file of the given bytes, replacing any that was there */
+	static bool writeFile(const char *path, const string &contents);
+
+	/** Tests HullBatchSolver on ranges of every kind, in double and float */
+	static void testBatch(TestLog &log);
+
+	/** Tests PointClassifier with every supported instruction set against scalar code */
+	static void testClassifier(TestLog &log);
+
+	/** Tests the incremental solver on every input */
+	static void testIncremental(TestLog &log);
+
+	/** Tests the divide-and-conquer solver on every input */
+	static void testDivideAndConquer(TestLog &log);
+
+	/** Tests the output-sensitive solver on every input */
+	static void testChan(TestLog &log);
+
+	/** Tests the randomized incremental solver on every input */
+	static void testRandomized(TestLog &log);
+
+	/** Tests PlanarHullSolver on planar inputs, including tilted and upright ones */
+	static void testPlanar(TestLog &log);
+
+	/** Tests FloatConvexHullSolver on every solid or lesser input */
+	static void testFloat(TestLog &log);
+
+	/** Tests inserting points into a finished hull */
+	static void testInsert(TestLog &log);
+
+	/** Tests removing points from a finished hull */
+	static void testRemove(TestLog &log);
+
+	/** Tests MappedPointFile on raw and PLY files, and that it refuses malformed ones */
+	static void testMappedFile(TestLog &log);
+
+	/** Tests TextPointFile on each text format, with each number of threads, and on malformed files */
+	static void testText(TestLog &log);
+
+	/** Tests that HullExporter gathers a hull's vertices faithfully, and writes files that read back */
+	static void testExporter(TestLog &log);
+
+	/** Tests that InteriorPointFilter never culls a vertex of the hull */
+	static void testFilter(TestLog &log);
+
+	/** Tests that a HullPointBuffer referring to a caller's points can be grown */
+	static void testPointBuffer(TestLog &log);
+
+	/** Tests every solver on points read through a view of interleaved records */
+	static void testStrided(TestLog &log);
+
+	/** Tests StreamingHullSolver on every input, a small chunk at a time */
+	static void testStreaming(TestLog &log);
+
+};
@@ -0,0 +1,71 @@
+/**
+ * \file PointBufferTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of HullPointBuffer
+ */
+
+#include "HullTests.h"
+
+namespace {
+
+	/**
+	 * Checks that a buffer holds the given interleaved points, followed by
+	 * the point (-1, -2, -3) repeated
+	 *
+	 * \param buffer The buffer
+	 * \param records The points, four doubles apart
+	 * \param numRecords The number of points in records
+	 * \param size The number of points the buffer should hold
+	 * \return Whether or not the buffer holds them
+	 */
+	bool holds(const HullPointBuffer &buffer, const double *records, size_t numRecords, size_t size) {
+		if (buffer.size() != size) {
+			return false;
+		}
+
+		for (size_t i = 0; i < size; i++) {
+			HullPointIndex p = (HullPointIndex) i;
+			bool old = (i < numRecords);
+
+			if (buffer.getX(p) != (old ? records[4 * i] : -1) || buffer.getY(p) != (old ? records[4 * i + 1] : -2)
+				|| buffer.getZ(p) != (old ? records[4 * i + 2] : -3)) {
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+}
+
+/**
+ * A buffer that refers to interleaved points must keep them when it is
+ * grown by reserve(), add() or append().
+ *
+ * \param log Where to report
+ */
+void HullTests::testPointBuffer(TestLog &log) {
+	double records[4 * 100];
+	HullPointBuffer more;
+
+	for (int i = 0; i < 4 * 100; i++) {
+		records[i] = i;
+	}
+
+	more.add(-1, -2, -3);
+
+	HullPointBuffer reserved(records, records + 1, records + 2, 100, 4);
+	reserved.reserve(1000);
+	log.report(holds(reserved, records, 100, 100), "point buffer, reserve on a view", "the points were lost");
+
+	HullPointBuffer added(records, records + 1, records + 2, 100, 4);
+	log.report(added.add(-1, -2, -3) == 100 && holds(added, records, 100, 101), "point buffer, add to a view",
+		"the points were lost");
+
+	HullPointBuffer appended(records, records + 1, records + 2, 100, 4);
+	appended.append(more);
+	appended.append(more);
+	log.report(holds(appended, records, 100, 102), "point buffer, append to a view", "the points were lost");
+}
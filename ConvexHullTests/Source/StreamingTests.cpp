@@ -0,0 +1,39 @@
+/**
+ * \file StreamingTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of StreamingHullSolver
+ */
+
+#include "HullTests.h"
+#include "StreamingHullSolver.h"
+
+namespace {
+
+	/** The memory budget the streaming solver is tested with, which gives it the smallest chunks */
+	const size_t STREAMING_MEMORY_BUDGET = 1 << 16;
+
+}
+
+/**
+ * The hulls are checked against every point read, and planar input must
+ * come out as the same two-sided polygon as it would from the other
+ * solvers.
+ *
+ * \param log Where to report
+ */
+void HullTests::testStreaming(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		for (int t = 0; t < 2; t++) {
+			BufferPointSource source(inputs[i].points);
+			StreamingHullSolver solver(source, STREAMING_MEMORY_BUDGET, THREAD_COUNTS[t]);
+			string problem;
+
+			solver.iterateToCompletion();
+			log.report(checkHull(solver, solver.getPoints(), inputs[i], problem),
+				getTestName(inputs[i], "streaming", THREAD_COUNTS[t]), problem);
+		}
+	}
+}
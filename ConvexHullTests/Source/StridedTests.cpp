@@ -0,0 +1,90 @@
+/**
+ * \file StridedTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of solving points in the caller's own interleaved layout
+ */
+
+#include "HullTests.h"
+#include "ConvexHullSolver.h"
+#include "PlanarHullSolver.h"
+#include <cstddef>
+#include <memory>
+
+namespace {
+
+	/** A point as a caller might store it, with something else after its coordinates */
+	struct Record {
+		/** The coordinates */
+		double x, y, z;
+
+		/** What else the caller keeps with the point */
+		double weight;
+	};
+
+	/** The algorithms that HullSolver::create() is tested with */
+	const HullSolver::Algorithm ALGORITHMS[4] = {
+		HullSolver::INCREMENTAL, HullSolver::RANDOMIZED_INCREMENTAL, HullSolver::DIVIDE_AND_CONQUER,
+		HullSolver::OUTPUT_SENSITIVE
+	};
+
+	/** The names of the algorithms */
+	const char *ALGORITHM_NAMES[4] = { "incremental", "randomized", "divide", "chan" };
+
+}
+
+/**
+ * Each input is copied into records of four doubles, and solved through a
+ * view of them with every algorithm, and with the filter, which classifies
+ * strided points by index.  Planar inputs must still be found to be planar
+ * through the view.
+ *
+ * \param log Where to report
+ */
+void HullTests::testStrided(TestLog &log) {
+	vector<TestInput> inputs = makeInputs();
+
+	for (size_t i = 0; i < inputs.size(); i++) {
+		vector<Record> records(inputs[i].points.size());
+
+		for (size_t j = 0; j < records.size(); j++) {
+			HullPointIndex p = (HullPointIndex) j;
+			records[j].x = inputs[i].points.getX(p);
+			records[j].y = inputs[i].points.getY(p);
+			records[j].z = inputs[i].points.getZ(p);
+			records[j].weight = -1e6;
+		}
+
+		TestInput view;
+		view.name = inputs[i].name + " in records";
+		view.dimension = inputs[i].dimension;
+		view.points = HullPointBuffer(&records[0], records.size(), sizeof(Record), offsetof(Record, x),
+			offsetof(Record, y), offsetof(Record, z));
+
+		double packedNormal[3], viewNormal[3];
+		double packedThickness = PlanarHullSolver::fitPlane(inputs[i].points, packedNormal);
+		double viewThickness = PlanarHullSolver::fitPlane(view.points, viewNormal);
+
+		log.report(viewThickness == packedThickness, view.name + ", plane fit", "the view was fit differently");
+
+		for (int a = 0; a < 4; a++) {
+			for (int t = 0; t < 2; t++) {
+				auto_ptr<HullSolver> solver(HullSolver::create(ALGORITHMS[a], view.points, THREAD_COUNTS[t]));
+				string problem;
+
+				solver->iterateToCompletion();
+				log.report(checkHull(*solver, view.points, view, problem),
+					getTestName(view, ALGORITHM_NAMES[a], THREAD_COUNTS[t]), problem);
+			}
+		}
+
+		if (view.dimension == 3) {
+			ConvexHullSolver solver(view.points, HullFaceScheduler::FURTHEST_FIRST, 14, 1);
+			string problem;
+
+			solver.iterateToCompletion();
+			log.report(checkHull(solver, view.points, view, problem), getTestName(view, "incremental, filtered", 1),
+				problem);
+		}
+	}
+}
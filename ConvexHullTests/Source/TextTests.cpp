@@ -0,0 +1,203 @@
+/**
+ * \file TextTests.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the tests of parsing text point files
+ */
+
+#include "HullTests.h"
+#include "TextPointFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+	/** The number of points in each file, enough for the lines to be split into several chunks */
+	const int NUM_POINTS = 20000;
+
+	/** The files that the tests write, parse and then delete, with the names their formats are found by */
+	const char *TEST_PATHS[3] = { "hulltests-text.xyz", "hulltests-text.obj", "hulltests-text.ply" };
+
+	/** Gets the coordinates of a point in the files, which are all exact in decimal and binary */
+	void getPoint(int i, double &x, double &y, double &z) {
+		x = i * 0.25;
+		y = -i;
+		z = (i % 7) * 0.5;
+	}
+
+	/** Makes an XYZ file with comments, blank lines, commas, semicolons and CRLF line breaks among its points */
+	string makeXyz() {
+		std::ostringstream file;
+		file << "# x y z\r\n\r\n";
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			double x, y, z;
+			getPoint(i, x, y, z);
+
+			if (i % 100 == 0) {
+				file << "  " << x << ", " << y << "; " << z << " 255 255 255\r\n// a comment\r\n";
+			} else {
+				file << x << ' ' << y << '\t' << z << "\r\n";
+			}
+		}
+
+		return file.str();
+	}
+
+	/** Makes an OBJ file with normals, texture coordinates and faces among its vertices */
+	string makeObj() {
+		std::ostringstream file;
+		file << "# made by the tests\no hull\n";
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			double x, y, z;
+			getPoint(i, x, y, z);
+			file << "v " << x << ' ' << y << ' ' << z << "\nvn 0 0 1\nvt 0.5 0.5\n";
+		}
+
+		file << "f 1 2 3\n";
+		return file.str();
+	}
+
+	/** Makes an ASCII PLY file whose vertices follow another element, and have their coordinates out of order */
+	string makePly() {
+		std::ostringstream file;
+		file << "ply\nformat ascii 1.0\ncomment made by the tests\nelement camera 2\nproperty float focal\n"
+			<< "element vertex " << NUM_POINTS << "\nproperty uchar red\nproperty float z\nproperty float x\n"
+			<< "property float y\nelement face 1\nproperty list uchar int vertex_indices\nend_header\n35\n50\n";
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			double x, y, z;
+			getPoint(i, x, y, z);
+			file << "255 " << z << ' ' << x << ' ' << y << "\n";
+		}
+
+		file << "3 0 1 2\n";
+		return file.str();
+	}
+
+	/** Gets whether a file's points, loaded and read a block at a time, are exactly those of the files */
+	bool matches(TextPointFile &file, string &problem) {
+		HullPointBuffer points;
+		double x[1000], y[1000], z[1000];
+		size_t numRead = 0;
+		size_t count;
+
+		file.getPoints(points);
+
+		if (points.size() != (size_t) NUM_POINTS) {
+			problem = "the wrong number of points were loaded";
+			return false;
+		}
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			HullPointIndex p = (HullPointIndex) i;
+			double px, py, pz;
+			getPoint(i, px, py, pz);
+
+			if (points.getX(p) != px || points.getY(p) != py || points.getZ(p) != pz) {
+				problem = "a point loaded differs from the one written";
+				return false;
+			}
+		}
+
+		file.rewind();
+
+		do {
+			count = file.read(x, y, z, 1000);
+
+			for (size_t i = 0; i < count; i++) {
+				double px, py, pz;
+				getPoint((int) (numRead + i), px, py, pz);
+
+				if (x[i] != px || y[i] != py || z[i] != pz) {
+					problem = "a point read differs from the one written";
+					return false;
+				}
+			}
+
+			numRead += count;
+		} while (count == 1000);
+
+		if (numRead != (size_t) NUM_POINTS) {
+			problem = "the wrong number of points were read";
+			return false;
+		}
+
+		return true;
+	}
+
+}
+
+/**
+ * An XYZ file, an OBJ file and an ASCII PLY file, each with the lines
+ * that don't hold points mixed in that such files have, must parse to
+ * exactly the points written, with one thread and with the lines split
+ * into chunks for several, and read the same a block at a time.  A line
+ * that doesn't hold a point must fail the load at that line however the
+ * lines were split, and truncated and binary PLY files must be refused.
+ *
+ * \param log Where to report
+ */
+void HullTests::testText(TestLog &log) {
+	const char *formatNames[3] = { "XYZ file", "OBJ file", "ASCII PLY file" };
+	const TextPointFile::Format formats[3] = { TextPointFile::XYZ, TextPointFile::OBJ, TextPointFile::PLY };
+	string contents[3] = { makeXyz(), makeObj(), makePly() };
+
+	for (int f = 0; f < 3; f++) {
+		bool written = writeFile(TEST_PATHS[f], contents[f]);
+		TestInput input;
+		input.name = formatNames[f];
+
+		for (int t = 0; t < 2; t++) {
+			TextPointFile file(TEST_PATHS[f], TextPointFile::AUTO, THREAD_COUNTS[t]);
+			bool succeeded = written && file.load();
+			string problem = !written ? "the file couldn't be written" : file.getError();
+
+			if (succeeded && file.getFormat() != formats[f]) {
+				problem = "the format was found wrongly";
+				succeeded = false;
+			}
+
+			succeeded = succeeded && matches(file, problem);
+
+			log.report(succeeded, getTestName(input, "TextPointFile", THREAD_COUNTS[t]), problem);
+		}
+
+		remove(TEST_PATHS[f]);
+	}
+
+	// The bad line is far enough in to be in a later chunk than the first.
+	string malformed = contents[0];
+	size_t badLine = malformed.find("\r\n3750.25 ") + 2;
+	std::ostringstream lineError;
+	malformed.insert(badLine, "1 2 three\r\n");
+	lineError << "line " << (std::count(malformed.begin(), malformed.begin() + badLine, '\n') + 1)
+		<< " doesn't hold a point";
+
+	string badFiles[3] = { malformed, contents[2].substr(0, contents[2].size() / 2), "" };
+	const char *badNames[3] = { "XYZ file with a malformed line", "truncated ASCII PLY file", "binary PLY file" };
+	string badErrors[3] = { lineError.str(), "the PLY file is shorter than its header says",
+		"only ASCII PLY files can be parsed as text" };
+
+	badFiles[2] = "ply\nformat binary_little_endian 1.0\nelement vertex 0\nproperty float x\nproperty float y\n"
+		"property float z\nend_header\n";
+
+	for (int f = 0; f < 3; f++) {
+		const char *path = TEST_PATHS[(f == 0) ? 0 : 2];
+		bool written = writeFile(path, badFiles[f]);
+		TestInput input;
+		input.name = badNames[f];
+
+		for (int t = 0; t < 2; t++) {
+			TextPointFile file(path, TextPointFile::AUTO, THREAD_COUNTS[t]);
+			bool succeeded = written && !file.load() && file.getError() == badErrors[f];
+
+			log.report(succeeded, getTestName(input, "TextPointFile", THREAD_COUNTS[t]),
+				file.getError().empty() ? string("the file was loaded") : file.getError());
+		}
+
+		remove(path);
+	}
+}
@@ -0,0 +1,42 @@
+/**
+ * \file main.cpp
+ * \author Douglas W. Paul
+ *
+ * Defines the entry point for the tests
+ */
+
+#include "HullTests.h"
+#include <cstdio>
+
+/**
+ * Entry point for the tests
+ *
+ * Each test is reported on its own line, followed by a count of those that
+ * failed.
+ *
+ * \return 0 if every test passed, and 1 if any failed
+ */
+int main() {
+	TestLog log;
+
+	HullTests::testPointBuffer(log);
+	HullTests::testMappedFile(log);
+	HullTests::testText(log);
+	HullTests::testClassifier(log);
+	HullTests::testFilter(log);
+	HullTests::testIncremental(log);
+	HullTests::testDivideAndConquer(log);
+	HullTests::testChan(log);
+	HullTests::testRandomized(log);
+	HullTests::testPlanar(log);
+	HullTests::testFloat(log);
+	HullTests::testStrided(log);
+	HullTests::testBatch(log);
+	HullTests::testInsert(log);
+	HullTests::testRemove(log);
+	HullTests::testStreaming(log);
+	HullTests::testExporter(log);
+
+	printf("%d of %d tests failed\n", log.getNumFailed(), log.getNumTests());
+	return (log.getNumFailed() == 0) ? 0 : 1;
+}